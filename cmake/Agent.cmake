@@ -101,6 +101,7 @@ add_library(core
   fboss/agent/DHCPv4Handler.cpp
   fboss/agent/DHCPv6Handler.cpp
   fboss/agent/FibHelpers.cpp
+  fboss/agent/FibUpdatePipeline.cpp
   fboss/agent/HwSwitch.cpp
   fboss/agent/IPHeaderV4.cpp
   fboss/agent/IPv4Handler.cpp
@@ -108,6 +109,7 @@ add_library(core
   fboss/agent/L2Entry.cpp
   fboss/agent/LacpController.cpp
   fboss/agent/LacpMachines.cpp
+  fboss/agent/L2LearningEventStream.cpp
   fboss/agent/LacpTypes.cpp
   fboss/agent/LinkAggregationManager.cpp
   fboss/agent/LldpManager.cpp
@@ -42,6 +42,7 @@ set(SAI_API_SRC
   fboss/agent/hw/sai/api/NextHopGroupApi.cpp
   fboss/agent/hw/sai/api/QosMapApi.cpp
   fboss/agent/hw/sai/api/RouteApi.cpp
+  fboss/agent/hw/sai/api/SaiApiCallStats.cpp
   fboss/agent/hw/sai/api/SaiApiLock.cpp
   fboss/agent/hw/sai/api/SaiApiTable.cpp
   fboss/agent/hw/sai/api/SwitchApi.cpp
@@ -60,6 +61,7 @@ set(SAI_API_SRC
   fboss/agent/hw/sai/api/RouteApi.h
   fboss/agent/hw/sai/api/RouterInterfaceApi.h
   fboss/agent/hw/sai/api/SaiApi.h
+  fboss/agent/hw/sai/api/SaiApiCallStats.h
   fboss/agent/hw/sai/api/SaiApiError.h
   fboss/agent/hw/sai/api/SaiAttribute.h
   fboss/agent/hw/sai/api/SaiAttributeDataTypes.h
@@ -31,6 +31,7 @@ add_library(state
   fboss/agent/state/NdpResponseTable.cpp
   fboss/agent/state/NdpTable.cpp
   fboss/agent/state/NeighborResponseTable.cpp
+  fboss/agent/state/NodeArena.cpp
   fboss/agent/state/NodeBase.cpp
   fboss/agent/state/Port.cpp
   fboss/agent/state/PortMap.cpp
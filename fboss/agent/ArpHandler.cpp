@@ -88,7 +88,8 @@ void ArpHandler::handlePacket(
   }
 
   // Look up the Vlan state.
-  auto state = sw_->getState();
+  auto stateGuard = sw_->getStateReadGuard();
+  const auto& state = stateGuard.get();
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
   if (!vlan) {
     // Hmm, we don't actually have this VLAN configured.
@@ -166,15 +167,14 @@ void ArpHandler::handlePacket(
   (void)targetMac; // unused
 }
 
-static void sendArp(
+static std::unique_ptr<TxPacket> makeArpPkt(
     SwSwitch* sw,
     VlanID vlan,
     ArpOpCode op,
     MacAddress senderMac,
     IPAddressV4 senderIP,
     MacAddress targetMac,
-    IPAddressV4 targetIP,
-    const std::optional<PortDescriptor>& portDesc = std::nullopt) {
+    IPAddressV4 targetIP) {
   XLOG(DBG4) << "sending ARP " << ((op == ARP_OP_REQUEST) ? "request" : "reply")
              << " on vlan " << vlan << " to " << targetIP.str() << " ("
              << targetMac << "): " << senderIP.str() << " is " << senderMac;
@@ -205,11 +205,26 @@ static void sendArp(
   cursor.write<uint32_t>(targetIP.toLong());
   // Fill the padding with 0s
   memset(cursor.writableData(), 0, cursor.length());
+  return pkt;
+}
 
+static void sendArp(
+    SwSwitch* sw,
+    VlanID vlan,
+    ArpOpCode op,
+    MacAddress senderMac,
+    IPAddressV4 senderIP,
+    MacAddress targetMac,
+    IPAddressV4 targetIP,
+    const std::optional<PortDescriptor>& portDesc = std::nullopt) {
+  auto pkt =
+      makeArpPkt(sw, vlan, op, senderMac, senderIP, targetMac, targetIP);
   sw->sendNetworkControlPacketAsync(std::move(pkt), portDesc);
 }
 
 void ArpHandler::floodGratuituousArp() {
+  std::vector<std::pair<std::unique_ptr<TxPacket>, std::optional<PortID>>>
+      pkts;
   for (const auto& intf : *sw_->getState()->getInterfaces()) {
     for (const auto& addrEntry : intf->getAddresses()) {
       if (!addrEntry.first.isV4()) {
@@ -218,16 +233,19 @@ void ArpHandler::floodGratuituousArp() {
       auto v4Addr = addrEntry.first.asV4();
       // Gratuitous arps have both source and destination IPs set to
       // originator's address
-      sendArp(
-          sw_,
-          intf->getVlanID(),
-          ARP_OP_REQUEST,
-          intf->getMac(),
-          v4Addr,
-          MacAddress::BROADCAST,
-          v4Addr);
+      pkts.emplace_back(
+          makeArpPkt(
+              sw_,
+              intf->getVlanID(),
+              ARP_OP_REQUEST,
+              intf->getMac(),
+              v4Addr,
+              MacAddress::BROADCAST,
+              v4Addr),
+          std::nullopt);
     }
   }
+  sw_->sendNetworkControlPacketsAsync(std::move(pkts));
 }
 
 void ArpHandler::sendArpReply(
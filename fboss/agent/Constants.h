@@ -54,5 +54,11 @@ inline constexpr folly::StringPiece kInExp{"in_exp"};
 inline constexpr folly::StringPiece kOutExp{"out_exp"};
 inline constexpr folly::StringPiece kQosPolicyTable{"qosPolicyTable"};
 inline constexpr folly::StringPiece kSwitchId{"switch_id"};
+// fb303 counter prefix for the per object type SaiStore reload time
+inline constexpr folly::StringPiece kSaiStoreReloadUsecsPrefix{
+    "sai_store.reload_usecs."};
+// fb303 counter prefix for the per api, object type and operation SAI call
+// latencies
+inline constexpr folly::StringPiece kSaiApiCallPrefix{"sai_api_call."};
 
 } // namespace facebook::fboss
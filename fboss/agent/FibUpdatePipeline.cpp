@@ -0,0 +1,363 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/FibUpdatePipeline.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/StateUpdate.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Conv.h>
+#include <folly/ExceptionString.h>
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+#include <chrono>
+
+DEFINE_bool(
+    pipelined_fib_programming,
+    false,
+    "Queue standalone RIB FIB updates as chunks programmed concurrently "
+    "with further RIB updates, instead of programming each synchronously");
+DEFINE_int32(
+    fib_pipeline_chunk_size,
+    1000,
+    "Routes per state update when pipelining FIB programming");
+DEFINE_int32(
+    fib_pipeline_max_pending_chunks,
+    16,
+    "Chunks FIB updates may have pending before they wait for hardware "
+    "programming to catch up, when pipelining FIB programming");
+
+namespace facebook::fboss {
+
+namespace {
+
+// How often a FIB update waiting for capacity checks for a pending
+// reconfigure, which it must not hold up
+constexpr auto kReconfigureCheckInterval = std::chrono::milliseconds(10);
+
+template <typename AddrT>
+struct FibChunk {
+  // If set, replaces the whole FIB, otherwise the FIB is patched with delta
+  std::shared_ptr<ForwardingInformationBase<AddrT>> replacement;
+  rib::ForwardingInformationBaseUpdater::FibDelta<AddrT> delta;
+
+  size_t size() const {
+    return delta.addedOrChanged.size() + delta.removed.size();
+  }
+};
+
+/*
+ * Return the FIB with chunk applied, or null if that changes nothing
+ */
+template <typename AddrT>
+std::shared_ptr<ForwardingInformationBase<AddrT>> applyChunk(
+    const std::shared_ptr<ForwardingInformationBase<AddrT>>& fib,
+    const FibChunk<AddrT>& chunk) {
+  if (chunk.replacement) {
+    return chunk.replacement != fib ? chunk.replacement : nullptr;
+  }
+  if (!chunk.size()) {
+    return nullptr;
+  }
+  auto newFib = fib->clone();
+  for (const auto& route : chunk.delta.addedOrChanged) {
+    if (newFib->getNodeIf(route->prefix())) {
+      newFib->updateNode(route);
+    } else {
+      newFib->addNode(route);
+    }
+  }
+  for (const auto& prefix : chunk.delta.removed) {
+    newFib->removeNodeIf(prefix);
+  }
+  return newFib;
+}
+
+} // namespace
+
+class FibUpdatePipeline::ChunkUpdate : public StateUpdate {
+ public:
+  ChunkUpdate(
+      FibUpdatePipeline* pipeline,
+      RouterID vrf,
+      uint64_t reconfigureGeneration,
+      int behaviorFlags)
+      : StateUpdate("pipelined FIB update", behaviorFlags),
+        pipeline_(pipeline),
+        vrf_(vrf),
+        reconfigureGeneration_(reconfigureGeneration) {}
+
+  std::shared_ptr<SwitchState> applyUpdate(
+      const std::shared_ptr<SwitchState>& origState) override {
+    if (pipeline_->sw_->getRib()->getReconfigureGeneration() !=
+        reconfigureGeneration_) {
+      // Config was applied since this chunk was queued, and recomputed the
+      // FIB from a RIB which already had this chunk's routes
+      XLOG(DBG2) << "Dropping FIB chunk for VRF " << vrf_
+                 << " superseded by config";
+      return nullptr;
+    }
+    auto fibContainer = origState->getFibs()->getFibContainerIf(vrf_);
+    CHECK(fibContainer);
+    auto newFibV4 = applyChunk(fibContainer->getFibV4(), v4);
+    auto newFibV6 = applyChunk(fibContainer->getFibV6(), v6);
+    if (!newFibV4 && !newFibV6) {
+      return nullptr;
+    }
+    auto newState = origState;
+    auto newFibContainer = fibContainer->modify(&newState);
+    if (newFibV4) {
+      newFibContainer->writableFields()->fibV4 = std::move(newFibV4);
+    }
+    if (newFibV6) {
+      newFibContainer->writableFields()->fibV6 = std::move(newFibV6);
+    }
+    return newState;
+  }
+
+  void onError(const std::exception& ex) noexcept override {
+    XLOG(ERR) << "Failed to apply FIB chunk for VRF " << vrf_ << ": "
+              << folly::exceptionStr(ex);
+    pipeline_->chunkFailed(vrf_, ex);
+  }
+
+  void onSuccess() override {
+    pipeline_->chunkDone();
+  }
+
+  size_t size() const {
+    return v4.size() + v6.size();
+  }
+
+  FibChunk<folly::IPAddressV4> v4;
+  FibChunk<folly::IPAddressV6> v6;
+
+ private:
+  FibUpdatePipeline* pipeline_;
+  RouterID vrf_;
+  uint64_t reconfigureGeneration_;
+};
+
+FibUpdatePipeline::FibUpdatePipeline(SwSwitch* sw) : sw_(sw) {}
+
+FibUpdatePipeline::~FibUpdatePipeline() {}
+
+void FibUpdatePipeline::fibUpdated(
+    RouterID vrf,
+    const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const rib::IPv6NetworkToRouteMap& v6NetworkToRoute) {
+  bool failed;
+  {
+    std::lock_guard<std::mutex> guard(pendingLock_);
+    failed = failedVrfs_.erase(vrf);
+  }
+  if (failed) {
+    // Hardware is missing a chunk of what we queued, diffing against that
+    // would never program it
+    queuedFibs_.erase(vrf);
+  }
+
+  auto reconfigureGeneration = sw_->getRib()->getReconfigureGeneration();
+  auto queuedFibs = queuedFibs_.find(vrf);
+  if (queuedFibs == queuedFibs_.end() ||
+      queuedFibs->second.reconfigureGeneration != reconfigureGeneration) {
+    // Config may have changed the FIB since our last chunk, so we have
+    // nothing to diff against
+    queueFullFibs(
+        vrf, v4NetworkToRoute, v6NetworkToRoute, reconfigureGeneration);
+    return;
+  }
+
+  rib::ForwardingInformationBaseUpdater::FibDelta<folly::IPAddressV4> v4Delta;
+  rib::ForwardingInformationBaseUpdater::FibDelta<folly::IPAddressV6> v6Delta;
+  auto newFibV4 = rib::ForwardingInformationBaseUpdater::createUpdatedFib(
+      v4NetworkToRoute, queuedFibs->second.v4, &v4Delta);
+  auto newFibV6 = rib::ForwardingInformationBaseUpdater::createUpdatedFib(
+      v6NetworkToRoute, queuedFibs->second.v6, &v6Delta);
+  if (!newFibV4 && !newFibV6) {
+    return;
+  }
+  if (newFibV4) {
+    queuedFibs->second.v4 = std::move(newFibV4);
+  }
+  if (newFibV6) {
+    queuedFibs->second.v6 = std::move(newFibV6);
+  }
+
+  // Chunks are queued as soon as they fill up, so hardware programming
+  // starts while we are still splitting up the rest
+  auto chunkSize =
+      static_cast<size_t>(std::max(1, FLAGS_fib_pipeline_chunk_size));
+  std::unique_ptr<ChunkUpdate> chunk;
+  auto behaviorFlags = StateUpdate::kDefaultBehaviorFlags;
+  bool dropped = false;
+  auto queueChunk = [&]() {
+    if (chunk && !dropped) {
+      dropped = !queue(std::move(chunk));
+    }
+    chunk.reset();
+  };
+  auto nextChunk = [&]() -> ChunkUpdate& {
+    if (chunk && chunk->size() >= chunkSize) {
+      queueChunk();
+    }
+    if (!chunk) {
+      chunk = std::make_unique<ChunkUpdate>(
+          this, vrf, reconfigureGeneration, behaviorFlags);
+    }
+    return *chunk;
+  };
+  for (auto& route : v4Delta.addedOrChanged) {
+    nextChunk().v4.delta.addedOrChanged.push_back(std::move(route));
+  }
+  for (auto& route : v6Delta.addedOrChanged) {
+    nextChunk().v6.delta.addedOrChanged.push_back(std::move(route));
+  }
+  // Within a single state delta HwSwitches remove routes before adding
+  // them, so removals get chunks of their own, which SwSwitch must not
+  // coalesce with the chunks around them.
+  queueChunk();
+  behaviorFlags = static_cast<int>(StateUpdate::BehaviorFlags::NON_COALESCING);
+  for (const auto& prefix : v4Delta.removed) {
+    nextChunk().v4.delta.removed.push_back(prefix);
+  }
+  for (const auto& prefix : v6Delta.removed) {
+    nextChunk().v6.delta.removed.push_back(prefix);
+  }
+  queueChunk();
+  if (dropped) {
+    // What we queued falls short of the FIB we computed
+    queuedFibs_.erase(vrf);
+  }
+}
+
+void FibUpdatePipeline::queueFullFibs(
+    RouterID vrf,
+    const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    uint64_t reconfigureGeneration) {
+  // The FIBs to reuse unchanged routes from, preferably what we last queued
+  // as that is the most recent
+  QueuedFibs baseFibs;
+  auto queuedFibs = queuedFibs_.find(vrf);
+  if (queuedFibs != queuedFibs_.end()) {
+    baseFibs = queuedFibs->second;
+  } else if (
+      auto fibContainer =
+          sw_->getState()->getFibs()->getFibContainerIf(vrf)) {
+    baseFibs.v4 = fibContainer->getFibV4();
+    baseFibs.v6 = fibContainer->getFibV6();
+  } else {
+    baseFibs.v4 = std::make_shared<ForwardingInformationBaseV4>();
+    baseFibs.v6 = std::make_shared<ForwardingInformationBaseV6>();
+  }
+
+  QueuedFibs newFibs;
+  newFibs.v4 = rib::ForwardingInformationBaseUpdater::createUpdatedFib(
+      v4NetworkToRoute, baseFibs.v4);
+  newFibs.v6 = rib::ForwardingInformationBaseUpdater::createUpdatedFib(
+      v6NetworkToRoute, baseFibs.v6);
+  newFibs.v4 = newFibs.v4 ? newFibs.v4 : baseFibs.v4;
+  newFibs.v6 = newFibs.v6 ? newFibs.v6 : baseFibs.v6;
+  newFibs.reconfigureGeneration = reconfigureGeneration;
+
+  auto chunk = std::make_unique<ChunkUpdate>(
+      this, vrf, reconfigureGeneration, StateUpdate::kDefaultBehaviorFlags);
+  chunk->v4.replacement = newFibs.v4;
+  chunk->v6.replacement = newFibs.v6;
+  if (queue(std::move(chunk))) {
+    queuedFibs_[vrf] = std::move(newFibs);
+  } else {
+    queuedFibs_.erase(vrf);
+  }
+}
+
+bool FibUpdatePipeline::queue(std::unique_ptr<ChunkUpdate> chunk) {
+  auto maxPending =
+      static_cast<size_t>(std::max(1, FLAGS_fib_pipeline_max_pending_chunks));
+  {
+    std::unique_lock<std::mutex> guard(pendingLock_);
+    while (!stopped_ && pendingChunks_ >= maxPending) {
+      if (sw_->getRib()->isReconfigurePending()) {
+        XLOG(DBG2) << "Dropping FIB chunk superseded by pending config";
+        return false;
+      }
+      pendingChanged_.wait_for(guard, kReconfigureCheckInterval);
+    }
+    if (stopped_) {
+      return false;
+    }
+    ++pendingChunks_;
+  }
+  if (!sw_->updateState(std::move(chunk))) {
+    // SwSwitch is exiting
+    chunkDone();
+    return false;
+  }
+  return true;
+}
+
+void FibUpdatePipeline::chunkDone() {
+  {
+    std::lock_guard<std::mutex> guard(pendingLock_);
+    CHECK_GT(pendingChunks_, 0);
+    --pendingChunks_;
+  }
+  pendingChanged_.notify_all();
+}
+
+void FibUpdatePipeline::chunkFailed(RouterID vrf, const std::exception& ex) {
+  {
+    std::lock_guard<std::mutex> guard(pendingLock_);
+    failedVrfs_.insert(vrf);
+    if (!chunkError_) {
+      chunkError_ = folly::to<std::string>(
+          "Failed to program FIB chunk for VRF ", vrf, ": ", ex.what());
+    }
+  }
+  chunkDone();
+}
+
+void FibUpdatePipeline::checkChunkErrors() {
+  std::optional<std::string> error;
+  {
+    std::lock_guard<std::mutex> guard(pendingLock_);
+    error.swap(chunkError_);
+  }
+  if (error) {
+    throw FbossError(*error);
+  }
+}
+
+void FibUpdatePipeline::waitForIdle() {
+  std::unique_lock<std::mutex> guard(pendingLock_);
+  pendingChanged_.wait(
+      guard, [this] { return stopped_ || pendingChunks_ == 0; });
+}
+
+void FibUpdatePipeline::stop() {
+  {
+    std::lock_guard<std::mutex> guard(pendingLock_);
+    stopped_ = true;
+  }
+  pendingChanged_.notify_all();
+}
+
+size_t FibUpdatePipeline::pendingChunks() const {
+  std::lock_guard<std::mutex> guard(pendingLock_);
+  return pendingChunks_;
+}
+
+} // namespace facebook::fboss
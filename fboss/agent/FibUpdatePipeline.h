@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/types.h"
+
+#include <gflags/gflags.h>
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+DECLARE_bool(pipelined_fib_programming);
+DECLARE_int32(fib_pipeline_chunk_size);
+DECLARE_int32(fib_pipeline_max_pending_chunks);
+
+namespace facebook::fboss {
+
+class SwSwitch;
+
+/*
+ * Normally a standalone RIB update computes the new FIB and then blocks the
+ * RIB thread, with the RIB locked, until SwSwitch has programmed the FIB to
+ * hardware. No RIB work can overlap with hardware programming.
+ *
+ * With --pipelined_fib_programming the FIB update callback instead diffs the
+ * new FIB against the last one it queued, and queues the difference as
+ * non blocking state updates of at most --fib_pipeline_chunk_size routes.
+ * The RIB thread moves on to the next update while the update thread
+ * programs the chunks. Chunks adding or changing routes are queued ahead of
+ * chunks removing routes, so routes move to their new next hops (which the
+ * HwSwitch creates as routes reference them) before the old routes, and any
+ * next hops only they used, go away. Removal chunks are never coalesced with
+ * other updates, as within a single state delta HwSwitches remove routes
+ * before adding them.
+ *
+ * Before queuing each chunk the RIB thread waits until fewer than
+ * --fib_pipeline_max_pending_chunks chunks are pending, so one large update
+ * can't queue an unbounded number of them. Applying config makes the update
+ * thread wait on the RIB thread, so the RIB thread stops waiting, and stops
+ * queuing the rest of the update, as soon as a reconfigure is pending.
+ *
+ * Applying config recomputes the FIBs from the RIB. Chunks queued before
+ * that are superseded and dropped, and the next FIB update of each VRF is
+ * queued as a whole FIB rather than a diff.
+ *
+ * A chunk which fails to apply leaves hardware behind the FIB we diff
+ * against, so the next FIB update of its VRF is queued as a whole FIB. The
+ * failure is reported to the next route update caller to call
+ * checkChunkErrors(), as by the time it happens the caller whose update
+ * queued the chunk may have returned already.
+ */
+class FibUpdatePipeline {
+ public:
+  explicit FibUpdatePipeline(SwSwitch* sw);
+  ~FibUpdatePipeline();
+
+  /*
+   * FIB update callback, called in the RIB thread
+   */
+  void fibUpdated(
+      RouterID vrf,
+      const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+      const rib::IPv6NetworkToRouteMap& v6NetworkToRoute);
+
+  /*
+   * Throw an FbossError if any chunk failed to apply since the last call
+   */
+  void checkChunkErrors();
+
+  /*
+   * Wait until every queued chunk has been programmed.
+   */
+  void waitForIdle();
+
+  /*
+   * Release any waiters, for SwSwitch shutdown. Chunks still queued are
+   * never applied.
+   */
+  void stop();
+
+  size_t pendingChunks() const;
+
+ private:
+  class ChunkUpdate;
+
+  struct QueuedFibs {
+    std::shared_ptr<ForwardingInformationBaseV4> v4;
+    std::shared_ptr<ForwardingInformationBaseV6> v6;
+    uint64_t reconfigureGeneration{0};
+  };
+
+  // Forbidden copy constructor and assignment operator
+  FibUpdatePipeline(FibUpdatePipeline const&) = delete;
+  FibUpdatePipeline& operator=(FibUpdatePipeline const&) = delete;
+
+  void queueFullFibs(
+      RouterID vrf,
+      const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+      const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+      uint64_t reconfigureGeneration);
+  /*
+   * Queue the chunk once there is capacity for it. Returns false, dropping
+   * the chunk, if a reconfigure supersedes it or SwSwitch is exiting.
+   */
+  bool queue(std::unique_ptr<ChunkUpdate> chunk);
+  void chunkDone();
+  void chunkFailed(RouterID vrf, const std::exception& ex);
+
+  SwSwitch* sw_;
+  // The FIBs as of the last queued chunk, only accessed in the RIB thread
+  std::map<RouterID, QueuedFibs> queuedFibs_;
+
+  mutable std::mutex pendingLock_;
+  std::condition_variable pendingChanged_;
+  size_t pendingChunks_{0};
+  bool stopped_{false};
+  // VRFs with a failed chunk, to queue a whole FIB for next
+  std::set<RouterID> failedVrfs_;
+  // First failure not yet reported by checkChunkErrors()
+  std::optional<std::string> chunkError_;
+};
+
+} // namespace facebook::fboss
@@ -13,6 +13,7 @@
 #include "fboss/agent/normalization/Normalizer.h"
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/TxPacket.h"
 #include "fboss/agent/Utils.h"
 
 #include <fb303/ThreadCachedServiceData.h>
@@ -51,6 +52,18 @@ void HwSwitch::switchRunStateChanged(SwitchRunState newState) {
   }
 }
 
+size_t HwSwitch::sendPacketsAsync(std::vector<BatchTxPacket> pkts) noexcept {
+  size_t sent = 0;
+  for (auto& batchPkt : pkts) {
+    bool ok = batchPkt.port
+        ? sendPacketOutOfPortAsync(
+              std::move(batchPkt.pkt), *batchPkt.port, batchPkt.queue)
+        : sendPacketSwitchedAsync(std::move(batchPkt.pkt));
+    sent += ok ? 1 : 0;
+  }
+  return sent;
+}
+
 void HwSwitch::updateStats(SwitchStats* switchStats) {
   updateStatsImpl(switchStats);
   // send to normalizer
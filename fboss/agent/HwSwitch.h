@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace folly {
 struct dynamic;
@@ -36,6 +37,17 @@ class L2Entry;
 class HwSwitchStats;
 enum class L2EntryUpdateType : uint8_t;
 
+/*
+ * One packet of a batch handed to HwSwitch::sendPacketsAsync(). Packets
+ * with a port are sent out of that port (and queue, if set), the rest use
+ * switching logic.
+ */
+struct BatchTxPacket {
+  std::unique_ptr<TxPacket> pkt;
+  std::optional<PortID> port;
+  std::optional<uint8_t> queue;
+};
+
 struct HwInitResult {
   std::shared_ptr<SwitchState> switchState{nullptr};
   std::shared_ptr<SwitchState> switchStateDesired{nullptr};
@@ -209,6 +221,15 @@ class HwSwitch {
       PortID portID,
       std::optional<uint8_t> queue = std::nullopt) noexcept = 0;
 
+  /*
+   * Send a batch of packets, each either out of its port or switched.
+   * Implementations may hand the whole batch to HW in one call, the default
+   * sends them one at a time via sendPacket*Async().
+   *
+   * @return Number of packets successfully sent to HW.
+   */
+  virtual size_t sendPacketsAsync(std::vector<BatchTxPacket> pkts) noexcept;
+
   /*
    * Allows hardware-specific code to record switch statistics.
    */
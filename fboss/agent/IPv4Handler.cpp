@@ -141,7 +141,8 @@ void IPv4Handler::handlePacket(
   cursor.reset(payload.get());
 
   // retrieve the current switch state
-  auto state = sw_->getState();
+  auto stateGuard = sw_->getStateReadGuard();
+  const auto& state = stateGuard.get();
   // Need to check if the packet is for self or not. We store our IP
   // in the ARP response table. Use that for now.
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
@@ -242,7 +243,7 @@ void IPv4Handler::handlePacket(
 
 // Return true if we successfully sent an ARP request, false otherwise
 bool IPv4Handler::resolveMac(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     PortID ingressPort,
     IPAddressV4 dest,
     VlanID ingressVlan) {
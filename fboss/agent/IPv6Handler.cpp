@@ -146,7 +146,8 @@ void IPv6Handler::handlePacket(
   cursor.reset(payload.get());
 
   // retrieve the current switch state
-  auto state = sw_->getState();
+  auto stateGuard = sw_->getStateReadGuard();
+  const auto& state = stateGuard.get();
   PortID port = pkt->getSrcPort();
 
   // NOTE: DHCPv6 solicit packet from client has hoplimit set to 1,
@@ -854,19 +855,24 @@ void IPv6Handler::sendMulticastNeighborSolicitations(
 }
 
 void IPv6Handler::floodNeighborAdvertisements() {
+  std::vector<std::pair<std::unique_ptr<TxPacket>, std::optional<PortID>>>
+      pkts;
   for (const auto& intf : *sw_->getState()->getInterfaces()) {
     for (const auto& addrEntry : intf->getAddresses()) {
       if (!addrEntry.first.isV6()) {
         continue;
       }
-      sendNeighborAdvertisement(
-          intf->getVlanID(),
-          intf->getMac(),
-          addrEntry.first.asV6(),
-          MacAddress::BROADCAST,
-          IPAddressV6());
+      pkts.emplace_back(
+          makeNeighborAdvertisement(
+              intf->getVlanID(),
+              intf->getMac(),
+              addrEntry.first.asV6(),
+              MacAddress::BROADCAST,
+              IPAddressV6()),
+          std::nullopt);
     }
   }
+  sw_->sendNetworkControlPacketsAsync(std::move(pkts));
 }
 
 void IPv6Handler::sendNeighborAdvertisement(
@@ -876,6 +882,16 @@ void IPv6Handler::sendNeighborAdvertisement(
     MacAddress dstMac,
     IPAddressV6 dstIP,
     const std::optional<PortDescriptor>& portDescriptor) {
+  auto pkt = makeNeighborAdvertisement(vlan, srcMac, srcIP, dstMac, dstIP);
+  sw_->sendNetworkControlPacketAsync(std::move(pkt), portDescriptor);
+}
+
+std::unique_ptr<TxPacket> IPv6Handler::makeNeighborAdvertisement(
+    VlanID vlan,
+    MacAddress srcMac,
+    IPAddressV6 srcIP,
+    MacAddress dstMac,
+    IPAddressV6 dstIP) {
   XLOG(DBG4) << "sending neighbor advertisement to " << dstIP.str() << " ("
              << dstMac << "): for " << srcIP << " (" << srcMac << ")";
 
@@ -900,7 +916,7 @@ void IPv6Handler::sendNeighborAdvertisement(
     ndpOptions.serialize(cursor);
   };
 
-  auto pkt = createICMPv6Pkt(
+  return createICMPv6Pkt(
       sw_,
       dstMac,
       srcMac,
@@ -911,7 +927,6 @@ void IPv6Handler::sendNeighborAdvertisement(
       ICMPv6Code::ICMPV6_CODE_NDP_MESSAGE_CODE,
       bodyLength,
       serializeBody);
-  sw_->sendNetworkControlPacketAsync(std::move(pkt), portDescriptor);
 }
 
 void IPv6Handler::sendNeighborSolicitation(
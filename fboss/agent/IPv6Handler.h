@@ -32,6 +32,7 @@ class Interface;
 class RxPacket;
 class StateDelta;
 class SwitchState;
+class TxPacket;
 class Vlan;
 
 class IPv6Handler : public AutoRegisterStateObserver {
@@ -161,6 +162,12 @@ class IPv6Handler : public AutoRegisterStateObserver {
       folly::IPAddressV6 dstIP,
       const std::optional<PortDescriptor>& portDescriptor =
           std::optional<PortDescriptor>());
+  std::unique_ptr<TxPacket> makeNeighborAdvertisement(
+      VlanID vlan,
+      folly::MacAddress srcMac,
+      folly::IPAddressV6 srcIP,
+      folly::MacAddress dstMac,
+      folly::IPAddressV6 dstIP);
 
   void resolveDestAndHandlePacket(
       IPv6Hdr hdr,
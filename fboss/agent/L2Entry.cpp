@@ -40,4 +40,24 @@ std::string L2Entry::str() const {
   return os.str();
 }
 
+L2EntryThrift toL2EntryThrift(const L2Entry& l2Entry) {
+  L2EntryThrift entry;
+  *entry.mac_ref() = l2Entry.getMac().toString();
+  *entry.vlanID_ref() = l2Entry.getVlanID();
+  *entry.port_ref() = 0;
+  if (l2Entry.getPort().isAggregatePort()) {
+    entry.trunk_ref() = l2Entry.getPort().aggPortID();
+  } else {
+    *entry.port_ref() = l2Entry.getPort().phyPortID();
+  }
+  *entry.l2EntryType_ref() =
+      l2Entry.getType() == L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING
+      ? L2EntryType::L2_ENTRY_TYPE_PENDING
+      : L2EntryType::L2_ENTRY_TYPE_VALIDATED;
+  if (l2Entry.getClassID()) {
+    entry.classID_ref() = static_cast<int>(*l2Entry.getClassID());
+  }
+  return entry;
+}
+
 } // namespace facebook::fboss
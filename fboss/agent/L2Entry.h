@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/state/PortDescriptor.h"
 #include "fboss/agent/state/Vlan.h"
 
@@ -79,4 +80,6 @@ class L2Entry {
   std::optional<cfg::AclLookupClass> classID_{std::nullopt};
 };
 
+L2EntryThrift toL2EntryThrift(const L2Entry& l2Entry);
+
 } // namespace facebook::fboss
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/L2LearningEventStream.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+namespace {
+
+int64_t nowUsecs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+L2LearningEventStream::L2LearningEventStream()
+    : state_(std::make_shared<folly::Synchronized<State>>()) {}
+
+L2LearningEventStream::~L2LearningEventStream() {
+  std::map<uint64_t, std::unique_ptr<Publisher>> subscribers;
+  state_->withWLock([&subscribers](auto& state) {
+    subscribers.swap(state.subscribers);
+  });
+  // Complete outside of the lock, as completing runs the callback which
+  // removes the subscriber
+  for (auto& subscriber : subscribers) {
+    std::move(*subscriber.second).complete();
+  }
+}
+
+void L2LearningEventStream::expireRemoved(
+    State& state,
+    Clock::time_point now) {
+  while (!state.removedOrder.empty() &&
+         state.removedOrder.front().first + kMoveWindow < now) {
+    auto removed = state.removed.find(state.removedOrder.front().second);
+    // The MAC may have been learned, or removed again, since
+    if (removed != state.removed.end() &&
+        removed->second.second == state.removedOrder.front().first) {
+      state.removed.erase(removed);
+    }
+    state.removedOrder.pop_front();
+  }
+}
+
+std::optional<L2LearningEvent> L2LearningEventStream::update(
+    const L2Entry& l2Entry,
+    L2EntryUpdateType l2EntryUpdateType) {
+  return state_->withWLock([&l2Entry, l2EntryUpdateType](auto& state)
+                               -> std::optional<L2LearningEvent> {
+    auto now = Clock::now();
+    expireRemoved(state, now);
+
+    MacKey key{l2Entry.getVlanID(), l2Entry.getMac()};
+    auto port = l2Entry.getPort();
+    L2LearningEvent event;
+    auto learned = state.learned.find(key);
+    if (l2EntryUpdateType == L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD) {
+      std::optional<PortDescriptor> oldPort;
+      if (learned != state.learned.end()) {
+        if (learned->second == port) {
+          // Learned again on the same port, nothing new
+          return std::nullopt;
+        }
+        oldPort = learned->second;
+        learned->second = port;
+      } else {
+        auto removed = state.removed.find(key);
+        if (removed != state.removed.end()) {
+          if (removed->second.first != port) {
+            oldPort = removed->second.first;
+          }
+          state.removed.erase(removed);
+        }
+        state.learned.emplace(key, port);
+      }
+      if (oldPort) {
+        *event.type_ref() = L2LearningEventType::MOVE;
+        if (oldPort->isAggregatePort()) {
+          event.oldTrunk_ref() = oldPort->aggPortID();
+        } else {
+          event.oldPort_ref() = oldPort->phyPortID();
+        }
+        XLOG(DBG2) << "MAC moved from " << *oldPort << ": " << l2Entry.str();
+      } else {
+        *event.type_ref() = L2LearningEventType::LEARN;
+      }
+    } else {
+      if (learned != state.learned.end()) {
+        if (learned->second != port) {
+          // Stale removal, the MAC moved since
+          return std::nullopt;
+        }
+        state.learned.erase(learned);
+      }
+      state.removed.insert_or_assign(key, std::make_pair(port, now));
+      state.removedOrder.emplace_back(now, key);
+      *event.type_ref() = L2LearningEventType::AGE;
+    }
+    *event.entry_ref() = toL2EntryThrift(l2Entry);
+    *event.timestampUsecs_ref() = nowUsecs();
+
+    // Publish under the lock, so no subscriber sees events out of order
+    for (auto& subscriber : state.subscribers) {
+      subscriber.second->next(event);
+    }
+    return event;
+  });
+}
+
+apache::thrift::ServerStream<L2LearningEvent>
+L2LearningEventStream::subscribe() {
+  auto locked = state_->wlock();
+  auto id = locked->nextSubscriberId++;
+  std::weak_ptr<folly::Synchronized<State>> weakState = state_;
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<L2LearningEvent>::createPublisher(
+          [weakState, id] {
+            XLOG(INFO) << "L2 learning event subscriber " << id << " gone";
+            if (auto state = weakState.lock()) {
+              state->wlock()->subscribers.erase(id);
+            }
+          });
+  XLOG(INFO) << "L2 learning event subscriber " << id;
+  locked->subscribers.emplace(
+      id, std::make_unique<Publisher>(std::move(streamAndPublisher.second)));
+  return std::move(streamAndPublisher.first);
+}
+
+size_t L2LearningEventStream::numSubscribers() const {
+  return state_->rlock()->subscribers.size();
+}
+
+} // namespace facebook::fboss
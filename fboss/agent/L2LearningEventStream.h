@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <folly/MacAddress.h>
+#include <folly/Synchronized.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+
+namespace facebook::fboss {
+
+/*
+ * Pushes L2 learning callbacks to subscribeL2LearningEvents subscribers, as
+ * LEARN, AGE and MOVE events.
+ *
+ * The port each MAC was last learned on is kept to tell moves from learns.
+ * A MAC learned on another port than the one it was last learned on is a
+ * move, whether the hardware reports it as a learn alone, or, like Broadcom
+ * does, as a removal from the old port followed by a learn on the new one.
+ * For the latter, a removal is still pushed as an AGE, but a learn within
+ * kMoveWindow of it on a different port is pushed as a MOVE.
+ *
+ * Removals from a port other than the one the MAC was last learned on are
+ * stale, as the MAC already moved, and are not pushed.
+ */
+class L2LearningEventStream {
+ public:
+  static constexpr auto kMoveWindow = std::chrono::seconds(1);
+
+  L2LearningEventStream();
+  ~L2LearningEventStream();
+
+  /*
+   * Push the event for a learning callback. Returns the event pushed, if
+   * any.
+   */
+  std::optional<L2LearningEvent> update(
+      const L2Entry& l2Entry,
+      L2EntryUpdateType l2EntryUpdateType);
+
+  // Subscribe to the events pushed from now on
+  apache::thrift::ServerStream<L2LearningEvent> subscribe();
+
+  size_t numSubscribers() const;
+
+ private:
+  using Publisher = apache::thrift::ServerStreamPublisher<L2LearningEvent>;
+  using Clock = std::chrono::steady_clock;
+  using MacKey = std::pair<VlanID, folly::MacAddress>;
+
+  struct State {
+    // Port each MAC was last learned on
+    std::map<MacKey, PortDescriptor> learned;
+    // MACs removed in the last kMoveWindow, with the port they were removed
+    // from, and in the order they were removed in
+    std::map<MacKey, std::pair<PortDescriptor, Clock::time_point>> removed;
+    std::deque<std::pair<Clock::time_point, MacKey>> removedOrder;
+    std::map<uint64_t, std::unique_ptr<Publisher>> subscribers;
+    uint64_t nextSubscriberId{0};
+  };
+
+  // Forbidden copy constructor and assignment operator
+  L2LearningEventStream(L2LearningEventStream const&) = delete;
+  L2LearningEventStream& operator=(L2LearningEventStream const&) = delete;
+
+  static void expireRemoved(State& state, Clock::time_point now);
+
+  // Shared with the subscribers' cancel callbacks, which may outlive us
+  std::shared_ptr<folly::Synchronized<State>> state_;
+};
+
+} // namespace facebook::fboss
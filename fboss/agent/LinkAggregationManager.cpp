@@ -364,7 +364,9 @@ void LinkAggregationManager::enableForwardingAndSetPartnerState(
       portID, aggPortID, AggregatePort::Forwarding::ENABLED, partnerState);
 
   sw_->updateStateNoCoalescing(
-      "AggregatePort ForwardingAndPartnerState", std::move(enableFwdStateFn));
+      "AggregatePort ForwardingAndPartnerState",
+      std::move(enableFwdStateFn),
+      StateUpdate::Priority::LINK_STATE);
 }
 
 void LinkAggregationManager::disableForwardingAndSetPartnerState(
@@ -377,7 +379,9 @@ void LinkAggregationManager::disableForwardingAndSetPartnerState(
       portID, aggPortID, AggregatePort::Forwarding::DISABLED, partnerState);
 
   sw_->updateStateNoCoalescing(
-      "AggregatePort ForwardingAndPartnerState", std::move(disableFwdStateFn));
+      "AggregatePort ForwardingAndPartnerState",
+      std::move(disableFwdStateFn),
+      StateUpdate::Priority::LINK_STATE);
 }
 
 void LinkAggregationManager::recordLacpTimeout() {
@@ -11,6 +11,7 @@
 #include "fboss/agent/LldpManager.h"
 
 #include <folly/MacAddress.h>
+#include <folly/Random.h>
 #include <folly/Range.h>
 #include <folly/futures/Future.h>
 #include <folly/io/Cursor.h>
@@ -74,8 +75,18 @@ LldpManager::LldpManager(SwSwitch* sw)
 LldpManager::~LldpManager() {}
 
 void LldpManager::start() {
-  sw_->getBackgroundEvb()->runInEventBaseThread(
-      [this] { this->timeoutExpired(); });
+  sw_->getBackgroundEvb()->runInEventBaseThread([this] {
+    // Announce ourselves on every port right away, later rounds are spread
+    // across the interval.
+    try {
+      sendLldpOnAllPorts();
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Failed to send LLDP on all ports. Error:"
+                << folly::exceptionStr(ex);
+    }
+    nextSlot_ = 0;
+    scheduleTimeout(intervalMsecs_ / LLDP_TX_SLOTS);
+  });
 }
 
 void LldpManager::stop() {
@@ -140,25 +151,80 @@ void LldpManager::handlePacket(
 
 void LldpManager::timeoutExpired() noexcept {
   try {
-    sendLldpOnAllPorts();
+    sendLldpOnSlot(nextSlot_);
   } catch (const std::exception& ex) {
-    XLOG(ERR) << "Failed to send LLDP on all ports. Error:"
-              << folly::exceptionStr(ex);
+    XLOG(ERR) << "Failed to send LLDP on slot " << nextSlot_
+              << ". Error:" << folly::exceptionStr(ex);
   }
-  scheduleTimeout(intervalMsecs_);
+  nextSlot_ = (nextSlot_ + 1) % LLDP_TX_SLOTS;
+  scheduleTimeout(intervalMsecs_ / LLDP_TX_SLOTS);
 }
 
 void LldpManager::sendLldpOnAllPorts() {
-  // send lldp frames through all the ports here.
+  sendLldpOnPorts([](const FrameTemplate& /* frameTemplate */) {
+    return true;
+  });
+}
+
+void LldpManager::sendLldpOnSlot(uint16_t slot) {
+  sendLldpOnPorts([slot](const FrameTemplate& frameTemplate) {
+    return frameTemplate.slot == slot;
+  });
+}
+
+template <typename PortFilter>
+void LldpManager::sendLldpOnPorts(PortFilter filter) {
+  // send lldp frames through the selected ports here.
   std::shared_ptr<SwitchState> state = sw_->getState();
-  for (const auto& port : *state->getPorts()) {
+  auto ports = state->getPorts();
+  // Forget ports which no longer exist
+  for (auto iter = frameTemplates_.begin(); iter != frameTemplates_.end();) {
+    if (!ports->getPortIf(iter->first)) {
+      iter = frameTemplates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  const auto hostname = getHostname();
+  std::vector<std::pair<std::unique_ptr<TxPacket>, std::optional<PortID>>>
+      pkts;
+  for (const auto& port : *ports) {
+    if (!filter(getFrameTemplate(port->getID()))) {
+      continue;
+    }
     if (port->isPortUp()) {
-      sendLldpInfo(port);
+      // this LLDP packet HAS to exit out of the port specified here.
+      pkts.emplace_back(makeLldpInfoPkt(port, hostname), port->getID());
     } else {
       XLOG(DBG5) << "Skipping LLDP send as this port is disabled "
                  << port->getID();
     }
   }
+  if (!pkts.empty()) {
+    sw_->sendNetworkControlPacketsAsync(std::move(pkts));
+  }
+}
+
+LldpManager::FrameTemplate& LldpManager::getFrameTemplate(PortID port) {
+  auto iter = frameTemplates_.find(port);
+  if (iter == frameTemplates_.end()) {
+    iter = frameTemplates_.emplace(port, FrameTemplate()).first;
+    iter->second.slot = folly::Random::rand32(LLDP_TX_SLOTS);
+  }
+  return iter->second;
+}
+
+std::string LldpManager::getHostname() {
+  const size_t kMaxLen = 64;
+  std::array<char, kMaxLen> hostname;
+  if (0 == gethostname(hostname.data(), kMaxLen)) {
+    // make sure it is null terminated
+    hostname[kMaxLen - 1] = '\0';
+  } else {
+    hostname[0] = '\0';
+  }
+  return std::string(hostname.data());
 }
 
 uint16_t tlvHeader(uint16_t type, uint16_t length) {
@@ -313,37 +379,47 @@ std::unique_ptr<TxPacket> LldpManager::createLldpPkt(
   return pkt;
 }
 
-void LldpManager::sendLldpInfo(const std::shared_ptr<Port>& port) {
+std::unique_ptr<TxPacket> LldpManager::makeLldpInfoPkt(
+    const std::shared_ptr<Port>& port,
+    const std::string& hostname) {
   MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
   PortID thisPortID = port->getID();
 
-  const size_t kMaxLen = 64;
-  std::array<char, kMaxLen> hostname;
-  if (0 == gethostname(hostname.data(), kMaxLen)) {
-    // make sure it is null terminated
-    hostname[kMaxLen - 1] = '\0';
-  } else {
-    hostname[0] = '\0';
+  auto& frameTemplate = getFrameTemplate(thisPortID);
+  if (frameTemplate.frame.empty() || frameTemplate.cpuMac != cpuMac ||
+      frameTemplate.vlan != port->getIngressVlan() ||
+      frameTemplate.hostname != hostname ||
+      frameTemplate.portName != port->getName() ||
+      frameTemplate.portDesc != port->getDescription()) {
+    auto templatePkt = LldpManager::createLldpPkt(
+        sw_,
+        cpuMac,
+        port->getIngressVlan(),
+        hostname,
+        port->getName(),
+        port->getDescription(),
+        TTL_TLV_VALUE,
+        SYSTEM_CAPABILITY_ROUTER);
+    const auto* buf = templatePkt->buf();
+    frameTemplate.cpuMac = cpuMac;
+    frameTemplate.vlan = port->getIngressVlan();
+    frameTemplate.hostname = hostname;
+    frameTemplate.portName = port->getName();
+    frameTemplate.portDesc = port->getDescription();
+    frameTemplate.frame.assign(buf->data(), buf->data() + buf->length());
   }
 
-  auto pkt = LldpManager::createLldpPkt(
-      sw_,
-      cpuMac,
-      port->getIngressVlan(),
-      std::string(hostname.data()),
-      port->getName(),
-      port->getDescription(),
-      TTL_TLV_VALUE,
-      SYSTEM_CAPABILITY_ROUTER);
-
-  // this LLDP packet HAS to exit out of the port specified here.
-  sw_->sendNetworkControlPacketAsync(
-      std::move(pkt), PortDescriptor(thisPortID));
-
-  XLOG(DBG4) << "sent LLDP "
+  auto pkt = sw_->allocatePacket(frameTemplate.frame.size());
+  memcpy(
+      pkt->buf()->writableData(),
+      frameTemplate.frame.data(),
+      frameTemplate.frame.size());
+
+  XLOG(DBG4) << "sending LLDP "
              << " on port " << port->getID() << " with CPU MAC "
              << cpuMac.toString() << " port id " << port->getName()
              << " and vlan " << port->getIngressVlan();
+  return pkt;
 }
 
 } // namespace facebook::fboss
@@ -11,7 +11,9 @@
 #pragma once
 #include <folly/io/async/AsyncTimeout.h>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/lldp/LinkNeighborDB.h"
 #include "fboss/agent/state/Port.h"
@@ -54,7 +56,11 @@ class LldpManager : private folly::AsyncTimeout {
     SYSTEM_CAPABILITY_ROUTER = 1 << 4, // 5th bit for router
     TTL_TLV_LENGTH = 0x2,
     TTL_TLV_VALUE = 120,
-    PDU_END_TLV_LENGTH = 0
+    PDU_END_TLV_LENGTH = 0,
+    // Each LLDP_INTERVAL is split into this many slots. Every port is
+    // assigned a random slot, so frames go out spread across the interval
+    // rather than in one burst.
+    LLDP_TX_SLOTS = 10
   };
   explicit LldpManager(SwSwitch* sw);
   ~LldpManager() override;
@@ -95,6 +101,9 @@ class LldpManager : private folly::AsyncTimeout {
   // This function is internal.  It is only public for use in unit tests.
   void sendLldpOnAllPorts();
 
+  // Send LLDP on the up ports assigned to the given slot of the interval.
+  void sendLldpOnSlot(uint16_t slot);
+
   LinkNeighborDB* getDB() {
     return &db_;
   }
@@ -112,12 +121,38 @@ class LldpManager : private folly::AsyncTimeout {
       const std::string& sysDesc);
 
  private:
+  /*
+   * The LLDP frame for a port only changes when the port's name,
+   * description or VLAN, or the hostname or CPU MAC change. The encoded
+   * frame is cached per port and copied into each packet sent, and
+   * rebuilt only when one of those inputs differs.
+   */
+  struct FrameTemplate {
+    folly::MacAddress cpuMac;
+    VlanID vlan{0};
+    std::string hostname;
+    std::string portName;
+    std::string portDesc;
+    std::vector<uint8_t> frame;
+    uint16_t slot{0};
+  };
+
   void timeoutExpired() noexcept override;
-  void sendLldpInfo(const std::shared_ptr<Port>& port);
+  template <typename PortFilter>
+  void sendLldpOnPorts(PortFilter filter);
+  std::unique_ptr<TxPacket> makeLldpInfoPkt(
+      const std::shared_ptr<Port>& port,
+      const std::string& hostname);
+  FrameTemplate& getFrameTemplate(PortID port);
+  static std::string getHostname();
 
   SwSwitch* sw_{nullptr};
   std::chrono::milliseconds intervalMsecs_;
   LinkNeighborDB db_;
+
+  // Only accessed from the thread sending LLDP, the background EventBase
+  std::unordered_map<PortID, FrameTemplate> frameTemplates_;
+  uint16_t nextSlot_{0};
 };
 
 } // namespace facebook::fboss
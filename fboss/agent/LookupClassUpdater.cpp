@@ -82,7 +82,10 @@ void LookupClassUpdater::removeClassIDForPortAndMac(
       return MacTableUtils::removeClassIDForEntry(state, vlan, removedEntry);
     };
 
-    sw_->updateState("remove classID: ", std::move(removeMacClassIDFn));
+    sw_->updateState(
+        "remove classID: ",
+        std::move(removeMacClassIDFn),
+        StateUpdate::Priority::NEIGHBOR);
   } else {
     auto updater = sw_->getNeighborUpdater();
     updater->updateEntryClassID(vlan, removedEntry->getIP());
@@ -158,7 +161,8 @@ void LookupClassUpdater::updateNeighborClassID(
 
     sw_->updateState(
         folly::to<std::string>("configure lookup classID: ", classID),
-        std::move(updateMacClassIDFn));
+        std::move(updateMacClassIDFn),
+        StateUpdate::Priority::NEIGHBOR);
   } else {
     auto updater = sw_->getNeighborUpdater();
     updater->updateEntryClassID(vlanID, newEntry->getIP(), classID);
@@ -279,7 +283,8 @@ void LookupClassUpdater::processChanged(
 
         sw_->updateState(
             folly::to<std::string>("Reconfigure lookup classID: ", classID),
-            std::move(updateMacClassIDFn));
+            std::move(updateMacClassIDFn),
+            StateUpdate::Priority::NEIGHBOR);
       } else {
         updateNeighborClassID(stateDelta.newState(), vlan, newEntry);
       }
@@ -333,7 +338,10 @@ void LookupClassUpdater::clearClassIdsForResolvedNeighbors(
                     state, vlanID, entry);
               };
 
-          sw_->updateState("remove classID: ", std::move(removeMacClassIDFn));
+          sw_->updateState(
+              "remove classID: ",
+              std::move(removeMacClassIDFn),
+              StateUpdate::Priority::NEIGHBOR);
         } else {
           auto updater = sw_->getNeighborUpdater();
           updater->updateEntryClassID(vlanID, entry.get()->getIP());
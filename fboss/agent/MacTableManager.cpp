@@ -28,7 +28,8 @@ void MacTableManager::handleL2LearningUpdate(
 
   sw_->updateState(
       folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+      std::move(updateMacTableFn),
+      StateUpdate::Priority::NEIGHBOR);
 }
 
 } // namespace facebook::fboss
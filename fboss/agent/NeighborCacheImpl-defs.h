@@ -101,7 +101,9 @@ void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
   };
 
   sw_->updateState(
-      folly::to<std::string>("add neighbor ", fields.ip), std::move(updateFn));
+      folly::to<std::string>("add neighbor ", fields.ip),
+      std::move(updateFn),
+      StateUpdate::Priority::NEIGHBOR);
 }
 
 template <typename NTable>
@@ -141,7 +143,8 @@ void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
 
   sw_->updateStateNoCoalescing(
       folly::to<std::string>("add pending entry ", fields.ip),
-      std::move(updateFn));
+      std::move(updateFn),
+      StateUpdate::Priority::NEIGHBOR);
 }
 
 template <typename NTable>
@@ -230,7 +233,8 @@ void NeighborCacheImpl<NTable>::updateEntryClassID(
     sw_->updateState(
         folly::to<std::string>(
             "NeighborCache configure lookup classID: ", classIDStr),
-        std::move(updateClassIDFn));
+        std::move(updateClassIDFn),
+        StateUpdate::Priority::NEIGHBOR);
   }
 }
 
@@ -360,9 +364,15 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
   if (flushed) {
     // need a blocking state update if the caller wants to know if an entry
     // was actually flushed
-    sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
+    sw_->updateStateBlocking(
+        "flush neighbor entry",
+        std::move(updateFn),
+        StateUpdate::Priority::NEIGHBOR);
   } else {
-    sw_->updateState("remove neighbor entry: " + ip.str(), std::move(updateFn));
+    sw_->updateState(
+        "remove neighbor entry: " + ip.str(),
+        std::move(updateFn),
+        StateUpdate::Priority::NEIGHBOR);
   }
 }
 
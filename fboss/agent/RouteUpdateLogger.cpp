@@ -72,9 +72,45 @@ RouteUpdateLogger::RouteUpdateLogger(
       swSwitch_(sw),
       routeLoggerV4_(std::move(routeLoggerV4)),
       routeLoggerV6_(std::move(routeLoggerV6)),
-      mplsRouteLogger_(std::move(mplsRouteLogger)) {}
+      mplsRouteLogger_(std::move(mplsRouteLogger)),
+      loggingThread_("RouteUpdateLogger") {}
 
 void RouteUpdateLogger::stateUpdated(const StateDelta& delta) {
+  if (!delta.isChanged(SwitchStateSubsystem::ROUTE_TABLES) &&
+      !delta.isChanged(SwitchStateSubsystem::FIBS) &&
+      !delta.isChanged(SwitchStateSubsystem::LABEL_FIB)) {
+    return;
+  }
+  if (prefixTracker_.empty() && labelTracker_.rlock()->empty()) {
+    return;
+  }
+  // StateDelta can't be copied, but is cheap to rebuild from the states
+  {
+    auto pending = pending_.wlock();
+    if (pending->has_value()) {
+      // Logging is already scheduled, fold this update into it
+      (*pending)->newState = delta.newState();
+      return;
+    }
+    *pending = PendingStates{delta.oldState(), delta.newState()};
+  }
+  loggingThread_.getEventBase()->runInEventBaseThread(
+      [this]() { logPendingRouteChanges(); });
+}
+
+void RouteUpdateLogger::logPendingRouteChanges() {
+  std::optional<PendingStates> pending;
+  pending_.wlock()->swap(pending);
+  if (pending) {
+    logRouteChanges(StateDelta(pending->oldState, pending->newState));
+  }
+}
+
+void RouteUpdateLogger::waitForLogging() {
+  loggingThread_.getEventBase()->runInEventBaseThreadAndWait([]() {});
+}
+
+void RouteUpdateLogger::logRouteChanges(const StateDelta& delta) {
   forEachChangedRoute<folly::IPAddressV4>(
       swSwitch_->isStandaloneRibEnabled(),
       delta,
@@ -10,6 +10,8 @@
 #pragma once
 
 #include <folly/IPAddress.h>
+#include <folly/Synchronized.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 #include <folly/logging/xlog.h>
 #include "fboss/agent/RouteUpdateLoggingPrefixTracker.h"
 #include "fboss/agent/StateObserver.h"
@@ -18,6 +20,7 @@
 #include "fboss/agent/state/StateDelta.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace facebook::fboss {
@@ -136,6 +139,9 @@ class LabelsTracker {
       const std::string& identifier);
   void untrack(const std::string& identifier);
   TrackedLabelsInfo getTrackedLabelsInfo() const;
+  bool empty() const {
+    return label2Ids_.empty();
+  }
 
   void getIdentifiersForLabel(
       LabelForwardingEntry::Label label,
@@ -151,6 +157,13 @@ class LabelsTracker {
  * (or more specific location with that prefix) is added, removed, or
  * changes, log that information. The logger is pluggable, but by default
  * we use GLOG.
+ *
+ * Matching changed routes against the tracked prefixes and logging them
+ * happens on a thread of our own, not on the update thread, which only
+ * hands over the old and new states, and only when something is tracked.
+ * Updates the logging thread has not got to yet are coalesced into one,
+ * from the oldest old state to the newest new state, so no more than one
+ * pair of states is held on to however far behind logging falls.
  */
 class RouteUpdateLogger : public AutoRegisterStateObserver {
   // TODO(pshaikh): rename RouteUpdateLogger to FibUpdateObserver
@@ -181,6 +194,9 @@ class RouteUpdateLogger : public AutoRegisterStateObserver {
 
   std::vector<RouteUpdateLoggingInstance> getTrackedPrefixes() const;
 
+  // Wait for the state updates queued so far to be logged
+  void waitForLogging();
+
   LabelsTracker::TrackedLabelsInfo gettTrackedLabels() const;
 
   RouteLogger<folly::IPAddressV4>* getRouteLoggerV4() const {
@@ -195,12 +211,26 @@ class RouteUpdateLogger : public AutoRegisterStateObserver {
   }
 
  private:
+  struct PendingStates {
+    std::shared_ptr<SwitchState> oldState;
+    std::shared_ptr<SwitchState> newState;
+  };
+
+  // Log the pending route changes, on the logging thread
+  void logPendingRouteChanges();
+  // Log the route changes of a delta, on the logging thread
+  void logRouteChanges(const StateDelta& delta);
+
   const SwSwitch* swSwitch_;
   RouteUpdateLoggingPrefixTracker prefixTracker_;
   folly::Synchronized<LabelsTracker> labelTracker_;
   std::unique_ptr<RouteLogger<folly::IPAddressV4>> routeLoggerV4_;
   std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6_;
   std::unique_ptr<MplsRouteLogger> mplsRouteLogger_;
+  // States not logged yet. Logging is scheduled whenever this is set.
+  folly::Synchronized<std::optional<PendingStates>> pending_;
+  // Last, so it is stopped before anything its callbacks use is destroyed
+  folly::ScopedEventBaseThread loggingThread_;
 };
 
 } // namespace facebook::fboss
@@ -10,6 +10,7 @@
 
 #include "RouteUpdateLoggingPrefixTracker.h"
 #include <folly/logging/xlog.h>
+#include <folly/synchronization/Rcu.h>
 
 namespace facebook::fboss {
 
@@ -24,6 +25,13 @@ std::string RouteUpdateLoggingInstance::str() const {
       "{} {} {}", prefix.str(), identifier, exact ? "exact" : "longest-match");
 }
 
+RouteUpdateLoggingPrefixTracker::RouteUpdateLoggingPrefixTracker()
+    : merged_(new MergedTree()) {}
+
+RouteUpdateLoggingPrefixTracker::~RouteUpdateLoggingPrefixTracker() {
+  delete merged_.load();
+}
+
 void RouteUpdateLoggingPrefixTracker::track(
     const RouteUpdateLoggingInstance& req) {
   XLOG(INFO) << "Tracking " << req.str();
@@ -34,6 +42,7 @@ void RouteUpdateLoggingPrefixTracker::track(
     if (!found.second) {
       found.first.value() = req;
     }
+    updateMerged(trackedPrefixes_);
   }
 }
 
@@ -48,6 +57,7 @@ void RouteUpdateLoggingPrefixTracker::stopTracking(
       return;
     }
     itr->second.erase(prefix.network, prefix.mask);
+    updateMerged(trackedPrefixes_);
   }
 }
 
@@ -57,31 +67,69 @@ void RouteUpdateLoggingPrefixTracker::stopTracking(
   XLOG(INFO) << "Stop tracking all prefixes for " << identifier;
   SYNCHRONIZED(trackedPrefixes_) {
     trackedPrefixes_.erase(identifier);
+    updateMerged(trackedPrefixes_);
+  }
+}
+
+void RouteUpdateLoggingPrefixTracker::updateMerged(
+    const TrackedPrefixes& trackedPrefixes) {
+  auto merged = std::make_unique<MergedTree>();
+  std::vector<RoutePrefix<folly::IPAddress>> prefixes;
+  for (const auto& prefixesOfIdentifier : trackedPrefixes) {
+    for (const auto& itr : prefixesOfIdentifier.second) {
+      const auto& prefix = itr->value().prefix;
+      if (merged->insert(prefix.network, prefix.mask, MergedIdentifiers())
+              .second) {
+        prefixes.push_back(prefix);
+      }
+    }
+  }
+  // A route's longest match in any identifier's tree is its longest match
+  // in the merged tree's, or one of the latter's parents
+  for (const auto& prefix : prefixes) {
+    auto& identifiers =
+        merged->exactMatch(prefix.network, prefix.mask).value();
+    for (const auto& prefixesOfIdentifier : trackedPrefixes) {
+      const auto& tree = prefixesOfIdentifier.second;
+      const auto match = tree.longestMatch(prefix.network, prefix.mask);
+      if (match == tree.end()) {
+        continue;
+      }
+      if (!match.value().exact) {
+        identifiers.longestMatch.push_back(prefixesOfIdentifier.first);
+      } else if (match.value().prefix.mask == prefix.mask) {
+        identifiers.exactMatch.push_back(match.value());
+      }
+    }
   }
+  folly::rcu_retire(
+      merged_.exchange(merged.release(), std::memory_order_acq_rel));
 }
 
 bool RouteUpdateLoggingPrefixTracker::trackingImpl(
     const RoutePrefix<folly::IPAddress>& prefix,
     std::vector<std::string>& identifiers) const {
   identifiers.clear();
-  SYNCHRONIZED_CONST(trackedPrefixes_) {
-    for (const auto& prefixes : trackedPrefixes_) {
-      const auto match =
-          prefixes.second.longestMatch(prefix.network, prefix.mask);
-      if (match != prefixes.second.end()) {
-        if (!match.value().exact) {
-          identifiers.push_back(prefixes.first);
-          continue;
-        }
-        if (match.value().prefix == prefix) {
-          identifiers.push_back(prefixes.first);
-        }
-      }
+  folly::rcu_reader guard;
+  const auto* merged = merged_.load(std::memory_order_acquire);
+  const auto match = merged->longestMatch(prefix.network, prefix.mask);
+  if (match == merged->end()) {
+    return false;
+  }
+  identifiers = match.value().longestMatch;
+  for (const auto& exact : match.value().exactMatch) {
+    if (exact.prefix == prefix) {
+      identifiers.push_back(exact.identifier);
     }
   }
   return (identifiers.size() > 0);
 }
 
+bool RouteUpdateLoggingPrefixTracker::empty() const {
+  folly::rcu_reader guard;
+  return merged_.load(std::memory_order_acquire)->size() == 0;
+}
+
 std::vector<RouteUpdateLoggingInstance>
 RouteUpdateLoggingPrefixTracker::getTrackedPrefixes() const {
   std::vector<RouteUpdateLoggingInstance> allPrefixes;
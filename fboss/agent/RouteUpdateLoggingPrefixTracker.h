@@ -13,6 +13,7 @@
 #include "fboss/agent/state/RouteTypes.h"
 #include "fboss/lib/RadixTree.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -43,10 +44,18 @@ struct RouteUpdateLoggingInstance {
  * log route updates for.
  *
  * All the methods in this class are thread safe.
+ *
+ * The prefixes tracked by each identifier are kept in a tree per identifier.
+ * Every change to those rebuilds a single merged tree, keyed by every
+ * tracked prefix, holding the identifiers that track a route whose longest
+ * match among all tracked prefixes is that prefix. tracking() is then one
+ * longest match, on a snapshot of the merged tree protected by RCU instead
+ * of a lock, however many identifiers track prefixes.
  */
 class RouteUpdateLoggingPrefixTracker {
  public:
-  ~RouteUpdateLoggingPrefixTracker() {}
+  RouteUpdateLoggingPrefixTracker();
+  ~RouteUpdateLoggingPrefixTracker();
   /*
    * Start tracking a prefix. Will overwrite existing exact-ness settings.
    * i.e. for a single identifier, if we track expecting exact matches, then
@@ -60,6 +69,8 @@ class RouteUpdateLoggingPrefixTracker {
   // Stop tracking all the prefixes tracked with this identifier
   void stopTracking(const std::string& identifier);
   std::vector<RouteUpdateLoggingInstance> getTrackedPrefixes() const;
+  // Whether no prefix is tracked at all
+  bool empty() const;
 
   /* Returns whether or not the prefix is tracked for logging.
    * Will also populate identifiers with all of the identifiers that
@@ -75,13 +86,28 @@ class RouteUpdateLoggingPrefixTracker {
   }
 
  private:
+  using TrackedPrefixes = std::unordered_map<
+      std::string,
+      network::RadixTree<folly::IPAddress, RouteUpdateLoggingInstance>>;
+
+  // Identifiers tracking the routes whose longest match is a merged prefix
+  struct MergedIdentifiers {
+    // Tracking the prefix and any more specific route
+    std::vector<std::string> longestMatch;
+    // Tracking only a route to exactly their prefix
+    std::vector<RouteUpdateLoggingInstance> exactMatch;
+  };
+  using MergedTree = network::RadixTree<folly::IPAddress, MergedIdentifiers>;
+
   bool trackingImpl(
       const RoutePrefix<folly::IPAddress>& prefix,
       std::vector<std::string>& identifiers) const;
-  folly::Synchronized<std::unordered_map<
-      std::string,
-      network::RadixTree<folly::IPAddress, RouteUpdateLoggingInstance>>>
-      trackedPrefixes_;
+  // Publish a new merged tree, called with trackedPrefixes_ locked
+  void updateMerged(const TrackedPrefixes& trackedPrefixes);
+
+  folly::Synchronized<TrackedPrefixes> trackedPrefixes_;
+  // Replaced on every change, and retired once no reader holds it
+  std::atomic<MergedTree*> merged_;
 };
 
 } // namespace facebook::fboss
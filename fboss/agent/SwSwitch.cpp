@@ -17,11 +17,13 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/FibHelpers.h"
+#include "fboss/agent/FibUpdatePipeline.h"
 
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/IPv4Handler.h"
 #include "fboss/agent/IPv6Handler.h"
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/L2LearningEventStream.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/LldpManager.h"
@@ -56,6 +58,7 @@
 #include "fboss/agent/packet/PktUtil.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/NodeArena.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/StateUpdateHelpers.h"
 #include "fboss/agent/state/SwitchState.h"
@@ -76,6 +79,7 @@
 #include <thrift/lib/cpp2/async/RequestChannel.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
@@ -114,8 +118,23 @@ DEFINE_bool(
     false,
     "Flag to turn on logging of all updates to the FIB");
 
+DEFINE_int32(
+    state_update_max_wait_ms,
+    1000,
+    "Longest pending state updates wait behind higher priority updates "
+    "before being applied ahead of them");
+DEFINE_int32(
+    max_coalesced_state_updates,
+    0,
+    "Most state updates applied together in one batch, bounding how long "
+    "higher priority updates wait behind a batch (0 for no limit)");
+
 namespace {
 
+// TODO(joseph5wu): Control this by distinguishing the highest priority
+// queue from the config.
+constexpr uint8_t kNCStrictPriorityQueue = 7;
+
 /**
  * Transforms the IPAddressV6 to MacAddress. RFC 2464
  * 33:33:xx:xx:xx:xx (lower 32 bits are copied from addr)
@@ -175,11 +194,13 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       resolvedNexthopMonitor_(new ResolvedNexthopMonitor(this)),
       resolvedNexthopProbeScheduler_(new ResolvedNexthopProbeScheduler(this)),
       rib_(new rib::RoutingInformationBase()),
+      fibUpdatePipeline_(new FibUpdatePipeline(this)),
       portUpdateHandler_(new PortUpdateHandler(this)),
       lookupClassUpdater_(new LookupClassUpdater(this)),
       lookupClassRouteUpdater_(new LookupClassRouteUpdater(this)),
       staticL2ForNeighborObserver_(new StaticL2ForNeighborObserver(this)),
-      macTableManager_(new MacTableManager(this)) {
+      macTableManager_(new MacTableManager(this)),
+      l2LearningEventStream_(new L2LearningEventStream()) {
   // Create the platform-specific state directories if they
   // don't exist already.
   utilCreateDir(platform_->getVolatileStateDir());
@@ -193,6 +214,7 @@ SwSwitch::~SwSwitch() {
     stop();
     restart_time::stop();
   }
+  folly::rcu_retire(appliedStateDontUseDirectly_.exchange(nullptr));
 }
 
 void SwSwitch::stop() {
@@ -245,6 +267,9 @@ void SwSwitch::stop() {
   packetTxThreadHeartbeat_.reset();
   lacpThreadHeartbeat_.reset();
   neighborCacheThreadHeartbeat_.reset();
+  // Route updates waiting for the pipeline would never be released once
+  // the update thread stops
+  fibUpdatePipeline_->stop();
   rib_.reset();
 
   lookupClassUpdater_.reset();
@@ -668,9 +693,12 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
                << " since exit already started";
     return false;
   }
+  update->scheduledAt_ = std::chrono::steady_clock::now();
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    pendingUpdates_.push_back(*update.release());
+    auto priority = static_cast<size_t>(update->getPriority());
+    pendingUpdates_[priority].push_back(*update.release());
+    ++numPendingUpdates_[priority];
   }
 
   // Signal the update thread that updates are pending.
@@ -680,22 +708,33 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
   return true;
 }
 
-bool SwSwitch::updateState(StringPiece name, StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn));
+bool SwSwitch::updateState(
+    StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
+  auto update = make_unique<FunctionStateUpdate>(
+      name, std::move(fn), StateUpdate::kDefaultBehaviorFlags, priority);
   return updateState(std::move(update));
 }
 
-void SwSwitch::updateStateNoCoalescing(StringPiece name, StateUpdateFn fn) {
+void SwSwitch::updateStateNoCoalescing(
+    StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
   auto update = make_unique<FunctionStateUpdate>(
       name,
       std::move(fn),
-      static_cast<int>(StateUpdate::BehaviorFlags::NON_COALESCING));
+      static_cast<int>(StateUpdate::BehaviorFlags::NON_COALESCING),
+      priority);
   updateState(std::move(update));
 }
 
-void SwSwitch::updateStateBlocking(folly::StringPiece name, StateUpdateFn fn) {
+void SwSwitch::updateStateBlocking(
+    folly::StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
   auto behaviorFlags = static_cast<int>(StateUpdate::BehaviorFlags::NONE);
-  updateStateBlockingImpl(name, fn, behaviorFlags);
+  updateStateBlockingImpl(name, fn, behaviorFlags, priority);
 }
 
 void SwSwitch::updateStateWithHwFailureProtection(
@@ -711,10 +750,11 @@ void SwSwitch::updateStateWithHwFailureProtection(
 void SwSwitch::updateStateBlockingImpl(
     folly::StringPiece name,
     StateUpdateFn fn,
-    int stateUpdateBehavior) {
+    int stateUpdateBehavior,
+    StateUpdate::Priority priority) {
   auto result = std::make_shared<BlockingUpdateResult>();
   auto update = make_unique<BlockingStateUpdate>(
-      name, std::move(fn), result, stateUpdateBehavior);
+      name, std::move(fn), result, stateUpdateBehavior, priority);
   if (updateState(std::move(update))) {
     result->wait();
   }
@@ -724,6 +764,39 @@ void SwSwitch::handlePendingUpdatesHelper(SwSwitch* sw) {
   sw->handlePendingUpdates();
 }
 
+std::optional<StateUpdate::Priority> SwSwitch::nextPendingUpdatePriority(
+    std::chrono::steady_clock::time_point now) const {
+  std::optional<size_t> highest;
+  std::optional<size_t> starved;
+  for (size_t priority = 0; priority < pendingUpdates_.size(); ++priority) {
+    const auto& pending = pendingUpdates_[priority];
+    if (pending.empty()) {
+      continue;
+    }
+    if (!highest) {
+      highest = priority;
+      continue;
+    }
+    // Of the lower priorities that waited too long, serve the one waiting
+    // the longest
+    auto scheduledAt = pending.front().scheduledAt_;
+    if (FLAGS_state_update_max_wait_ms > 0 &&
+        now - scheduledAt >
+            std::chrono::milliseconds(FLAGS_state_update_max_wait_ms) &&
+        (!starved ||
+         scheduledAt < pendingUpdates_[*starved].front().scheduledAt_)) {
+      starved = priority;
+    }
+  }
+  if (starved) {
+    return static_cast<StateUpdate::Priority>(*starved);
+  }
+  if (highest) {
+    return static_cast<StateUpdate::Priority>(*highest);
+  }
+  return std::nullopt;
+}
+
 void SwSwitch::handlePendingUpdates() {
   // Get the list of updates to run.
   //
@@ -732,19 +805,38 @@ void SwSwitch::handlePendingUpdates() {
   // might also end up finding 0 updates to process if a previous
   // handlePendingUpdates() call processed multiple updates.
   StateUpdateList updates;
+  std::chrono::steady_clock::time_point now;
+  StateUpdate::Priority priority;
+  size_t numPending;
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    // When deciding how many elements to pull off the pendingUpdates_
-    // list, we pull as many as we can, subject to the following conditions
+    now = std::chrono::steady_clock::now();
+    auto nextPriority = nextPendingUpdatePriority(now);
+    // handlePendingUpdates() is invoked once for each update, but a
+    // previous call might have already processed everything.  If we don't
+    // have anything to do just return early.
+    if (!nextPriority) {
+      return;
+    }
+    priority = *nextPriority;
+    auto& pending = pendingUpdates_[static_cast<size_t>(priority)];
+    auto& numPendingOfPriority =
+        numPendingUpdates_[static_cast<size_t>(priority)];
+    numPending = numPendingOfPriority;
+    // When deciding how many elements to pull off the pending list, we pull
+    // as many as we can, subject to the following conditions
     // - Non coalescing updates are executed by themselves
-    auto iter = pendingUpdates_.begin();
-    while (iter != pendingUpdates_.end()) {
+    // - No more than --max_coalesced_state_updates are executed together
+    auto iter = pending.begin();
+    size_t numUpdates = 0;
+    while (iter != pending.end()) {
       StateUpdate* update = &(*iter);
       if (update->isNonCoalescing()) {
-        if (iter == pendingUpdates_.begin()) {
+        if (iter == pending.begin()) {
           // First update is non coalescing, splice it onto the updates list
           // and apply transaction by itself
           ++iter;
+          ++numUpdates;
           break;
         } else {
           // Splice all updates upto this non coalescing update, we will
@@ -753,16 +845,23 @@ void SwSwitch::handlePendingUpdates() {
         }
       }
       ++iter;
+      ++numUpdates;
+      if (FLAGS_max_coalesced_state_updates > 0 &&
+          numUpdates >=
+              static_cast<size_t>(FLAGS_max_coalesced_state_updates)) {
+        break;
+      }
     }
-    updates.splice(
-        updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
+    updates.splice(updates.begin(), pending, pending.begin(), iter);
+    numPendingOfPriority -= numUpdates;
   }
 
-  // handlePendingUpdates() is invoked once for each update, but a previous
-  // call might have already processed everything.  If we don't have anything
-  // to do just return early.
-  if (updates.empty()) {
-    return;
+  stats()->pendingStateUpdates(priority, numPending);
+  for (const auto& update : updates) {
+    stats()->stateUpdateWait(
+        priority,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            now - update.scheduledAt_));
   }
 
   // Non coalescing updates should be applied individually
@@ -784,6 +883,9 @@ void SwSwitch::handlePendingUpdates() {
   auto oldAppliedState = getState();
   // We start with the old state, and apply state updates one at a time.
   auto newDesiredState = oldAppliedState;
+  // Nodes cloned for the new state come from an arena of their own, when
+  // arenas are enabled
+  std::optional<NodeArena::Scope> arenaScope(std::in_place);
   auto iter = updates.begin();
   while (iter != updates.end()) {
     StateUpdate* update = &(*iter);
@@ -812,6 +914,10 @@ void SwSwitch::handlePendingUpdates() {
       newDesiredState = intermediateState;
     }
   }
+  auto allocations = arenaScope->allocations();
+  arenaScope.reset();
+  stats()->stateUpdateNodeAllocations(
+      allocations.allocations, allocations.bytes);
   // Start newAppliedState as equal to newDesiredState unless
   // we learn otherwise
   auto newAppliedState = newDesiredState;
@@ -862,12 +968,16 @@ void SwSwitch::handlePendingUpdates() {
 }
 
 void SwSwitch::setStateInternal(std::shared_ptr<SwitchState> newAppliedState) {
-  // This is one of the only two places that should ever directly access
-  // stateDontUseDirectly_.  (getState() being the other one.)
+  // This is one of the only places that should ever directly access
+  // appliedStateDontUseDirectly_.  (StateReadGuard and the destructor being
+  // the others.)
   CHECK(bool(newAppliedState));
   CHECK(newAppliedState->isPublished());
-  folly::SpinLockGuard guard(stateLock_);
-  appliedStateDontUseDirectly_.swap(newAppliedState);
+  auto oldAppliedState = appliedStateDontUseDirectly_.exchange(
+      new std::shared_ptr<SwitchState>(std::move(newAppliedState)),
+      std::memory_order_acq_rel);
+  // Readers may still be using the old state, release it once they are done
+  folly::rcu_retire(oldAppliedState);
 }
 
 std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
@@ -895,7 +1005,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // Inform the HwSwitch of the change.
   //
   // Note that at this point we have already updated the state pointer and
-  // released stateLock_, so the new state is already published and visible to
+  // published it, so the new state is already visible to
   // other threads.  This does mean that there is a window where the new state
   // is visible but the hardware is not using the new configuration yet.
   //
@@ -1142,7 +1252,9 @@ void SwSwitch::linkStateChanged(PortID portId, bool up) {
     return newState;
   };
   updateStateNoCoalescing(
-      "Port OperState Update", std::move(updateOperStateFn));
+      "Port OperState Update",
+      std::move(updateOperStateFn),
+      StateUpdate::Priority::LINK_STATE);
 }
 
 void SwSwitch::startThreads() {
@@ -1220,7 +1332,10 @@ void SwSwitch::stopThreads() {
     handlePendingUpdates();
     {
       folly::SpinLockGuard guard(pendingUpdatesLock_);
-      updatesDrained = pendingUpdates_.empty();
+      updatesDrained = std::all_of(
+          pendingUpdates_.begin(),
+          pendingUpdates_.end(),
+          [](const auto& pending) { return pending.empty(); });
     }
   } while (!updatesDrained);
 
@@ -1253,9 +1368,6 @@ void SwSwitch::sendNetworkControlPacketAsync(
     std::unique_ptr<TxPacket> pkt,
     std::optional<PortDescriptor> port) noexcept {
   if (port) {
-    // TODO(joseph5wu): Control this by distinguishing the highest priority
-    // queue from the config.
-    static const uint8_t kNCStrictPriorityQueue = 7;
     auto portVal = *port;
     switch (portVal.type()) {
       case PortDescriptor::PortType::PHYSICAL:
@@ -1272,6 +1384,34 @@ void SwSwitch::sendNetworkControlPacketAsync(
   }
 }
 
+void SwSwitch::sendNetworkControlPacketsAsync(
+    std::vector<std::pair<std::unique_ptr<TxPacket>, std::optional<PortID>>>
+        pkts) noexcept {
+  auto state = getState();
+  std::vector<BatchTxPacket> batch;
+  batch.reserve(pkts.size());
+  for (auto& [pkt, port] : pkts) {
+    if (port && !state->getPorts()->getPortIf(*port)) {
+      XLOG(ERR) << "sendNetworkControlPacketsAsync: dropping packet to "
+                << "unexpected port " << *port;
+      stats()->pktDropped();
+      continue;
+    }
+    pcapMgr_->packetSent(pkt.get());
+    batch.push_back(BatchTxPacket{
+        std::move(pkt),
+        port,
+        port ? std::make_optional(kNCStrictPriorityQueue) : std::nullopt});
+  }
+  auto numPkts = batch.size();
+  auto sent = hw_->sendPacketsAsync(std::move(batch));
+  if (sent != numPkts) {
+    // As with single packet sends, there's not much the caller can do
+    XLOG(ERR) << "failed to send " << numPkts - sent << " of " << numPkts
+              << " network control packets";
+  }
+}
+
 void SwSwitch::sendPacketOutOfPortAsync(
     std::unique_ptr<TxPacket> pkt,
     PortID portID,
@@ -1621,24 +1761,25 @@ bool SwSwitch::isStandaloneRibEnabled() const {
 }
 template <typename AddressT>
 std::shared_ptr<Route<AddressT>> SwSwitch::longestMatch(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     const AddressT& address,
     RouterID vrf) {
   return findLongestMatchRoute(isStandaloneRibEnabled(), vrf, address, state);
 }
 
 template std::shared_ptr<Route<folly::IPAddressV4>> SwSwitch::longestMatch(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     const folly::IPAddressV4& address,
     RouterID vrf);
 template std::shared_ptr<Route<folly::IPAddressV6>> SwSwitch::longestMatch(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     const folly::IPAddressV6& address,
     RouterID vrf);
 
 void SwSwitch::l2LearningUpdateReceived(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
+  l2LearningEventStream_->update(l2Entry, l2EntryUpdateType);
   macTableManager_->handleL2LearningUpdate(l2Entry, l2EntryUpdateType);
 }
 
@@ -23,9 +23,12 @@
 #include <folly/SpinLock.h>
 #include <folly/ThreadLocal.h>
 #include <folly/io/async/EventBase.h>
+#include <folly/synchronization/Rcu.h>
 #include <optional>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -34,6 +37,7 @@
 namespace facebook::fboss {
 
 class ArpHandler;
+class FibUpdatePipeline;
 class IPv4Handler;
 class IPv6Handler;
 class LinkAggregationManager;
@@ -55,6 +59,7 @@ class TunManager;
 class MirrorManager;
 class LookupClassUpdater;
 class LookupClassRouteUpdater;
+class L2LearningEventStream;
 class MacTableManager;
 class ResolvedNexthopMonitor;
 class ResolvedNexthopProbeScheduler;
@@ -195,6 +200,42 @@ class SwSwitch : public HwSwitch::Callback {
   std::shared_ptr<SwitchState> getState() const {
     return getAppliedState();
   }
+
+  /*
+   * Scoped, read-only access to the current applied switch state.
+   *
+   * Unlike getState(), this neither takes a lock nor touches the state's
+   * reference count: the state is kept alive by an RCU read side critical
+   * section for the lifetime of the guard. Intended for hot paths such as
+   * packet RX handlers. The guard must not outlive the calling scope, and
+   * callers that need to hold on to the state beyond it should copy the
+   * shared_ptr returned by get().
+   */
+  class StateReadGuard {
+   public:
+    explicit StateReadGuard(const SwSwitch* sw)
+        : state_(sw->appliedStateDontUseDirectly_.load(
+              std::memory_order_acquire)) {}
+
+    const std::shared_ptr<SwitchState>& get() const {
+      return *state_;
+    }
+    const std::shared_ptr<SwitchState>& operator*() const {
+      return *state_;
+    }
+    SwitchState* operator->() const {
+      return state_->get();
+    }
+
+   private:
+    // Must be constructed before state_ is loaded
+    folly::rcu_reader reader_;
+    const std::shared_ptr<SwitchState>* state_;
+  };
+
+  StateReadGuard getStateReadGuard() const {
+    return StateReadGuard(this);
+  }
   /**
    * Schedule an update to the switch state.
    *
@@ -231,8 +272,14 @@ class SwSwitch : public HwSwitch::Callback {
    * send a single update notification to the HwSwitch and other update
    * subscribers.  Therefore the StateUpdateFn may be called with an
    * unpublished SwitchState in some cases.
+   *
+   * Pending updates of a higher priority are applied before those of a lower
+   * one, see StateUpdate::Priority.
    */
-  bool updateState(folly::StringPiece name, StateUpdateFn fn);
+  bool updateState(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::kDefaultPriority);
 
   /**
    * Schedule an update to the switch state.
@@ -246,7 +293,10 @@ class SwSwitch : public HwSwitch::Callback {
    * but can be used when there is an update that MUST be seen by the hw
    * implementation, even if the inverse update is immediately applied.
    */
-  void updateStateNoCoalescing(folly::StringPiece name, StateUpdateFn fn);
+  void updateStateNoCoalescing(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::kDefaultPriority);
 
   /*
    * A version of updateState() that doesn't return until the update has been
@@ -256,7 +306,10 @@ class SwSwitch : public HwSwitch::Callback {
    * current thread until the operation completes.
    *
    */
-  void updateStateBlocking(folly::StringPiece name, StateUpdateFn fn);
+  void updateStateBlocking(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::kDefaultPriority);
 
   /*
    * A version of updateState() that reports back failures in applying state
@@ -462,6 +515,15 @@ class SwSwitch : public HwSwitch::Callback {
       std::unique_ptr<TxPacket> pkt,
       std::optional<PortDescriptor> port) noexcept;
 
+  /**
+   * Send many network control packets in one batch to HW. Each packet goes
+   * out of its physical port on the network control queue, or is switched
+   * if it has no port.
+   */
+  void sendNetworkControlPacketsAsync(
+      std::vector<std::pair<std::unique_ptr<TxPacket>, std::optional<PortID>>>
+          pkts) noexcept;
+
   void sendPacketOutOfPortAsync(
       std::unique_ptr<TxPacket> pkt,
       PortID portID,
@@ -584,11 +646,20 @@ class SwSwitch : public HwSwitch::Callback {
     return lookupClassRouteUpdater_.get();
   }
 
+  L2LearningEventStream* getL2LearningEventStream() {
+    return l2LearningEventStream_.get();
+  }
+
   rib::RoutingInformationBase* getRib() {
     DCHECK(isStandaloneRibEnabled());
     return rib_.get();
   }
 
+  FibUpdatePipeline* getFibUpdatePipeline() {
+    DCHECK(isStandaloneRibEnabled());
+    return fibUpdatePipeline_.get();
+  }
+
   /*
    * Gets the flags the SwSwitch was initialized with.
    */
@@ -661,7 +732,7 @@ class SwSwitch : public HwSwitch::Callback {
 
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> longestMatch(
-      std::shared_ptr<SwitchState> state,
+      const std::shared_ptr<SwitchState>& state,
       const AddressT& address,
       RouterID vrf);
 
@@ -673,20 +744,29 @@ class SwSwitch : public HwSwitch::Callback {
   void updateStateBlockingImpl(
       folly::StringPiece name,
       StateUpdateFn fn,
-      int stateUpdateBehavior);
+      int stateUpdateBehavior,
+      StateUpdate::Priority priority = StateUpdate::kDefaultPriority);
 
   /*
    * Applied state corresponds to what was successfully applied
    * to h/w
    */
   std::shared_ptr<SwitchState> getAppliedState() const {
-    folly::SpinLockGuard guard(stateLock_);
-    return appliedStateDontUseDirectly_;
+    return getStateReadGuard().get();
   }
 
   typedef folly::IntrusiveList<StateUpdate, &StateUpdate::listHook_>
       StateUpdateList;
 
+  /*
+   * Priority of the pending updates to apply next: the highest priority
+   * with pending updates, unless a lower priority one has waited longer
+   * than --state_update_max_wait_ms. Must be called with
+   * pendingUpdatesLock_ held.
+   */
+  std::optional<StateUpdate::Priority> nextPendingUpdatePriority(
+      std::chrono::steady_clock::time_point now) const;
+
   // Forbidden copy constructor and assignment operator
   SwSwitch(SwSwitch const&) = delete;
   SwSwitch& operator=(SwSwitch const&) = delete;
@@ -766,10 +846,12 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<TunManager> tunMgr_;
 
   /*
-   * A list of pending state updates to be applied.
+   * Lists of pending state updates to be applied, one per priority, and the
+   * number of updates in each.
    */
   folly::SpinLock pendingUpdatesLock_;
-  StateUpdateList pendingUpdates_;
+  std::array<StateUpdateList, StateUpdate::kNumPriorities> pendingUpdates_;
+  std::array<size_t, StateUpdate::kNumPriorities> numPendingUpdates_{};
 
   /*
    * The current switch state represented as :  appliedState,
@@ -777,8 +859,10 @@ class SwSwitch : public HwSwitch::Callback {
    *
    *
    * BEWARE: You generally shouldn't access these states directly, even
-   * internally within SwSwitch private methods.  These should only be accessed
-   * while holding stateLock_.
+   * internally within SwSwitch private methods.  The pointed to shared_ptr
+   * is published with RCU: readers may only dereference it inside an RCU
+   * read side critical section (see StateReadGuard), and setStateInternal()
+   * retires the previous one once all such readers are done.
    *
    * You almost certainly should call getAppliedState() setStateInternal()
    * instead of directly accessing appliedState
@@ -786,8 +870,8 @@ class SwSwitch : public HwSwitch::Callback {
    * This intentionally has an awkward name so people won't forget and try to
    * directly access this pointer.
    */
-  std::shared_ptr<SwitchState> appliedStateDontUseDirectly_;
-  mutable folly::SpinLock stateLock_;
+  std::atomic<std::shared_ptr<SwitchState>*> appliedStateDontUseDirectly_{
+      new std::shared_ptr<SwitchState>()};
 
   /*
    * A thread for performing various background tasks.
@@ -859,6 +943,7 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<ResolvedNexthopMonitor> resolvedNexthopMonitor_;
   std::unique_ptr<ResolvedNexthopProbeScheduler> resolvedNexthopProbeScheduler_;
   std::unique_ptr<rib::RoutingInformationBase> rib_{nullptr};
+  std::unique_ptr<FibUpdatePipeline> fibUpdatePipeline_;
 
   BootType bootType_{BootType::UNINITIALIZED};
   std::unique_ptr<LldpManager> lldpManager_;
@@ -869,6 +954,7 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<LookupClassRouteUpdater> lookupClassRouteUpdater_;
   std::unique_ptr<StaticL2ForNeighborObserver> staticL2ForNeighborObserver_;
   std::unique_ptr<MacTableManager> macTableManager_;
+  std::unique_ptr<L2LearningEventStream> l2LearningEventStream_;
 #if FOLLY_HAS_COROUTINES
   std::unique_ptr<MKAServiceManager> mkaServiceManager_;
 #endif
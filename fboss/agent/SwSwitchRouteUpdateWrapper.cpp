@@ -10,6 +10,7 @@
 
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 
+#include "fboss/agent/FibUpdatePipeline.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/Utils.h"
@@ -26,10 +27,15 @@ void swSwitchFibUpdate(
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
     void* cookie) {
+  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
+  if (FLAGS_pipelined_fib_programming) {
+    sw->getFibUpdatePipeline()->fibUpdated(
+        vrf, v4NetworkToRoute, v6NetworkToRoute);
+    return;
+  }
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
       vrf, v4NetworkToRoute, v6NetworkToRoute);
 
-  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateBlocking("", std::move(fibUpdater));
 }
 
@@ -59,6 +65,9 @@ void SwSwitchRouteUpdateWrapper::programStandAloneRib() {
         static_cast<void*>(sw_));
     updateStats(stats);
   }
+  if (FLAGS_pipelined_fib_programming) {
+    sw_->getFibUpdatePipeline()->checkChunkErrors();
+  }
 }
 
 void SwSwitchRouteUpdateWrapper::programLegacyRib() {
@@ -79,6 +79,96 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      linkStateUpdateQueueDepth_(
+          map,
+          kCounterPrefix + "state_update.link_state.queue_depth",
+          1,
+          0,
+          200,
+          AVG,
+          50,
+          100),
+      neighborUpdateQueueDepth_(
+          map,
+          kCounterPrefix + "state_update.neighbor.queue_depth",
+          1,
+          0,
+          200,
+          AVG,
+          50,
+          100),
+      routeUpdateQueueDepth_(
+          map,
+          kCounterPrefix + "state_update.route.queue_depth",
+          1,
+          0,
+          200,
+          AVG,
+          50,
+          100),
+      statsUpdateQueueDepth_(
+          map,
+          kCounterPrefix + "state_update.stats.queue_depth",
+          1,
+          0,
+          200,
+          AVG,
+          50,
+          100),
+      linkStateUpdateWait_(
+          map,
+          kCounterPrefix + "state_update.link_state.wait.us",
+          10000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      neighborUpdateWait_(
+          map,
+          kCounterPrefix + "state_update.neighbor.wait.us",
+          10000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      routeUpdateWait_(
+          map,
+          kCounterPrefix + "state_update.route.wait.us",
+          10000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      statsUpdateWait_(
+          map,
+          kCounterPrefix + "state_update.stats.wait.us",
+          10000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      stateUpdateNodeAllocations_(
+          map,
+          kCounterPrefix + "state_update.node_allocations",
+          1000,
+          0,
+          100000,
+          AVG,
+          50,
+          99),
+      stateUpdateNodeAllocBytes_(
+          map,
+          kCounterPrefix + "state_update.node_alloc_bytes",
+          100000,
+          0,
+          10000000,
+          AVG,
+          50,
+          99),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
       bgHeartbeatDelay_(
           map,
@@ -218,6 +308,36 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE) {}
 
+SwitchStats::TLHistogram* SwitchStats::queueDepthHistogram(
+    StateUpdate::Priority priority) {
+  switch (priority) {
+    case StateUpdate::Priority::LINK_STATE:
+      return &linkStateUpdateQueueDepth_;
+    case StateUpdate::Priority::NEIGHBOR:
+      return &neighborUpdateQueueDepth_;
+    case StateUpdate::Priority::ROUTE:
+      return &routeUpdateQueueDepth_;
+    case StateUpdate::Priority::STATS:
+      return &statsUpdateQueueDepth_;
+  }
+  return &routeUpdateQueueDepth_;
+}
+
+SwitchStats::TLHistogram* SwitchStats::waitHistogram(
+    StateUpdate::Priority priority) {
+  switch (priority) {
+    case StateUpdate::Priority::LINK_STATE:
+      return &linkStateUpdateWait_;
+    case StateUpdate::Priority::NEIGHBOR:
+      return &neighborUpdateWait_;
+    case StateUpdate::Priority::ROUTE:
+      return &routeUpdateWait_;
+    case StateUpdate::Priority::STATS:
+      return &statsUpdateWait_;
+  }
+  return &routeUpdateWait_;
+}
+
 PortStats* FOLLY_NULLABLE SwitchStats::port(PortID portID) {
   auto it = ports_.find(portID);
   if (it != ports_.end()) {
@@ -15,6 +15,7 @@
 #include <chrono>
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/state/StateUpdate.h"
 #include "fboss/agent/types.h"
 
 namespace facebook::fboss {
@@ -226,6 +227,28 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  /*
+   * Pending state updates of a priority when the update thread picked the
+   * next batch of that priority, and how long each update in it waited.
+   */
+  void pendingStateUpdates(StateUpdate::Priority priority, uint64_t count) {
+    queueDepthHistogram(priority)->addValue(count);
+  }
+  void stateUpdateWait(
+      StateUpdate::Priority priority,
+      std::chrono::microseconds us) {
+    waitHistogram(priority)->addValue(us.count());
+  }
+
+  /*
+   * SwitchState nodes allocated while running the update functions of one
+   * batch of state updates
+   */
+  void stateUpdateNodeAllocations(uint64_t allocations, uint64_t bytes) {
+    stateUpdateNodeAllocations_.addValue(allocations);
+    stateUpdateNodeAllocBytes_.addValue(bytes);
+  }
+
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
     // As syncFib() could include no routes.
     if (routes == 0) {
@@ -344,6 +367,9 @@ class SwitchStats : public boost::noncopyable {
 
   explicit SwitchStats(ThreadLocalStatsMap* map);
 
+  TLHistogram* queueDepthHistogram(StateUpdate::Priority priority);
+  TLHistogram* waitHistogram(StateUpdate::Priority priority);
+
   // Total number of trapped packets
   TLTimeseries trapPkts_;
   // Number of trapped packets that were intentionally dropped.
@@ -442,6 +468,29 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram updateState_;
 
+  /**
+   * Pending state updates of each priority, sampled as the update thread
+   * picks each batch
+   */
+  TLHistogram linkStateUpdateQueueDepth_;
+  TLHistogram neighborUpdateQueueDepth_;
+  TLHistogram routeUpdateQueueDepth_;
+  TLHistogram statsUpdateQueueDepth_;
+
+  /**
+   * Time state updates of each priority waited to be applied (in us)
+   */
+  TLHistogram linkStateUpdateWait_;
+  TLHistogram neighborUpdateWait_;
+  TLHistogram routeUpdateWait_;
+  TLHistogram statsUpdateWait_;
+
+  /**
+   * SwitchState node allocations, and their bytes, per batch of state updates
+   */
+  TLHistogram stateUpdateNodeAllocations_;
+  TLHistogram stateUpdateNodeAllocBytes_;
+
   /**
    * Histogram for time used for route update (in microsecond)
    */
@@ -13,8 +13,11 @@
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/FibUpdatePipeline.h"
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/IPv6Handler.h"
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/L2LearningEventStream.h"
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/LldpManager.h"
 #include "fboss/agent/NeighborUpdater.h"
@@ -39,6 +42,7 @@
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/InterfaceMap.h"
 #include "fboss/agent/state/LabelForwardingEntry.h"
+#include "fboss/agent/state/MacTable.h"
 #include "fboss/agent/state/NdpEntry.h"
 #include "fboss/agent/state/NdpTable.h"
 #include "fboss/agent/state/Port.h"
@@ -48,6 +52,7 @@
 #include "fboss/agent/state/RouteTableRib.h"
 #include "fboss/agent/state/RouteUpdater.h"
 #include "fboss/agent/state/StateUtils.h"
+#include "fboss/agent/state/SwitchSettings.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/state/VlanMap.h"
@@ -131,10 +136,15 @@ void dynamicFibUpdate(
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
     void* cookie) {
+  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
+  if (FLAGS_pipelined_fib_programming) {
+    sw->getFibUpdatePipeline()->fibUpdated(
+        vrf, v4NetworkToRoute, v6NetworkToRoute);
+    return;
+  }
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
       vrf, v4NetworkToRoute, v6NetworkToRoute);
 
-  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   // TODO - figure out transactions approach when we upgrade to RIB,
   // RIB will also need to reflect rollback status.
   sw->updateStateBlocking("", std::move(fibUpdater));
@@ -677,6 +687,9 @@ void ThriftHandler::deleteUnicastRoutesInVrf(
         &dynamicFibUpdate,
         static_cast<void*>(sw_));
 
+    if (FLAGS_pipelined_fib_programming) {
+      sw_->getFibUpdatePipeline()->checkChunkErrors();
+    }
     sw_->stats()->delRoutesV4(stats.v4RoutesDeleted);
     sw_->stats()->delRoutesV6(stats.v6RoutesDeleted);
 
@@ -769,6 +782,9 @@ void ThriftHandler::updateUnicastRoutesImpl(
         &dynamicFibUpdate,
         static_cast<void*>(sw_));
 
+    if (FLAGS_pipelined_fib_programming) {
+      sw_->getFibUpdatePipeline()->checkChunkErrors();
+    }
     sw_->stats()->addRoutesV4(stats.v4RoutesAdded);
     sw_->stats()->addRoutesV6(stats.v6RoutesAdded);
 
@@ -931,10 +947,37 @@ void ThriftHandler::getArpTable(std::vector<ArpEntryThrift>& arpTable) {
 void ThriftHandler::getL2Table(std::vector<L2EntryThrift>& l2Table) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  sw_->getHw()->fetchL2Table(&l2Table);
+  auto state = sw_->getState();
+  if (state->getSwitchSettings()->getL2LearningMode() ==
+      cfg::L2LearningMode::SOFTWARE) {
+    // With SOFTWARE learning every MAC learned is programmed from the MAC
+    // tables in the switch state, so serve those rather than walking the
+    // hardware L2 table. This leaves out MACs the hardware has learned but
+    // the agent has yet to program, which are only PENDING in hardware.
+    for (const auto& vlan : *state->getVlans()) {
+      for (const auto& macEntry : *vlan->getMacTable()) {
+        // Entries in the switch state have been programmed
+        l2Table.push_back(toL2EntryThrift(L2Entry(
+            macEntry->getMac(),
+            vlan->getID(),
+            macEntry->getPort(),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_VALIDATED,
+            macEntry->getClassID())));
+      }
+    }
+  } else {
+    sw_->getHw()->fetchL2Table(&l2Table);
+  }
   XLOG(DBG6) << "L2 Table size:" << l2Table.size();
 }
 
+apache::thrift::ServerStream<L2LearningEvent>
+ThriftHandler::subscribeL2LearningEvents() {
+  auto log = LOG_THRIFT_CALL(INFO);
+  ensureConfigured(__func__);
+  return sw_->getL2LearningEventStream()->subscribe();
+}
+
 void ThriftHandler::getAclTable(std::vector<AclEntryThrift>& aclTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
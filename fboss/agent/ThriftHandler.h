@@ -191,6 +191,8 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   void getRunningConfig(std::string& configStr) override;
   void getArpTable(std::vector<ArpEntryThrift>& arpTable) override;
   void getL2Table(std::vector<L2EntryThrift>& l2Table) override;
+  apache::thrift::ServerStream<L2LearningEvent> subscribeL2LearningEvents()
+      override;
   void getAclTable(std::vector<AclEntryThrift>& AclTable) override;
   void getAggregatePort(
       AggregatePortThrift& aggregatePortThrift,
@@ -16,15 +16,17 @@ extern "C" {
 #include <linux/if_link.h>
 #include <linux/if_tun.h>
 #include <linux/rtnetlink.h>
-#include <netlink/route/link.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 }
 
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Conv.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/EventHandler.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/ThreadId.h>
 #include "fboss/agent/NlError.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/SwSwitch.h"
@@ -32,6 +34,8 @@ extern "C" {
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/packet/EthHdr.h"
 
+using facebook::fb303::SUM;
+
 namespace facebook::fboss {
 
 namespace {
@@ -60,6 +64,13 @@ struct iplink_req {
 #define IN6_ADDR_GEN_MODE_NONE 1
 #endif
 
+std::string counterKey(
+    const std::string& intfName,
+    size_t queueIndex,
+    folly::StringPiece name) {
+  return folly::to<std::string>(intfName, ".queue", queueIndex, ".", name);
+}
+
 } // anonymous namespace
 
 TunIntf::TunIntf(
@@ -67,9 +78,9 @@ TunIntf::TunIntf(
     folly::EventBase* evb,
     InterfaceID ifID,
     int ifIndex,
-    int mtu)
-    : folly::EventHandler(evb),
-      sw_(sw),
+    int mtu,
+    const std::vector<folly::EventBase*>& queueEvbs)
+    : sw_(sw),
       name_(util::createTunIntfName(ifID)),
       ifID_(ifID),
       ifIndex_(ifIndex),
@@ -77,18 +88,15 @@ TunIntf::TunIntf(
   DCHECK(sw) << "NULL pointer to SwSwitch.";
   DCHECK(evb) << "NULL pointer to EventBase";
 
-  openFD();
-  SCOPE_FAIL {
-    closeFD();
-  };
+  createQueues(evb, queueEvbs);
 
   // XXX: Disabling mode on existing interface so that we end up removing
   // automatically allocated v6 link local address on next release. from
   // next release onwards we will not need it
   disableIPv6AddrGenMode(ifIndex_);
 
-  XLOG(INFO) << "Added interface " << name_ << " with fd " << fd_ << " @ index "
-             << ifIndex_ << ", "
+  XLOG(INFO) << "Added interface " << name_ << " with fd " << fd() << " ("
+             << queues_.size() << " queues) @ index " << ifIndex_ << ", "
              << "DOWN";
 }
 
@@ -98,9 +106,9 @@ TunIntf::TunIntf(
     InterfaceID ifID,
     bool status,
     const Interface::Addresses& addr,
-    int mtu)
-    : folly::EventHandler(evb),
-      sw_(sw),
+    int mtu,
+    const std::vector<folly::EventBase*>& queueEvbs)
+    : sw_(sw),
       name_(util::createTunIntfName(ifID)),
       ifID_(ifID),
       status_(status),
@@ -109,129 +117,163 @@ TunIntf::TunIntf(
   DCHECK(sw) << "NULL pointer to SwSwitch.";
   DCHECK(evb) << "NULL pointer to EventBase";
 
-  // Open Tun interface FD for socket-IO
-  openFD();
-  SCOPE_FAIL {
-    closeFD();
-  };
+  // Open Tun interface FDs for socket-IO
+  createQueues(evb, queueEvbs);
 
   // Make the Tun interface persistent, so that the network sessions from the
   // application (i.e. BGP)  will not be reset if controller restarts
-  auto ret = ioctl(fd_, TUNSETPERSIST, 1);
+  auto ret = ioctl(fd(), TUNSETPERSIST, 1);
   sysCheckError(ret, "Failed to set persist interface ", name_);
 
   // TODO: if needed, we can adjust send buffer size, TUNSETSNDBUF
-  auto sock = nl_socket_alloc();
-  if (!sock) {
-    throw SysError(errno, "failed to open libnl socket");
-  }
-  SCOPE_EXIT {
-    nl_socket_free(sock);
-  };
-
-  // Connect netlink socket.
-  ret = nl_connect(sock, NETLINK_ROUTE);
-  sysCheckError(ret, "failed to connect", nl_geterror(ret));
-  SCOPE_EXIT {
-    nl_close(sock);
-  };
 
-  // Allocate cache
-  nl_cache* cache = nullptr;
-  ret = rtnl_link_alloc_cache(sock, AF_UNSPEC, &cache);
-  sysCheckError(ret, "failed to get all links: error: ", nl_geterror(ret));
+  // Extract ifIndex. A single ioctl rather than dumping every link on the
+  // host for each interface created.
+  auto sock = socket(PF_INET, SOCK_DGRAM, 0);
+  sysCheckError(sock, "Failed to open socket");
   SCOPE_EXIT {
-    nl_cache_free(cache);
+    close(sock);
   };
-
-  // Extract ifIndex
-  ifIndex_ = rtnl_link_name2i(cache, name_.c_str());
+  struct ifreq ifr;
+  memset(&ifr, 0, sizeof(ifr));
+  size_t len = std::min(name_.size(), sizeof(ifr.ifr_name));
+  memmove(ifr.ifr_name, name_.c_str(), len);
+  ret = ioctl(sock, SIOCGIFINDEX, (void*)&ifr);
+  sysCheckError(ret, "Failed to get ifIndex of Tun interface ", name_);
+  ifIndex_ = ifr.ifr_ifindex;
   if (ifIndex_ <= 0) {
-    FbossError("Got invalid value ", ifIndex_, " for Tun interface ", name_);
+    throw FbossError(
+        "Got invalid value ", ifIndex_, " for Tun interface ", name_);
   }
 
   // Disable v6 link-local address assignment on Tun interface
   disableIPv6AddrGenMode(ifIndex_);
 
-  XLOG(INFO) << "Created interface " << name_ << " with fd " << fd_
-             << " @ index " << ifIndex_ << ", " << (status ? "UP" : "DOWN");
+  XLOG(INFO) << "Created interface " << name_ << " with fd " << fd() << " ("
+             << queues_.size() << " queues) @ index " << ifIndex_ << ", "
+             << (status ? "UP" : "DOWN");
 }
 
 TunIntf::~TunIntf() {
   stop();
 
   // We must have a valid fd to TunIntf
-  CHECK_NE(fd_, -1);
+  CHECK(!queues_.empty());
 
   // Delete interface if need be
   if (toDelete_) {
-    auto ret = ioctl(fd_, TUNSETPERSIST, 0);
+    auto ret = ioctl(fd(), TUNSETPERSIST, 0);
     sysLogError(ret, "Failed to unset persist interface ", name_);
   }
 
-  // Close FD. This will delete the interface if TUNSETPERSIST is not on
-  closeFD();
+  // Close FDs. This will delete the interface if TUNSETPERSIST is not on
+  queues_.clear();
   XLOG(INFO) << (toDelete_ ? "Delete" : "Detach") << " interface " << name_;
 }
 
 void TunIntf::stop() {
-  unregisterHandler();
+  for (auto& queue : queues_) {
+    queue->stop();
+  }
 }
 
 void TunIntf::start() {
-  if (fd_ != -1 && !isHandlerRegistered()) {
-    changeHandlerFD(folly::NetworkSocket::fromFd(fd_));
-    registerHandler(folly::EventHandler::READ | folly::EventHandler::PERSIST);
+  for (auto& queue : queues_) {
+    queue->start();
   }
 }
 
-void TunIntf::openFD() {
-  fd_ = open(kTunDev.c_str(), O_RDWR);
-  sysCheckError(fd_, "Cannot open ", kTunDev.c_str());
+void TunIntf::createQueues(
+    folly::EventBase* evb,
+    const std::vector<folly::EventBase*>& queueEvbs) {
+  bool multiQueue = !queueEvbs.empty();
+  auto fd = openFD(multiQueue);
+  if (fd == -1) {
+    // Persisted interfaces keep the queue mode they were created with, and
+    // the kernel does not allow mixing modes on one device.
+    auto existingMode = multiQueue ? "single" : "multi";
+    XLOG(WARN) << "Interface " << name_ << " exists in " << existingMode
+               << "-queue mode, attaching a single queue in "
+               << existingMode << "-queue mode";
+    fd = openFD(!multiQueue);
+    if (fd == -1) {
+      throw FbossError(
+          "Failed to attach to interface ",
+          name_,
+          " in either single or multi-queue mode");
+    }
+    multiQueue = false;
+  }
+  queues_.push_back(std::make_unique<Queue>(this, evb, fd, 0));
+
+  // Set configured MTU
+  setMtu(mtu_);
+
+  if (multiQueue) {
+    for (auto queueEvb : queueEvbs) {
+      queues_.push_back(std::make_unique<Queue>(
+          this, queueEvb, openFD(true), queues_.size()));
+    }
+  }
+}
+
+int TunIntf::openFD(bool multiQueue) {
+  auto fd = open(kTunDev.c_str(), O_RDWR);
+  sysCheckError(fd, "Cannot open ", kTunDev.c_str());
   SCOPE_FAIL {
-    closeFD();
+    closeFD(fd);
   };
 
   struct ifreq ifr;
   memset(&ifr, 0, sizeof(ifr));
-  // Flags: IFF_TUN   - TUN device (no Ethernet headers)
-  //        IFF_NO_PI - Do not provide packet information
+  // Flags: IFF_TUN         - TUN device (no Ethernet headers)
+  //        IFF_NO_PI       - Do not provide packet information
+  //        IFF_MULTI_QUEUE - Attach one more queue to the device
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (multiQueue) {
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
   bzero(ifr.ifr_name, sizeof(ifr.ifr_name));
   size_t len = std::min(name_.size(), sizeof(ifr.ifr_name));
   memmove(ifr.ifr_name, name_.c_str(), len);
-  auto ret = ioctl(fd_, TUNSETIFF, (void*)&ifr);
+  auto ret = ioctl(fd, TUNSETIFF, (void*)&ifr);
+  if (ret < 0 && errno == EINVAL && queues_.empty()) {
+    closeFD(fd);
+    return -1;
+  }
   sysCheckError(ret, "Failed to create/attach interface ", name_);
 
-  // Set configured MTU
-  setMtu(mtu_);
-
   // make fd non-blocking
-  auto flags = fcntl(fd_, F_GETFL);
-  sysCheckError(flags, "Failed to get flags from fd ", fd_);
+  auto flags = fcntl(fd, F_GETFL);
+  sysCheckError(flags, "Failed to get flags from fd ", fd);
   flags |= O_NONBLOCK;
-  ret = fcntl(fd_, F_SETFL, flags);
-  sysCheckError(
-      ret, "Failed to set non-blocking flags ", flags, " to fd ", fd_);
-  flags = fcntl(fd_, F_GETFD);
-  sysCheckError(flags, "Failed to get flags from fd ", fd_);
+  ret = fcntl(fd, F_SETFL, flags);
+  sysCheckError(ret, "Failed to set non-blocking flags ", flags, " to fd ", fd);
+  flags = fcntl(fd, F_GETFD);
+  sysCheckError(flags, "Failed to get flags from fd ", fd);
   flags |= FD_CLOEXEC;
-  ret = fcntl(fd_, F_SETFD, flags);
+  ret = fcntl(fd, F_SETFD, flags);
   sysCheckError(
-      ret, "Failed to set close-on-exec flags ", flags, " to fd ", fd_);
+      ret, "Failed to set close-on-exec flags ", flags, " to fd ", fd);
 
-  XLOG(INFO) << "Create/attach to tun interface " << name_ << " @ fd " << fd_;
+  XLOG(INFO) << "Create/attach to tun interface " << name_ << " @ fd " << fd;
+  return fd;
 }
 
-void TunIntf::closeFD() noexcept {
-  auto ret = close(fd_);
-  sysLogError(ret, "Failed to close fd ", fd_, " for interface ", name_);
+void TunIntf::closeFD(int fd) noexcept {
+  auto ret = close(fd);
+  sysLogError(ret, "Failed to close fd ", fd, " for interface ", name_);
   if (ret == 0) {
-    XLOG(INFO) << "Closed fd " << fd_ << " for interface " << name_;
-    fd_ = -1;
+    XLOG(INFO) << "Closed fd " << fd << " for interface " << name_;
   }
 }
 
+TunIntf::Queue* TunIntf::txQueue() const {
+  // Spread writers over the queues so concurrent senders do not all
+  // serialize on one fd.
+  return queues_[folly::getOSThreadID() % queues_.size()].get();
+}
+
 void TunIntf::addAddress(const folly::IPAddress& addr, uint8_t mask) {
   auto ret = addrs_.emplace(addr, mask);
   if (!ret.second) {
@@ -267,8 +309,8 @@ void TunIntf::setMtu(int mtu) {
       ret,
       "Failed to set MTU ",
       ifr.ifr_mtu,
-      " to fd ",
-      fd_,
+      " to interface ",
+      name_,
       " errno = ",
       errno);
   XLOG(DBG3) << "Set tun " << name_ << " MTU to " << mtu;
@@ -313,8 +355,67 @@ void TunIntf::disableIPv6AddrGenMode(int ifIndex) {
   return;
 }
 
-void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
-  CHECK(fd_ != -1);
+TunIntf::Queue::Queue(
+    TunIntf* intf,
+    folly::EventBase* evb,
+    int fd,
+    size_t index)
+    : folly::EventHandler(evb),
+      intf_(intf),
+      evb_(evb),
+      fd_(fd),
+      dedicatedEvb_(index > 0),
+      rxPkts_(
+          fb303::ThreadCachedServiceData::get()->getThreadStats(),
+          counterKey(intf->name_, index, "rx_pkts"),
+          SUM),
+      rxBytes_(
+          fb303::ThreadCachedServiceData::get()->getThreadStats(),
+          counterKey(intf->name_, index, "rx_bytes"),
+          SUM),
+      txPkts_(
+          fb303::ThreadCachedServiceData::get()->getThreadStats(),
+          counterKey(intf->name_, index, "tx_pkts"),
+          SUM),
+      txBytes_(
+          fb303::ThreadCachedServiceData::get()->getThreadStats(),
+          counterKey(intf->name_, index, "tx_bytes"),
+          SUM) {
+  DCHECK(evb) << "NULL pointer to EventBase";
+}
+
+TunIntf::Queue::~Queue() {
+  stop();
+  intf_->closeFD(fd_);
+}
+
+void TunIntf::Queue::start() {
+  auto registerFn = [this]() {
+    if (!isHandlerRegistered()) {
+      changeHandlerFD(folly::NetworkSocket::fromFd(fd_));
+      registerHandler(folly::EventHandler::READ | folly::EventHandler::PERSIST);
+    }
+  };
+  if (dedicatedEvb_) {
+    evb_->runImmediatelyOrRunInEventBaseThreadAndWait(registerFn);
+  } else {
+    registerFn();
+  }
+}
+
+void TunIntf::Queue::stop() {
+  // Queue 0 runs on the caller's (TunManager's) EventBase. Additional
+  // queues run on reader threads that outlive every TunIntf.
+  if (dedicatedEvb_) {
+    evb_->runImmediatelyOrRunInEventBaseThreadAndWait(
+        [this]() { unregisterHandler(); });
+  } else {
+    unregisterHandler();
+  }
+}
+
+void TunIntf::Queue::handlerReady(uint16_t /*events*/) noexcept {
+  auto sw = intf_->sw_;
 
   // Since this is L3 packet size, we should also reserve some space for L2
   // header, which is 18 bytes (including one vlan tag)
@@ -325,7 +426,7 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
   try {
     while (sent + dropped < kMaxSentOneTime) {
       std::unique_ptr<TxPacket> pkt;
-      pkt = sw_->allocateL3TxPacket(mtu_);
+      pkt = sw->allocateL3TxPacket(intf_->mtu_);
       auto buf = pkt->buf();
       int ret = 0;
       do {
@@ -353,7 +454,7 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
       } else {
         bytes += ret;
         buf->append(ret);
-        sw_->sendL3Packet(std::move(pkt), ifID_);
+        sw->sendL3Packet(std::move(pkt), intf_->ifID_);
         ++sent;
       }
     } // while
@@ -366,16 +467,41 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
     unregisterHandler();
   }
 
+  if (sent) {
+    rxPkts_.addValue(sent);
+    rxBytes_.addValue(bytes);
+  }
   XLOG(DBG4) << "Forwarded " << sent << " packets (" << bytes
-             << " bytes) from host @ fd " << fd_ << " for interface " << name_;
+             << " bytes) from host @ fd " << fd_ << " for interface "
+             << intf_->name_;
   if (dropped) {
     XLOG(DBG3) << "Dropped " << dropped << " packets from host @ fd " << fd_
-               << " for interface " << name_;
+               << " for interface " << intf_->name_;
   }
 }
 
+bool TunIntf::Queue::write(const folly::IOBuf* buf) {
+  int ret = 0;
+  do {
+    ret = ::write(fd_, buf->data(), buf->length());
+  } while (ret == -1 && errno == EINTR);
+  if (ret < 0) {
+    sysLogError(
+        ret, "Failed to send packet to host from Interface ", intf_->ifID_);
+    return false;
+  } else if (ret < buf->length()) {
+    XLOG(ERR) << "Failed to send full packet to host from Interface "
+              << intf_->ifID_ << ". " << ret << " bytes sent instead of "
+              << buf->length();
+    return false;
+  }
+  txPkts_.addValue(1);
+  txBytes_.addValue(ret);
+  return true;
+}
+
 bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
-  CHECK(fd_ != -1);
+  CHECK(!queues_.empty());
   const int l2Len = EthHdr::SIZE;
 
   auto buf = pkt->buf();
@@ -387,21 +513,12 @@ bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
   // skip L2 header
   buf->trimStart(l2Len);
 
-  int ret = 0;
-  do {
-    ret = write(fd_, buf->data(), buf->length());
-  } while (ret == -1 && errno == EINTR);
-  if (ret < 0) {
-    sysLogError(ret, "Failed to send packet to host from Interface ", ifID_);
-    return false;
-  } else if (ret < buf->length()) {
-    XLOG(ERR) << "Failed to send full packet to host from Interface " << ifID_
-              << ". " << ret << " bytes sent instead of " << buf->length();
+  if (!txQueue()->write(buf)) {
     return false;
   }
 
-  XLOG(DBG4) << "Send packet (" << ret << " bytes) to host from Interface "
-             << ifID_;
+  XLOG(DBG4) << "Send packet (" << buf->length()
+             << " bytes) to host from Interface " << ifID_;
   return true;
 }
 
@@ -9,31 +9,40 @@
  */
 #pragma once
 
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/io/IOBuf.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/EventHandler.h>
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/types.h"
 
+#include <atomic>
+#include <vector>
+
 namespace facebook::fboss {
 
 class SwSwitch;
 class RxPacket;
 
-class TunIntf : private folly::EventHandler {
+class TunIntf {
  public:
   /**
    * Creates a TunIntf object of already existing linux interface. Initial
    * status is set to `false` for discovered interfaces because we do not
    * have real port-status info. Once initial config is applied in TunManager
    * their actual status will be reflected.
+   *
+   * The first queue is served by `evb`. Each EventBase in `queueEvbs` serves
+   * one additional IFF_MULTI_QUEUE queue of the same interface.
    */
   TunIntf(
       SwSwitch* sw,
       folly::EventBase* evb,
       InterfaceID ifID,
       int ifIndex /* linux */,
-      int mtu);
+      int mtu,
+      const std::vector<folly::EventBase*>& queueEvbs = {});
 
   /**
    * This version of constructor creates a Tun interface in Linux as well.
@@ -44,9 +53,10 @@ class TunIntf : private folly::EventHandler {
       InterfaceID ifID, // Switch interface ID
       bool status,
       const Interface::Addresses& addrs,
-      int mtu);
+      int mtu,
+      const std::vector<folly::EventBase*>& queueEvbs = {});
 
-  ~TunIntf() override;
+  ~TunIntf();
 
   /**
    * Start/Stop packet forwarding on Tun interface.
@@ -123,19 +133,76 @@ class TunIntf : private folly::EventHandler {
     return status_;
   }
 
+  /**
+   * Number of queues (fds) attached to the interface on host. This is 1
+   * unless the interface was opened with IFF_MULTI_QUEUE.
+   */
+  size_t getNumQueues() const {
+    return queues_.size();
+  }
+
  private:
   /**
-   * Callback for event on Tun interface's read socket-fd
-   * Override's folly::EventHandler handlerReady callback.
+   * One fd attached to the Tun interface, served by its own EventBase.
+   * Packets from host are read on that EventBase; packets to host may be
+   * written on any queue from any thread.
    */
-  void handlerReady(uint16_t events) noexcept override;
+  class Queue : private folly::EventHandler {
+   public:
+    Queue(TunIntf* intf, folly::EventBase* evb, int fd, size_t index);
+    ~Queue() override;
+
+    void start();
+    void stop();
+    bool write(const folly::IOBuf* buf);
+
+    int getFD() const {
+      return fd_;
+    }
+
+   private:
+    /**
+     * Callback for event on this queue's fd
+     * Override's folly::EventHandler handlerReady callback.
+     */
+    void handlerReady(uint16_t events) noexcept override;
+
+    TunIntf* const intf_;
+    folly::EventBase* const evb_;
+    const int fd_;
+    const bool dedicatedEvb_;
+    // Cached stat handles, as these are updated for every packet
+    fb303::ThreadCachedServiceData::TLTimeseries rxPkts_;
+    fb303::ThreadCachedServiceData::TLTimeseries rxBytes_;
+    fb303::ThreadCachedServiceData::TLTimeseries txPkts_;
+    fb303::ThreadCachedServiceData::TLTimeseries txBytes_;
+  };
 
   /**
-   * Open/Close a new socket-fd to read/write data from Tun interface.
-   * fd_ is mutated.
+   * Open/Close a socket-fd to read/write data from Tun interface. With
+   * `multiQueue` every fd opened attaches one more queue to the interface.
+   * Returns -1 if the first open is refused because the interface already
+   * exists in the other queue mode.
    */
-  void openFD();
-  void closeFD() noexcept;
+  int openFD(bool multiQueue);
+  void closeFD(int fd) noexcept;
+
+  /**
+   * Open queue 0 on `evb` and one more queue per EventBase in `queueEvbs`.
+   * queues_ is mutated.
+   */
+  void createQueues(
+      folly::EventBase* evb,
+      const std::vector<folly::EventBase*>& queueEvbs);
+
+  /**
+   * The queue used for packets sent to host from the calling thread.
+   */
+  Queue* txQueue() const;
+
+  int fd() const {
+    return queues_.front()->getFD();
+  }
 
   /**
    * In newer kernel an interface is automatically gets link-local IPv6 address
@@ -158,11 +225,13 @@ class TunIntf : private folly::EventHandler {
   Interface::Addresses addrs_; // The IP addresses assigned to this intf
 
   /**
-   * File descriptor for this interface through which packets can
-   * be received from or sent to.
+   * Queues (file descriptors) for this interface through which packets can
+   * be received from or sent to. Queue 0 always exists and is served by the
+   * TunManager's EventBase.
    */
-  int fd_{-1};
-  int mtu_{-1};
+  std::vector<std::unique_ptr<Queue>> queues_;
+  // Read by queue readers on their own threads
+  std::atomic<int> mtu_{-1};
 };
 
 } // namespace facebook::fboss
@@ -11,6 +11,7 @@
 
 extern "C" {
 #include <linux/if.h>
+#include <netlink/netlink.h>
 #include <netlink/route/addr.h>
 #include <netlink/route/link.h>
 #include <netlink/route/route.h>
@@ -18,6 +19,7 @@ extern "C" {
 #include <sys/ioctl.h>
 }
 
+#include <folly/Conv.h>
 #include <folly/MapUtil.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/lang/CString.h>
@@ -31,11 +33,25 @@ extern "C" {
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <fb303/ThreadCachedServiceData.h>
 #include <boost/container/flat_set.hpp>
 
+#include <optional>
+
+DEFINE_int32(
+    tun_intf_num_queues,
+    1,
+    "Number of IFF_MULTI_QUEUE queues per TUN interface, each read on its "
+    "own thread. Interfaces persisted as single queue keep one queue.");
+
 namespace {
 const int kDefaultMtu = 1500;
-}
+
+// Bound on requests in flight, so their acks fit the socket receive buffer
+const size_t kMaxNetlinkBatch = 256;
+
+const std::string kSyncDurationCounter = "tun_manager.sync_duration_ms";
+} // namespace
 
 namespace facebook::fboss {
 
@@ -52,6 +68,14 @@ TunManager::TunManager(SwSwitch* sw, EventBase* evb) : sw_(sw), evb_(evb) {
   }
   auto error = nl_connect(sock_, NETLINK_ROUTE);
   nlCheckError(error, "failed to connect netlink socket to NETLINK_ROUTE");
+
+  // Queue 0 of every interface is served by evb_, the rest by reader threads
+  // shared across interfaces.
+  for (auto i = 1; i < FLAGS_tun_intf_num_queues; ++i) {
+    queueThreads_.push_back(std::make_unique<folly::ScopedEventBaseThread>(
+        folly::to<std::string>("TunQueue", i)));
+    queueEvbs_.push_back(queueThreads_.back()->getEventBase());
+  }
 }
 
 TunManager::~TunManager() {
@@ -60,6 +84,9 @@ TunManager::~TunManager() {
   }
 
   stop();
+  for (auto& request : netlinkBatch_) {
+    nlmsg_free(request.msg);
+  }
   nl_close(sock_);
   nl_socket_free(sock_);
 }
@@ -109,7 +136,8 @@ void TunManager::addExistingIntf(const std::string& ifName, int ifIndex) {
     intfs_.erase(ret.first);
   };
   ret.first->second.reset(
-      new TunIntf(sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID)));
+      new TunIntf(
+          sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID), queueEvbs_));
 }
 
 void TunManager::addNewIntf(
@@ -125,7 +153,7 @@ void TunManager::addNewIntf(
     intfs_.erase(ret.first);
   };
   auto intf = std::make_unique<TunIntf>(
-      sw_, evb_, ifID, isUp, addrs, getInterfaceMtu(ifID));
+      sw_, evb_, ifID, isUp, addrs, getInterfaceMtu(ifID), queueEvbs_);
 
   SCOPE_FAIL {
     intf->setDelete();
@@ -163,6 +191,8 @@ void TunManager::removeIntf(InterfaceID ifID) {
 
   // Remove the route table and associated rule
   removeRouteTable(ifID, intf->getIfIndex());
+  // Deleting the interface purges its routes, so apply the removals first
+  flushNetlinkBatch();
   intf->setDelete();
   intfs_.erase(iter);
 }
@@ -305,28 +335,31 @@ void TunManager::addRemoveRouteTable(InterfaceID ifID, int ifIndex, bool add) {
     rtnl_route_nh_set_ifindex(nexthop, ifIndex);
     rtnl_route_add_nexthop(route, nexthop);
 
+    struct nl_msg* msg = nullptr;
     if (add) {
-      error = rtnl_route_add(sock_, route, NLM_F_REPLACE);
+      error = rtnl_route_build_add_request(route, NLM_F_REPLACE, &msg);
     } else {
-      error = rtnl_route_delete(sock_, route, 0);
+      error = rtnl_route_build_del_request(route, 0, &msg);
     }
+    nlCheckError(error, "Failed to build route request for ", addr);
     /**
-     * Disable: Because of some weird reason this CHECK fails while deleting
-     * v4 default route. However route actually gets wiped off from Linux
+     * Not mustSucceed: Because of some weird reason deleting the v4 default
+     * route reports failure. However route actually gets wiped off from Linux
      * routing table.
-    nlCheckError(error, "Failed to ", add ? "add" : "remove",
-                  " default route ", addr, " @ index ", ifIndex,
-                  " in table ", getTableId(ifID), " for interface ", ifID,
-                  ". ErrorCode: ", error);
-      */
-    if (error < 0) {
-      XLOG(WARNING) << "Failed to " << (add ? "add" : "remove")
-                    << " default route " << addr << " @index " << ifIndex
-                    << ". ErrorCode: " << error;
-    }
-    XLOG(INFO) << (add ? "Added" : "Removed") << " default route " << addr
-               << " @ index " << ifIndex << " in table " << getTableId(ifID)
-               << " for interface " << ifID;
+     */
+    queueNetlinkRequest(
+        msg,
+        folly::to<std::string>(
+            add ? "add" : "remove",
+            " default route ",
+            addr.str(),
+            " @ index ",
+            ifIndex,
+            " in table ",
+            getTableId(ifID),
+            " for interface ",
+            ifID),
+        false /* mustSucceed */);
   }
 }
 
@@ -366,24 +399,24 @@ void TunManager::addRemoveSourceRouteRule(
   auto error = rtnl_rule_set_src(rule, sourceaddr);
   nlCheckError(error, "Failed to set destination route to ", addr);
 
+  struct nl_msg* msg = nullptr;
   if (add) {
-    error = rtnl_rule_add(sock_, rule, NLM_F_REPLACE);
+    error = rtnl_rule_build_add_request(rule, NLM_F_REPLACE, &msg);
   } else {
-    error = rtnl_rule_delete(sock_, rule, 0);
-  }
-  nlCheckError(
-      error,
-      "Failed to ",
-      add ? "add" : "remove",
-      " rule for address ",
-      addr,
-      " to lookup table ",
-      getTableId(ifID),
-      " for interface ",
-      ifID);
-  XLOG(INFO) << (add ? "Added" : "Removed") << " rule for address " << addr
-             << " to lookup table " << getTableId(ifID) << " for interface "
-             << ifID;
+    error = rtnl_rule_build_delete_request(rule, 0, &msg);
+  }
+  nlCheckError(error, "Failed to build rule request for ", addr);
+  queueNetlinkRequest(
+      msg,
+      folly::to<std::string>(
+          add ? "add" : "remove",
+          " rule for address ",
+          addr.str(),
+          " to lookup table ",
+          getTableId(ifID),
+          " for interface ",
+          ifID),
+      true /* mustSucceed */);
 }
 
 void TunManager::addRemoveTunAddress(
@@ -418,6 +451,7 @@ void TunManager::addRemoveTunAddress(
   rtnl_addr_set_prefixlen(tunaddr, mask);
   rtnl_addr_set_ifindex(tunaddr, ifIndex);
 
+  struct nl_msg* msg = nullptr;
   if (add) {
     /**
      * When you bring down interface some routes are purged but some still stay
@@ -426,25 +460,128 @@ void TunManager::addRemoveTunAddress(
      * addresses and routes for that interface with REPLACE flag overriding
      * existing ones if any.
      */
-    error = rtnl_addr_add(sock_, tunaddr, NLM_F_REPLACE);
+    error = rtnl_addr_build_add_request(tunaddr, NLM_F_REPLACE, &msg);
   } else {
-    error = rtnl_addr_delete(sock_, tunaddr, 0);
-  }
-  nlCheckError(
-      error,
-      "Failed to ",
-      add ? "add" : "remove",
-      " address ",
-      addr,
-      "/",
-      static_cast<int>(mask),
-      " to interface ",
-      ifName,
-      " @ index ",
-      ifIndex);
-  XLOG(INFO) << (add ? "Added" : "Removed") << " address " << addr.str() << "/"
-             << static_cast<int>(mask) << " on interface " << ifName
-             << " @ index " << ifIndex;
+    error = rtnl_addr_build_delete_request(tunaddr, 0, &msg);
+  }
+  nlCheckError(error, "Failed to build address request for ", addr);
+  queueNetlinkRequest(
+      msg,
+      folly::to<std::string>(
+          add ? "add" : "remove",
+          " address ",
+          addr.str(),
+          "/",
+          static_cast<int>(mask),
+          " on interface ",
+          ifName,
+          " @ index ",
+          ifIndex),
+      true /* mustSucceed */);
+}
+
+void TunManager::queueNetlinkRequest(
+    struct nl_msg* msg,
+    std::string description,
+    bool mustSucceed) {
+  netlinkBatch_.push_back(
+      NetlinkRequest{msg, std::move(description), mustSucceed});
+  if (netlinkBatch_.size() >= kMaxNetlinkBatch) {
+    flushNetlinkBatch();
+  }
+}
+
+void TunManager::flushNetlinkBatch() {
+  if (netlinkBatch_.empty()) {
+    return;
+  }
+  auto batch = std::move(netlinkBatch_);
+  netlinkBatch_.clear();
+  SCOPE_EXIT {
+    for (auto& request : batch) {
+      nlmsg_free(request.msg);
+    }
+  };
+
+  // Send every request without waiting for its ack. The kernel handles
+  // rtnetlink requests in order, so dependent requests stay ordered.
+  struct AckContext {
+    std::vector<NetlinkRequest>* batch;
+    uint32_t firstSeq;
+    size_t acked;
+  } ctx{&batch, 0, 0};
+  size_t sent = 0;
+  for (; sent < batch.size(); ++sent) {
+    auto error = nl_send_auto(sock_, batch[sent].msg);
+    if (error < 0) {
+      // Neither this request nor the ones behind it reached the kernel
+      for (auto i = sent; i < batch.size(); ++i) {
+        batch[i].error = error;
+      }
+      break;
+    }
+    if (sent == 0) {
+      ctx.firstSeq = nlmsg_hdr(batch[sent].msg)->nlmsg_seq;
+    }
+  }
+
+  // Collect all acks in one pass. A successful request is acked with a zero
+  // NLMSG_ERROR, a failed one with the negated errno.
+  auto cb = nl_cb_clone(nl_socket_get_cb(sock_));
+  if (!cb) {
+    throw FbossError("Failed to allocate netlink callbacks");
+  }
+  SCOPE_EXIT {
+    nl_cb_put(cb);
+  };
+  nl_cb_set(
+      cb,
+      NL_CB_ACK,
+      NL_CB_CUSTOM,
+      [](struct nl_msg* /* msg */, void* arg) {
+        ++static_cast<AckContext*>(arg)->acked;
+        return static_cast<int>(NL_OK);
+      },
+      &ctx);
+  nl_cb_err(
+      cb,
+      NL_CB_CUSTOM,
+      [](struct sockaddr_nl* /* nla */, struct nlmsgerr* err, void* arg) {
+        auto ackCtx = static_cast<AckContext*>(arg);
+        ++ackCtx->acked;
+        // Sequence numbers are consecutive across the batch. Store libnl's
+        // own (negative) error code so nl_geterror() can describe it.
+        auto index = err->msg.nlmsg_seq - ackCtx->firstSeq;
+        if (index < ackCtx->batch->size()) {
+          (*ackCtx->batch)[index].error = -nl_syserr2nlerr(err->error);
+        }
+        return static_cast<int>(NL_OK);
+      },
+      &ctx);
+  while (ctx.acked < sent) {
+    auto error = nl_recvmsgs(sock_, cb);
+    nlCheckError(error, "Failed to receive netlink acks");
+  }
+
+  std::optional<NlError> firstFailure;
+  for (const auto& request : batch) {
+    if (request.error == 0) {
+      XLOG(INFO) << "Applied netlink request to " << request.description;
+    } else if (request.mustSucceed) {
+      XLOG(ERR) << "Failed to " << request.description << ": "
+                << nl_geterror(request.error);
+      if (!firstFailure) {
+        firstFailure.emplace(
+            request.error, "Failed to ", request.description);
+      }
+    } else {
+      XLOG(WARNING) << "Failed to " << request.description
+                    << ". ErrorCode: " << request.error;
+    }
+  }
+  if (firstFailure) {
+    throw *firstFailure;
+  }
 }
 
 void TunManager::addTunAddress(
@@ -638,6 +775,13 @@ void TunManager::forceInitialSync() {
 
 void TunManager::sync(std::shared_ptr<SwitchState> state) {
   CHECK(evb_->isInEventBaseThread());
+  const auto startTs = std::chrono::steady_clock::now();
+  SCOPE_EXIT {
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTs);
+    tcData().setCounter(kSyncDurationCounter, elapsedMs.count());
+    XLOG(DBG2) << "TunManager sync took " << elapsedMs.count() << "ms.";
+  };
   using Addresses = Interface::Addresses;
   using ConstAddressesIter = Addresses::const_iterator;
   using IntfInfo = std::pair<bool /* status */, Addresses>;
@@ -667,6 +811,16 @@ void TunManager::sync(std::shared_ptr<SwitchState> state) {
   if (!probeDone_) {
     doProbe(lock);
   }
+  SCOPE_FAIL {
+    // Changes decided before the failure are still applied, as they would
+    // have been when every request was sent synchronously.
+    try {
+      flushNetlinkBatch();
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Failed to flush netlink requests: "
+                << folly::exceptionStr(ex);
+    }
+  };
 
   // prepare old addresses
   IntfToAddrsMap oldIntfToInfo;
@@ -760,6 +914,7 @@ void TunManager::sync(std::shared_ptr<SwitchState> state) {
       },
       [&](ConstIntfToAddrsMapIter& oldIter) { removeIntf(oldIter->first); });
 
+  flushNetlinkBatch();
   start();
 
   // track number of times sync is called
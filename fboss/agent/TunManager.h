@@ -10,6 +10,7 @@
 #pragma once
 
 #include <folly/io/async/EventBase.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/types.h"
@@ -17,6 +18,7 @@
 #include <boost/container/flat_map.hpp>
 
 extern "C" {
+#include <netlink/msg.h>
 #include <netlink/object.h>
 #include <netlink/socket.h>
 }
@@ -170,6 +172,23 @@ class TunManager : public StateObserver {
       folly::IPAddress addr,
       uint8_t mask);
 
+  /**
+   * Route, rule and address changes made during sync() are not sent one
+   * blocking round trip at a time. They are queued as netlink messages, and
+   * flushNetlinkBatch() sends the queue back to back on sock_ and then
+   * collects all the acks in one pass. The batch is flushed at the end of
+   * sync(), before an interface is deleted from the host, and whenever it
+   * grows to kMaxNetlinkBatch so acks cannot overrun the socket buffer.
+   *
+   * A failed request whose `mustSucceed` is set makes the flush throw, after
+   * the rest of the batch has been acked.
+   */
+  void queueNetlinkRequest(
+      struct nl_msg* msg,
+      std::string description,
+      bool mustSucceed);
+  void flushNetlinkBatch();
+
   /**
    * Netlink callback for processing and storing links
    */
@@ -218,6 +237,11 @@ class TunManager : public StateObserver {
   SwSwitch* sw_{nullptr};
   folly::EventBase* evb_{nullptr};
 
+  // Reader threads for the additional queues of multi-queue interfaces.
+  // Declared before intfs_ so they outlive every TunIntf.
+  std::vector<std::unique_ptr<folly::ScopedEventBaseThread>> queueThreads_;
+  std::vector<folly::EventBase*> queueEvbs_;
+
   // Netlink socket for managing interface/addresses in Host/Linux
   nl_sock* sock_{nullptr};
 
@@ -238,6 +262,14 @@ class TunManager : public StateObserver {
 
   uint64_t numSyncs_{0};
 
+  struct NetlinkRequest {
+    struct nl_msg* msg{nullptr};
+    std::string description;
+    bool mustSucceed{true};
+    int error{0};
+  };
+  std::vector<NetlinkRequest> netlinkBatch_;
+
   enum : uint8_t {
     /**
      * The protocol value used to add the source routing IP rule and the
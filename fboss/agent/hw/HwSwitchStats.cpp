@@ -75,5 +75,29 @@ HwSwitchStats::HwSwitchStats(
           map,
           SwitchStats::kCounterPrefix + vendor + ".asic.error",
           SUM,
-          RATE) {}
+          RATE),
+      linkStateEventQueueDepth_(
+          map,
+          SwitchStats::kCounterPrefix + vendor + ".linkstate.queue_depth",
+          10,
+          0,
+          1000),
+      linkStateEventDrainUsecs_(
+          map,
+          SwitchStats::kCounterPrefix + vendor + ".linkstate.drain_us",
+          1000,
+          0,
+          100000),
+      fdbEventQueueDepth_(
+          map,
+          SwitchStats::kCounterPrefix + vendor + ".fdb_event.queue_depth",
+          100,
+          0,
+          10000),
+      fdbEventDrainUsecs_(
+          map,
+          SwitchStats::kCounterPrefix + vendor + ".fdb_event.drain_us",
+          1000,
+          0,
+          100000) {}
 } // namespace facebook::fboss
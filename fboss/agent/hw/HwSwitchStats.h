@@ -57,6 +57,17 @@ class HwSwitchStats {
     asicErrors_.addValue(1);
   }
 
+  // Number of notifications handled by one bottom half drain and the time
+  // from the oldest of them being queued to the drain completing.
+  void linkStateEventsDrained(uint64_t queueDepth, uint64_t drainUsecs) {
+    linkStateEventQueueDepth_.addValue(queueDepth);
+    linkStateEventDrainUsecs_.addValue(drainUsecs);
+  }
+  void fdbEventsDrained(uint64_t queueDepth, uint64_t drainUsecs) {
+    fdbEventQueueDepth_.addValue(queueDepth);
+    fdbEventDrainUsecs_.addValue(drainUsecs);
+  }
+
   int64_t getTxPktAllocCount() {
     return txPktAlloc_.count();
   }
@@ -114,6 +125,12 @@ class HwSwitchStats {
 
   // Other ASIC errors
   TLTimeseries asicErrors_;
+
+  // Link state and FDB notification queues
+  TLHistogram linkStateEventQueueDepth_;
+  TLHistogram linkStateEventDrainUsecs_;
+  TLHistogram fdbEventQueueDepth_;
+  TLHistogram fdbEventDrainUsecs_;
 };
 
 } // namespace facebook::fboss
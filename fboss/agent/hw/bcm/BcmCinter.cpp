@@ -223,6 +223,10 @@ string BcmCinter::getNextTmpReasonsVar() {
   return to<string>("tmpReasons_", ++tmpReasonsCreated_);
 }
 
+string BcmCinter::getNextTmpPktArrayVar() {
+  return to<string>("tmpPktArray_", ++tmpPktArrayCreated_);
+}
+
 string BcmCinter::getNextFieldEntryVar() {
   return to<string>("fieldEntry_", ++fieldEntryCreated_);
 }
@@ -1854,10 +1858,7 @@ int BcmCinter::bcm_pkt_alloc(
   return 0;
 }
 
-int BcmCinter::bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* /*cookie*/) {
-  if (!FLAGS_gen_tx_cint) {
-    return 0;
-  }
+vector<string> BcmCinter::cintForTxPkt(int unit, const bcm_pkt_t* tx_pkt) {
   vector<string> cint{};
   string pbmpVar, ubmpVar;
   vector<string> pbmpCint, ubmpCint;
@@ -1889,6 +1890,14 @@ int BcmCinter::bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* /*cookie*/) {
     cint.push_back(to<string>(
         "pkt->pkt_data->data[", i, "] = ", tx_pkt->pkt_data->data[i]));
   }
+  return cint;
+}
+
+int BcmCinter::bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* /*cookie*/) {
+  if (!FLAGS_gen_tx_cint) {
+    return 0;
+  }
+  auto cint = cintForTxPkt(unit, tx_pkt);
 
   auto txFuncCint =
       wrapFunc(to<string>("bcm_tx(", makeParamStr(unit, "pkt", "NULL"), ")"));
@@ -1907,6 +1916,52 @@ int BcmCinter::bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* /*cookie*/) {
   return 0;
 }
 
+int BcmCinter::bcm_tx_array(
+    int unit,
+    bcm_pkt_t** pkt,
+    int count,
+    bcm_pkt_cb_f /*all_done_cb*/,
+    void* /*cookie*/) {
+  if (!FLAGS_gen_tx_cint) {
+    return 0;
+  }
+  auto pktArrayVar = getNextTmpPktArrayVar();
+  vector<string> cint = {
+      to<string>("bcm_pkt_t *", pktArrayVar, "[", count, "]")};
+  for (int i = 0; i < count; i++) {
+    auto pktCint = cintForTxPkt(unit, pkt[i]);
+    cint.insert(
+        cint.end(),
+        make_move_iterator(pktCint.begin()),
+        make_move_iterator(pktCint.end()));
+    cint.push_back(to<string>(pktArrayVar, "[", i, "] = pkt"));
+  }
+
+  // Without a callback the replayed array is sent synchronously, so the
+  // packets can be freed right after
+  auto txFuncCint = wrapFunc(to<string>(
+      "bcm_tx_array(",
+      makeParamStr(unit, pktArrayVar, count, "NULL", "NULL"),
+      ")"));
+  cint.insert(
+      cint.end(),
+      make_move_iterator(txFuncCint.begin()),
+      make_move_iterator(txFuncCint.end()));
+
+  for (int i = 0; i < count; i++) {
+    auto freeFuncCint = wrapFunc(to<string>(
+        "bcm_pkt_free(",
+        makeParamStr(unit, to<string>(pktArrayVar, "[", i, "]")),
+        ")"));
+    cint.insert(
+        cint.end(),
+        make_move_iterator(freeFuncCint.begin()),
+        make_move_iterator(freeFuncCint.end()));
+  }
+  writeCintLines(std::move(cint));
+  return 0;
+}
+
 int BcmCinter::bcm_pkt_free(int /*unit*/, bcm_pkt_t* /*pkt*/) {
   return 0;
 }
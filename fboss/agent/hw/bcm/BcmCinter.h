@@ -543,6 +543,12 @@ class BcmCinter : public BcmSdkInterface, public BcmInterface {
   int bcm_vlan_port_remove(int unit, bcm_vlan_t vid, bcm_pbmp_t pbmp) override;
   int bcm_l2_station_delete(int unit, int station_id) override;
   int bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* cookie) override;
+  int bcm_tx_array(
+      int unit,
+      bcm_pkt_t** pkt,
+      int count,
+      bcm_pkt_cb_f all_done_cb,
+      void* cookie) override;
   int bcm_port_stat_enable_set(int unit, bcm_gport_t port, int enable) override;
   int bcm_stat_clear(int unit, bcm_port_t port) override;
   int bcm_port_speed_set(int unit, bcm_port_t port, int speed) override;
@@ -1543,6 +1549,7 @@ class BcmCinter : public BcmSdkInterface, public BcmInterface {
   std::string getNextTmpTrunkMemberArray();
   std::string getNextTmpPortBitmapVar();
   std::string getNextTmpReasonsVar();
+  std::string getNextTmpPktArrayVar();
   std::string getNextFieldEntryVar();
   std::string getNextQosMapVar();
   std::string getNextL3IntfIdVar();
@@ -1631,6 +1638,11 @@ class BcmCinter : public BcmSdkInterface, public BcmInterface {
   std::pair<std::string, std::vector<std::string>> cintForReasons(
       bcm_rx_reasons_t reasons);
 
+  /*
+   * Allocate pkt and fill it in with the bitmaps and data of tx_pkt
+   */
+  std::vector<std::string> cintForTxPkt(int unit, const bcm_pkt_t* tx_pkt);
+
   std::vector<std::string> cintForL2Station(bcm_l2_station_t* station);
 
   std::vector<std::string> cintForCosqBstProfile(
@@ -1649,6 +1661,7 @@ class BcmCinter : public BcmSdkInterface, public BcmInterface {
   std::atomic<uint> tmpTrunkMemberArrayCreated_{0};
   std::atomic<uint> tmpPortBitmapCreated_{0};
   std::atomic<uint> tmpReasonsCreated_{0};
+  std::atomic<uint> tmpPktArrayCreated_{0};
   std::atomic<uint> fieldEntryCreated_{0};
   std::atomic<uint> qosMapCreated_{0};
   std::atomic<uint> l3IntfCreated_{0};
@@ -11,11 +11,13 @@
 
 #include <boost/cast.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <array>
 #include <fstream>
 #include <map>
 #include <optional>
 #include <utility>
 
+#include <fb303/ServiceData.h>
 #include <folly/Conv.h>
 #include <folly/FileUtil.h>
 #include <folly/Memory.h>
@@ -212,6 +214,126 @@ bool bothStandAloneRibOrRouteTableRibUsed(
   return routeTableModified(delta) && fibModified(delta);
 }
 
+/*
+ * Stages of BcmSwitch::stateChangedImpl(). Each is timed into its own fb303
+ * histogram, so a slow update can be attributed to e.g. route, neighbor or
+ * ACL programming.
+ */
+enum class StateChangeStage : uint8_t {
+  PORT_GROUPS,
+  DISABLED_PORTS,
+  SWITCH_SETTINGS,
+  MAC_TABLE,
+  LOAD_BALANCERS,
+  REMOVED_ROUTES,
+  REMOVED_NEIGHBORS,
+  REMOVED_INTFS_AND_CHANGED_VLANS,
+  CHANGED_INTFS_AND_REMOVED_VLANS,
+  QOS,
+  CONTROL_PLANE,
+  AGGREGATE_PORTS,
+  ADDED_CHANGED_NEIGHBORS,
+  LABEL_FIB,
+  MIRRORS,
+  ACLS,
+  SFLOW,
+  ADDED_CHANGED_ROUTES,
+  PORTS,
+  REMOVED_MIRRORS,
+  LINK_STATUS,
+  ENABLED_PORTS,
+  STATS_REFRESH,
+  TOTAL,
+  NUM_STAGES,
+};
+
+constexpr std::array<
+    folly::StringPiece,
+    static_cast<size_t>(StateChangeStage::NUM_STAGES)>
+    kStateChangeHistograms = {
+        "bcm.state_changed.port_groups.us",
+        "bcm.state_changed.disabled_ports.us",
+        "bcm.state_changed.switch_settings.us",
+        "bcm.state_changed.mac_table.us",
+        "bcm.state_changed.load_balancers.us",
+        "bcm.state_changed.removed_routes.us",
+        "bcm.state_changed.removed_neighbors.us",
+        "bcm.state_changed.removed_intfs_and_changed_vlans.us",
+        "bcm.state_changed.changed_intfs_and_removed_vlans.us",
+        "bcm.state_changed.qos.us",
+        "bcm.state_changed.control_plane.us",
+        "bcm.state_changed.aggregate_ports.us",
+        "bcm.state_changed.added_changed_neighbors.us",
+        "bcm.state_changed.label_fib.us",
+        "bcm.state_changed.mirrors.us",
+        "bcm.state_changed.acls.us",
+        "bcm.state_changed.sflow.us",
+        "bcm.state_changed.added_changed_routes.us",
+        "bcm.state_changed.ports.us",
+        "bcm.state_changed.removed_mirrors.us",
+        "bcm.state_changed.link_status.us",
+        "bcm.state_changed.enabled_ports.us",
+        "bcm.state_changed.stats_refresh.us",
+        "bcm.state_changed.total.us",
+};
+
+class StateChangeHistograms {
+ public:
+  static StateChangeHistograms& get() {
+    static StateChangeHistograms histograms;
+    return histograms;
+  }
+
+  void addValue(StateChangeStage stage, std::chrono::microseconds duration) {
+    auto& histogram = histograms_[static_cast<size_t>(stage)];
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+    auto guard = histogram.makeLockGuard();
+    histogram.addValueLocked(guard, now.count(), duration.count());
+  }
+
+ private:
+  StateChangeHistograms() {
+    auto histMap = facebook::fb303::fbData->getHistogramMap();
+    // Most stages take well under a millisecond, so they get 100us buckets
+    // up to 100ms. Whole updates, e.g. applying a new config, get 1ms
+    // buckets up to 1s. Anything slower lands in the overflow bucket.
+    facebook::fb303::ExportedHistogram stagePrototype(100, 0, 100000);
+    facebook::fb303::ExportedHistogram totalPrototype(1000, 0, 1000000);
+    for (size_t i = 0; i < kStateChangeHistograms.size(); ++i) {
+      auto prototype = i == static_cast<size_t>(StateChangeStage::TOTAL)
+          ? &totalPrototype
+          : &stagePrototype;
+      histograms_[i] = histMap->getOrCreateLockableHistogram(
+          kStateChangeHistograms[i], prototype);
+      histMap->exportPercentile(kStateChangeHistograms[i], 50);
+      histMap->exportPercentile(kStateChangeHistograms[i], 99);
+    }
+  }
+
+  std::array<
+      facebook::fb303::ExportedHistogramMapImpl::LockableHistogram,
+      static_cast<size_t>(StateChangeStage::NUM_STAGES)>
+      histograms_;
+};
+
+/*
+ * Run a stage of stateChangedImpl(), skipping it entirely if none of the
+ * subsystems it handles changed.
+ */
+template <typename StageFn>
+void processStage(StateChangeStage stage, bool changed, StageFn&& stageFn) {
+  if (!changed) {
+    return;
+  }
+  auto begin = std::chrono::steady_clock::now();
+  stageFn();
+  StateChangeHistograms::get().addValue(
+      stage,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - begin));
+}
+
 /*
  * For the devices/SDK we use on pre-TH4, the only events we should get (and
  * process) are ADD and DELETE. Learning generates ADD, aging generates DELETE,
@@ -1087,26 +1209,37 @@ std::shared_ptr<SwitchState> BcmSwitch::stateChangedTransaction(
 
 std::shared_ptr<SwitchState> BcmSwitch::stateChangedImpl(
     const StateDelta& delta) {
+  auto begin = steady_clock::now();
+  auto changed = [&delta](auto... subsystems) {
+    return (delta.isChanged(subsystems) || ...);
+  };
+  using Subsystem = SwitchStateSubsystem;
+  auto portsChanged = changed(Subsystem::PORTS);
+  auto vlansChanged = changed(Subsystem::VLANS);
+  auto mirrorsChanged = changed(Subsystem::MIRRORS);
+
   // Reconfigure port groups in case we are changing between using a port as
   // 1, 2 or 4 ports. Only do this if flexports are enabled
   // Calling reconfigure port group first to make sure the ports of SW state
   // already exists in HW.
-  if (FLAGS_flexports) {
-    reconfigurePortGroups(delta);
-  }
-
-  forEachAdded(delta.getPortsDelta(), [this](const auto& newPort) {
-    if (!portTable_->getBcmPortIf(newPort->getID())) {
-      throw FbossError(
-          "Cannot add a port:", newPort->getID(), " unknown to hardware");
+  processStage(StateChangeStage::PORT_GROUPS, portsChanged, [&]() {
+    if (FLAGS_flexports) {
+      reconfigurePortGroups(delta);
     }
-  });
 
-  forEachRemoved(delta.getPortsDelta(), [this](const auto& oldPort) {
-    if (portTable_->getBcmPortIf(oldPort->getID())) {
-      throw FbossError(
-          "Cannot remove a port:", oldPort->getID(), " still in port table");
-    }
+    forEachAdded(delta.getPortsDelta(), [this](const auto& newPort) {
+      if (!portTable_->getBcmPortIf(newPort->getID())) {
+        throw FbossError(
+            "Cannot add a port:", newPort->getID(), " unknown to hardware");
+      }
+    });
+
+    forEachRemoved(delta.getPortsDelta(), [this](const auto& oldPort) {
+      if (portTable_->getBcmPortIf(oldPort->getID())) {
+        throw FbossError(
+            "Cannot remove a port:", oldPort->getID(), " still in port table");
+      }
+    });
   });
   auto appliedState = delta.newState();
   // TODO: This function contains high-level logic for how to apply the
@@ -1116,38 +1249,63 @@ std::shared_ptr<SwitchState> BcmSwitch::stateChangedImpl(
 
   // As the first step, disable ports that are now disabled.
   // This ensures that we immediately stop forwarding traffic on these ports.
-  processDisabledPorts(delta);
+  processStage(StateChangeStage::DISABLED_PORTS, portsChanged, [&]() {
+    processDisabledPorts(delta);
+  });
 
-  processSwitchSettingsChanged(delta);
+  // QCM (re)evaluates the ports to monitor on any port change too
+  processStage(
+      StateChangeStage::SWITCH_SETTINGS,
+      changed(Subsystem::SWITCH_SETTINGS, Subsystem::PORTS, Subsystem::QCM_CFG),
+      [&]() { processSwitchSettingsChanged(delta); });
 
-  processMacTableChanges(delta);
+  processStage(StateChangeStage::MAC_TABLE, vlansChanged, [&]() {
+    processMacTableChanges(delta);
+  });
 
-  processLoadBalancerChanges(delta);
+  processStage(
+      StateChangeStage::LOAD_BALANCERS,
+      changed(Subsystem::LOAD_BALANCERS),
+      [&]() { processLoadBalancerChanges(delta); });
 
   CHECK(!bothStandAloneRibOrRouteTableRibUsed(delta));
 
   // remove all routes to be deleted
-  processRemovedRoutes(delta);
-  processRemovedFibRoutes(delta);
+  processStage(
+      StateChangeStage::REMOVED_ROUTES,
+      changed(Subsystem::ROUTE_TABLES, Subsystem::FIBS),
+      [&]() {
+        processRemovedRoutes(delta);
+        processRemovedFibRoutes(delta);
+      });
 
   // Any neighbor removals, and modify appliedState if some changes fail to
   // apply
-  processNeighborDelta(delta, &appliedState, REMOVED);
-
-  // delete all interface not existing anymore. that should stop
-  // all traffic on that interface now
-  forEachRemoved(delta.getIntfsDelta(), &BcmSwitch::processRemovedIntf, this);
+  processStage(StateChangeStage::REMOVED_NEIGHBORS, vlansChanged, [&]() {
+    processNeighborDelta(delta, &appliedState, REMOVED);
+  });
 
-  // Add all new VLANs, and modify VLAN port memberships.
-  // We don't actually delete removed VLANs at this point, we simply remove
-  // all members from the VLAN.  This way any ports that ingress packets to this
-  // VLAN will still use this VLAN until we get the new VLAN fully configured.
-  forEachChanged(
-      delta.getVlansDelta(),
-      &BcmSwitch::processChangedVlan,
-      &BcmSwitch::processAddedVlan,
-      &BcmSwitch::preprocessRemovedVlan,
-      this);
+  processStage(
+      StateChangeStage::REMOVED_INTFS_AND_CHANGED_VLANS,
+      changed(Subsystem::INTERFACES, Subsystem::VLANS),
+      [&]() {
+        // delete all interface not existing anymore. that should stop
+        // all traffic on that interface now
+        forEachRemoved(
+            delta.getIntfsDelta(), &BcmSwitch::processRemovedIntf, this);
+
+        // Add all new VLANs, and modify VLAN port memberships.
+        // We don't actually delete removed VLANs at this point, we simply
+        // remove all members from the VLAN.  This way any ports that ingress
+        // packets to this VLAN will still use this VLAN until we get the new
+        // VLAN fully configured.
+        forEachChanged(
+            delta.getVlansDelta(),
+            &BcmSwitch::processChangedVlan,
+            &BcmSwitch::processAddedVlan,
+            &BcmSwitch::preprocessRemovedVlan,
+            this);
+      });
 
   // Broadcom requires a default VLAN to always exist.
   // This VLAN is used as the default ingress VLAN for ports that don't have a
@@ -1161,73 +1319,123 @@ std::shared_ptr<SwitchState> BcmSwitch::stateChangedImpl(
         delta.oldState()->getDefaultVlan(), delta.newState()->getDefaultVlan());
   }
 
-  // Update changed interfaces
-  forEachChanged(delta.getIntfsDelta(), &BcmSwitch::processChangedIntf, this);
+  processStage(
+      StateChangeStage::CHANGED_INTFS_AND_REMOVED_VLANS,
+      changed(Subsystem::INTERFACES, Subsystem::VLANS),
+      [&]() {
+        // Update changed interfaces
+        forEachChanged(
+            delta.getIntfsDelta(), &BcmSwitch::processChangedIntf, this);
 
-  // Remove deleted VLANs
-  forEachRemoved(delta.getVlansDelta(), &BcmSwitch::processRemovedVlan, this);
+        // Remove deleted VLANs
+        forEachRemoved(
+            delta.getVlansDelta(), &BcmSwitch::processRemovedVlan, this);
 
-  // Add all new interfaces
-  forEachAdded(delta.getIntfsDelta(), &BcmSwitch::processAddedIntf, this);
+        // Add all new interfaces
+        forEachAdded(delta.getIntfsDelta(), &BcmSwitch::processAddedIntf, this);
+      });
 
   // Any changes to the Qos maps
-  processQosChanges(delta);
-
-  processControlPlaneChanges(delta);
-
-  processAggregatePortChanges(delta);
+  processStage(
+      StateChangeStage::QOS,
+      changed(
+          Subsystem::QOS_POLICIES, Subsystem::DEFAULT_DATA_PLANE_QOS_POLICY),
+      [&]() { processQosChanges(delta); });
+
+  processStage(
+      StateChangeStage::CONTROL_PLANE,
+      changed(Subsystem::CONTROL_PLANE),
+      [&]() { processControlPlaneChanges(delta); });
+
+  processStage(
+      StateChangeStage::AGGREGATE_PORTS,
+      changed(Subsystem::AGGREGATE_PORTS),
+      [&]() { processAggregatePortChanges(delta); });
 
   // Any neighbor additions/changes, and modify appliedState if some changes
   // fail to apply
-  processNeighborDelta(delta, &appliedState, ADDED);
-  processNeighborDelta(delta, &appliedState, CHANGED);
+  processStage(
+      StateChangeStage::ADDED_CHANGED_NEIGHBORS, vlansChanged, [&]() {
+        processNeighborDelta(delta, &appliedState, ADDED);
+        processNeighborDelta(delta, &appliedState, CHANGED);
+      });
 
   // process label forwarding changes after neighbor entries are updated
-  processChangedLabelForwardingInformationBase(delta);
+  processStage(
+      StateChangeStage::LABEL_FIB, changed(Subsystem::LABEL_FIB), [&]() {
+        processChangedLabelForwardingInformationBase(delta);
+      });
 
   // Add/update mirrors before processing Acl and port changes
   // This is to ensure that port and acls can access latest mirrors
-  forEachAdded(
-      delta.getMirrorsDelta(),
-      &BcmMirrorTable::processAddedMirror,
-      writableBcmMirrorTable());
-  forEachChanged(
-      delta.getMirrorsDelta(),
-      &BcmMirrorTable::processChangedMirror,
-      writableBcmMirrorTable());
+  processStage(StateChangeStage::MIRRORS, mirrorsChanged, [&]() {
+    forEachAdded(
+        delta.getMirrorsDelta(),
+        &BcmMirrorTable::processAddedMirror,
+        writableBcmMirrorTable());
+    forEachChanged(
+        delta.getMirrorsDelta(),
+        &BcmMirrorTable::processChangedMirror,
+        writableBcmMirrorTable());
+  });
 
   // Any ACL changes
-  processAclChanges(delta);
+  processStage(StateChangeStage::ACLS, changed(Subsystem::ACLS), [&]() {
+    processAclChanges(delta);
+  });
 
-  // Any changes to the set of sFlow collectors
-  processSflowCollectorChanges(delta);
+  processStage(
+      StateChangeStage::SFLOW,
+      changed(Subsystem::SFLOW_COLLECTORS, Subsystem::PORTS),
+      [&]() {
+        // Any changes to the set of sFlow collectors
+        processSflowCollectorChanges(delta);
 
-  // Any changes to the sampling rate of sflow
-  processSflowSamplingRateChanges(delta);
+        // Any changes to the sampling rate of sflow
+        processSflowSamplingRateChanges(delta);
+      });
 
   // Process any new routes or route changes
-  processAddedChangedRoutes(delta, &appliedState);
-  processAddedChangedFibRoutes(delta, &appliedState);
+  processStage(
+      StateChangeStage::ADDED_CHANGED_ROUTES,
+      changed(Subsystem::ROUTE_TABLES, Subsystem::FIBS),
+      [&]() {
+        processAddedChangedRoutes(delta, &appliedState);
+        processAddedChangedFibRoutes(delta, &appliedState);
+      });
 
-  processAddedPorts(delta);
-  processChangedPorts(delta);
+  processStage(StateChangeStage::PORTS, portsChanged, [&]() {
+    processAddedPorts(delta);
+    processChangedPorts(delta);
+  });
 
   // delete any removed mirrors after processing port and acl changes
-  forEachRemoved(
-      delta.getMirrorsDelta(),
-      &BcmMirrorTable::processRemovedMirror,
-      writableBcmMirrorTable());
+  processStage(StateChangeStage::REMOVED_MIRRORS, mirrorsChanged, [&]() {
+    forEachRemoved(
+        delta.getMirrorsDelta(),
+        &BcmMirrorTable::processRemovedMirror,
+        writableBcmMirrorTable());
+  });
 
-  pickupLinkStatusChanges(delta);
+  processStage(StateChangeStage::LINK_STATUS, portsChanged, [&]() {
+    pickupLinkStatusChanges(delta);
+  });
 
   // As the last step, enable newly enabled ports.  Doing this as the
   // last step ensures that we only start forwarding traffic once the
   // ports are correctly configured. Note that this will also set the
   // ingressVlan and speed correctly before enabling.
-  processEnabledPorts(delta);
+  processStage(StateChangeStage::ENABLED_PORTS, portsChanged, [&]() {
+    processEnabledPorts(delta);
+  });
 
-  bcmStatUpdater_->refreshPostBcmStateChange(delta);
+  processStage(StateChangeStage::STATS_REFRESH, true, [&]() {
+    bcmStatUpdater_->refreshPostBcmStateChange(delta);
+  });
 
+  StateChangeHistograms::get().addValue(
+      StateChangeStage::TOTAL,
+      duration_cast<microseconds>(steady_clock::now() - begin));
   return appliedState;
 }
 
@@ -2539,6 +2747,28 @@ bool BcmSwitch::sendPacketOutOfPortAsync(
   return BCM_SUCCESS(BcmTxPacket::sendAsync(std::move(bcmPkt), this));
 }
 
+size_t BcmSwitch::sendPacketsAsync(std::vector<BatchTxPacket> pkts) noexcept {
+  std::vector<unique_ptr<BcmTxPacket>> bcmPkts;
+  bcmPkts.reserve(pkts.size());
+  for (auto& batchPkt : pkts) {
+    unique_ptr<BcmTxPacket> bcmPkt(
+        boost::polymorphic_downcast<BcmTxPacket*>(batchPkt.pkt.release()));
+    if (batchPkt.port) {
+#ifdef INCLUDE_PKTIO
+      bcmPkt->setSwitched(false);
+#endif
+      bcmPkt->setDestModPort(getPortTable()->getBcmPortId(*batchPkt.port));
+      if (batchPkt.queue) {
+        bcmPkt->setCos(*batchPkt.queue);
+      }
+    }
+    bcmPkts.push_back(std::move(bcmPkt));
+  }
+  auto numPkts = bcmPkts.size();
+  auto rv = BcmTxPacket::sendAsyncBatch(std::move(bcmPkts), this);
+  return BCM_SUCCESS(rv) ? numPkts : 0;
+}
+
 bool BcmSwitch::sendPacketSwitchedSync(unique_ptr<TxPacket> pkt) noexcept {
   unique_ptr<BcmTxPacket> bcmPkt(
       boost::polymorphic_downcast<BcmTxPacket*>(pkt.release()));
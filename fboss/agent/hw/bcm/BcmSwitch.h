@@ -242,6 +242,7 @@ class BcmSwitch : public BcmSwitchIf {
       std::unique_ptr<TxPacket> pkt,
       PortID portID,
       std::optional<uint8_t> queue = std::nullopt) noexcept override;
+  size_t sendPacketsAsync(std::vector<BatchTxPacket> pkts) noexcept override;
 
   bool sendPacketSwitchedSync(std::unique_ptr<TxPacket> pkt) noexcept override;
   bool sendPacketOutOfPortSync(
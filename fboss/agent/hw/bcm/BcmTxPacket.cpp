@@ -175,6 +175,22 @@ BcmTxPacket::BcmTxPacket(int unit, uint32_t size, const BcmSwitch* bcmSwitch)
   freeTxBufUserData.release();
 }
 
+void BcmTxPacket::prepareBcmPkt() {
+  bcm_pkt_t* bcmPkt = bcmPacket_.ptrUnion.pkt;
+  const auto buf = this->buf();
+
+  // TODO(aeckert): Setting the pkt len manually should be replaced in future
+  // releases of bcm with BCM_PKT_TX_LEN_SET or bcm_flags_len_setup
+  DCHECK(bcmPkt->pkt_data);
+  bcmPkt->pkt_data->len = buf->length();
+
+  // Now we also set the buffer that will be sent out to point at
+  // buf->writableBuffer in case there is unused header space in the IOBuf
+  bcmPkt->pkt_data->data = buf->writableData();
+
+  queued_ = std::chrono::steady_clock::now();
+}
+
 inline int BcmTxPacket::sendImpl(
     unique_ptr<BcmTxPacket> pkt,
     const BcmSwitch* bcmSwitch) noexcept {
@@ -186,18 +202,7 @@ inline int BcmTxPacket::sendImpl(
 
   if (!usePktIO) {
     bcm_pkt_t* bcmPkt = pkt->bcmPacket_.ptrUnion.pkt;
-    const auto buf = pkt->buf();
-
-    // TODO(aeckert): Setting the pkt len manually should be replaced in future
-    // releases of bcm with BCM_PKT_TX_LEN_SET or bcm_flags_len_setup
-    DCHECK(bcmPkt->pkt_data);
-    bcmPkt->pkt_data->len = buf->length();
-
-    // Now we also set the buffer that will be sent out to point at
-    // buf->writableBuffer in case there is unused header space in the IOBuf
-    bcmPkt->pkt_data->data = buf->writableData();
-
-    pkt->queued_ = std::chrono::steady_clock::now();
+    pkt->prepareBcmPkt();
 
     txCbUserData =
         std::make_unique<BcmTxCallbackUserData>(std::move(pkt), bcmSwitch);
@@ -309,6 +314,25 @@ void BcmTxPacket::txCallbackAsync(int unit, bcm_pkt_t* pkt, void* cookie) {
   txCallbackImpl(unit, pkt, cookie);
 }
 
+void BcmTxPacket::txArrayCallback(
+    int /*unit*/,
+    bcm_pkt_t* /*pkt*/,
+    void* cookie) {
+  // Put the BcmTxArrayCallbackUserData back into a unique_ptr. This deletes
+  // every packet of the batch when we return.
+  unique_ptr<BcmTxArrayCallbackUserData> userData(
+      static_cast<BcmTxArrayCallbackUserData*>(cookie));
+  auto end = std::chrono::steady_clock::now();
+  for (auto& txPacket : userData->txPackets) {
+    // Now we reset the pkt buffer back to what was originally allocated
+    txPacket->bcmPacket_.ptrUnion.pkt->pkt_data->data =
+        txPacket->buf()->writableBuffer();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        end - txPacket->getQueueTime());
+    userData->bcmSwitch->getSwitchStats()->txSentDone(duration.count());
+  }
+}
+
 void BcmTxPacket::txCallbackSync(int unit, bcm_pkt_t* pkt, void* cookie) {
   txCallbackImpl(unit, pkt, cookie);
   std::lock_guard<std::mutex> lk(syncPktMutex());
@@ -329,6 +353,63 @@ int BcmTxPacket::sendAsync(
   return sendImpl(std::move(pkt), bcmSwitch);
 }
 
+int BcmTxPacket::sendAsyncBatch(
+    std::vector<unique_ptr<BcmTxPacket>> pkts,
+    const BcmSwitch* bcmSwitch) noexcept {
+  if (pkts.empty()) {
+    return BCM_E_NONE;
+  }
+  if (pkts.front()->bcmPacket_.usePktIO) {
+    /* PKTIO has no array TX, send packets one by one */
+    int rv = BCM_E_NONE;
+    for (auto& pkt : pkts) {
+      auto pktRv = sendAsync(std::move(pkt), bcmSwitch);
+      rv = BCM_SUCCESS(rv) ? pktRv : rv;
+    }
+    return rv;
+  }
+
+  std::vector<bcm_pkt_t*> bcmPkts;
+  bcmPkts.reserve(pkts.size());
+  for (auto& pkt : pkts) {
+    bcm_pkt_t* bcmPkt = pkt->bcmPacket_.ptrUnion.pkt;
+    // Completion is reported once for the whole array
+    DCHECK(bcmPkt->call_back == nullptr);
+    pkt->prepareBcmPkt();
+    bcmPkts.push_back(bcmPkt);
+  }
+  auto unit = bcmPkts.front()->unit;
+  auto numPkts = pkts.size();
+  auto userData = std::make_unique<BcmTxArrayCallbackUserData>(
+      std::move(pkts), bcmSwitch);
+  auto rv = bcm_tx_array(
+      unit,
+      bcmPkts.data(),
+      bcmPkts.size(),
+      BcmTxPacket::txArrayCallback,
+      userData.get());
+  if (BCM_SUCCESS(rv)) {
+    /*
+     * Release the unique pointer without destroying the packets. It will be
+     * reconstructed in txArrayCallback once the whole array is sent.
+     */
+    userData.release();
+    for (size_t i = 0; i < numPkts; ++i) {
+      bcmSwitch->getSwitchStats()->txSent();
+    }
+  } else {
+    bcmLogError(rv, "failed to send packet array");
+    for (size_t i = 0; i < numPkts; ++i) {
+      if (rv == BCM_E_MEMORY) {
+        bcmSwitch->getSwitchStats()->txPktAllocErrors();
+      } else {
+        bcmSwitch->getSwitchStats()->txError();
+      }
+    }
+  }
+  return rv;
+}
+
 int BcmTxPacket::sendSync(
     unique_ptr<BcmTxPacket> pkt,
     const BcmSwitch* bcmSwitch) noexcept {
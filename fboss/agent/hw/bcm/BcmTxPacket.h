@@ -12,6 +12,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/hw/bcm/BcmError.h"
@@ -38,6 +39,15 @@ struct BcmFreeTxBufUserData {
   const BcmSwitch* bcmSwitch;
 };
 
+struct BcmTxArrayCallbackUserData {
+  BcmTxArrayCallbackUserData(
+      std::vector<std::unique_ptr<BcmTxPacket>> txPackets,
+      const BcmSwitch* bcmSwitch)
+      : txPackets(std::move(txPackets)), bcmSwitch(bcmSwitch) {}
+  std::vector<std::unique_ptr<BcmTxPacket>> txPackets;
+  const BcmSwitch* bcmSwitch;
+};
+
 struct BcmTxCallbackUserData {
   BcmTxCallbackUserData(
       std::unique_ptr<BcmTxPacket> txPacket,
@@ -117,11 +127,29 @@ class BcmTxPacket : public TxPacket {
       std::unique_ptr<BcmTxPacket> pkt,
       const BcmSwitch* bcmSwitch) noexcept;
 
+  /*
+   * Send a batch of BcmTxPackets asynchronously with a single bcm_tx_array()
+   * call. Ownership and completion work like sendAsync(), but one callback
+   * completes the whole batch. PKTIO has no array TX, so there each packet
+   * is sent with sendAsync().
+   *
+   * Returns an Bcm error code.
+   */
+  static int sendAsyncBatch(
+      std::vector<std::unique_ptr<BcmTxPacket>> pkts,
+      const BcmSwitch* bcmSwitch) noexcept;
+
  private:
+  /*
+   * Point the bcm_pkt_t at the IOBuf data and stamp the queue time, just
+   * before handing the packet to bcm_tx*().
+   */
+  void prepareBcmPkt();
   inline static int sendImpl(
       std::unique_ptr<BcmTxPacket> pkt,
       const BcmSwitch* bcmSwitch) noexcept;
   static void txCallbackAsync(int unit, bcm_pkt_t* pkt, void* cookie);
+  static void txArrayCallback(int unit, bcm_pkt_t* pkt, void* cookie);
   static void txCallbackSync(int unit, bcm_pkt_t* pkt, void* cookie);
 
   // Forbidden copy constructor and assignment operator
@@ -899,6 +899,13 @@ int __real_bcm_pkt_free(int unit, bcm_pkt_t* pkt);
 
 int __real_bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* cookie);
 
+int __real_bcm_tx_array(
+    int unit,
+    bcm_pkt_t** pkt,
+    int count,
+    bcm_pkt_cb_f all_done_cb,
+    void* cookie);
+
 int __real_bcm_l3_egress_destroy(int unit, bcm_if_t intf);
 
 int __real_bcm_port_control_get(
@@ -2567,6 +2574,21 @@ int __wrap_bcm_tx(int unit, bcm_pkt_t* tx_pkt, void* cookie) {
   }
 }
 
+int __wrap_bcm_tx_array(
+    int unit,
+    bcm_pkt_t** pkt,
+    int count,
+    bcm_pkt_cb_f all_done_cb,
+    void* cookie) {
+  // As for bcm_tx, the callback frees the packets once they are sent, so
+  // BcmCinter logs them first
+  {
+    TIME_CALL;
+    CALL_WRAPPERS_RV_CINTER_FIRST(
+        bcm_tx_array(unit, pkt, count, all_done_cb, cookie));
+  }
+}
+
 int __wrap_bcm_rx_stop(int unit, bcm_rx_cfg_t* cfg) {
   CALL_WRAPPERS_RV(bcm_rx_stop(unit, cfg));
 }
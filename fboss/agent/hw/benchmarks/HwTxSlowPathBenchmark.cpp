@@ -23,12 +23,18 @@
 #include <chrono>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 DEFINE_bool(json, true, "Output in json form");
 DEFINE_bool(
     setup_for_warmboot,
     false,
     "Set to true will prepare the device for warmboot");
+DEFINE_int32(
+    tx_batch_size,
+    0,
+    "If > 0, hand packets to HwSwitch::sendPacketsAsync in batches of this "
+    "size instead of sending them one at a time");
 
 namespace facebook::fboss {
 
@@ -59,6 +65,7 @@ void runTxSlowPathBenchmark() {
     const auto kSrcIp = folly::IPAddressV6("2620:0:1cfe:face:b00c::3");
     const auto kDstIp = folly::IPAddressV6("2620:0:1cfe:face:b00c::4");
     const auto kSrcMac = folly::MacAddress{"fa:ce:b0:00:00:0c"};
+    std::vector<BatchTxPacket> batch;
     while (!packetTxDone) {
       for (auto i = 0; i < 1'000; ++i) {
         // Send packet
@@ -69,7 +76,15 @@ void runTxSlowPathBenchmark() {
             cpuMac,
             kSrcIp,
             kDstIp);
-        hwSwitch->sendPacketSwitchedAsync(std::move(txPacket));
+        if (FLAGS_tx_batch_size <= 0) {
+          hwSwitch->sendPacketSwitchedAsync(std::move(txPacket));
+          continue;
+        }
+        batch.push_back(BatchTxPacket{std::move(txPacket)});
+        if (batch.size() >= static_cast<size_t>(FLAGS_tx_batch_size)) {
+          hwSwitch->sendPacketsAsync(std::move(batch));
+          batch.clear();
+        }
       }
     }
   });
@@ -97,6 +112,7 @@ void runTxSlowPathBenchmark() {
     folly::dynamic cpuTxRateJson = folly::dynamic::object;
     cpuTxRateJson["cpu_tx_pps"] = pps;
     cpuTxRateJson["cpu_tx_bytes_per_sec"] = bytesPerSec;
+    cpuTxRateJson["tx_batch_size"] = FLAGS_tx_batch_size;
     std::cout << toPrettyJson(cpuTxRateJson) << std::endl;
   } else {
     XLOG(INFO) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
@@ -8,6 +8,7 @@
  *
  */
 
+#include "fboss/agent/Constants.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
@@ -17,6 +18,7 @@
 #include "fboss/agent/test/EcmpSetupHelper.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/IPAddressV6.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
@@ -24,6 +26,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <map>
 
 DEFINE_bool(json, true, "Output in json form");
 DEFINE_bool(
@@ -32,23 +35,50 @@ DEFINE_bool(
     "Set to true will prepare the device for warmboot");
 
 namespace {
+/*
+ * SaiStore reload time per object type of the current (warm) boot, if any.
+ * Collected up front, since fb303 may be gone by the time StopWatch reports.
+ */
+folly::dynamic saiStoreReloadUsecs() {
+  folly::dynamic reloadUsecs = folly::dynamic::object;
+  std::map<std::string, int64_t> counters;
+  facebook::fb303::fbData->getCounters(counters);
+  auto prefix = facebook::fboss::kSaiStoreReloadUsecsPrefix;
+  for (const auto& [name, value] : counters) {
+    if (folly::StringPiece(name).startsWith(prefix)) {
+      reloadUsecs[name.substr(prefix.size())] = value;
+    }
+  }
+  return reloadUsecs;
+}
+
 class StopWatch {
  public:
-  StopWatch() : startTime_(std::chrono::steady_clock::now()) {}
+  explicit StopWatch(folly::dynamic reloadUsecs)
+      : startTime_(std::chrono::steady_clock::now()),
+        reloadUsecs_(std::move(reloadUsecs)) {}
   ~StopWatch() {
     std::chrono::duration<double, std::milli> durationMillseconds =
         std::chrono::steady_clock::now() - startTime_;
     if (FLAGS_json) {
       folly::dynamic warmBootTime = folly::dynamic::object;
       warmBootTime["warm_boot_msecs"] = durationMillseconds.count();
+      if (!reloadUsecs_.empty()) {
+        warmBootTime["sai_store_reload_usecs"] = reloadUsecs_;
+      }
       std::cout << warmBootTime << std::endl;
     } else {
       XLOG(INFO) << " warm boot msecs: " << durationMillseconds.count();
+      for (const auto& [objectType, usecs] : reloadUsecs_.items()) {
+        XLOG(INFO) << " sai store " << objectType.asString()
+                   << " reload usecs: " << usecs.asInt();
+      }
     }
   }
 
  private:
   std::chrono::time_point<std::chrono::steady_clock> startTime_;
+  folly::dynamic reloadUsecs_;
 };
 } // namespace
 namespace facebook::fboss {
@@ -100,7 +130,7 @@ void runBenchmark() {
   // Static such that the object destructor runs as late as possible. In
   // particular in this case, destructor (and thus the duration calculation)
   // will run at the time of program exit when static variable destructors run
-  static StopWatch timer;
+  static StopWatch timer(saiStoreReloadUsecs());
   ensemble->gracefulExit();
   // Leak HwSwitchEnsemble for warmboot, so that
   // we don't run destructors and unprogram h/w. We are
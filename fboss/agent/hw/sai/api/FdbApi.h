@@ -102,6 +102,10 @@ SAI_ATTRIBUTE_NAME(Fdb, Metadata)
 template <>
 struct IsSaiEntryStruct<SaiFdbTraits::FdbEntry> : public std::true_type {};
 
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    SaiFdbTraits::FdbEntry,
+    SaiFdbTraits::ObjectType);
+
 class FdbApi : public SaiApi<FdbApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_FDB;
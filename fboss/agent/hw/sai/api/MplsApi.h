@@ -84,6 +84,10 @@ SAI_ATTRIBUTE_NAME(InSeg, NumOfPop)
 template <>
 struct IsSaiEntryStruct<SaiInSegTraits::InSegEntry> : public std::true_type {};
 
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    SaiInSegTraits::InSegEntry,
+    SaiInSegTraits::ObjectType);
+
 class MplsApi : public SaiApi<MplsApi> {
  public:
   static auto constexpr ApiType = SAI_API_MPLS;
@@ -103,6 +103,10 @@ template <>
 struct IsSaiEntryStruct<SaiNeighborTraits::NeighborEntry>
     : public std::true_type {};
 
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    SaiNeighborTraits::NeighborEntry,
+    SaiNeighborTraits::ObjectType);
+
 class NeighborApi : public SaiApi<NeighborApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_NEIGHBOR;
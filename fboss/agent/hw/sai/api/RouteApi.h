@@ -96,6 +96,10 @@ struct SaiRouteTraits {
 template <>
 struct IsSaiEntryStruct<SaiRouteTraits::RouteEntry> : public std::true_type {};
 
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    SaiRouteTraits::RouteEntry,
+    SaiRouteTraits::ObjectType);
+
 SAI_ATTRIBUTE_NAME(Route, PacketAction)
 SAI_ATTRIBUTE_NAME(Route, NextHopId)
 SAI_ATTRIBUTE_NAME(Route, Metadata)
@@ -10,11 +10,13 @@
 #pragma once
 
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiCallStats.h"
 #include "fboss/agent/hw/sai/api/SaiApiError.h"
 #include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiAttribute.h"
 #include "fboss/agent/hw/sai/api/SaiAttributeDataTypes.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
+#include "fboss/agent/hw/sai/api/Types.h"
 #include "fboss/lib/FunctionCallTimeReporter.h"
 #include "fboss/lib/TupleUtils.h"
 
@@ -86,10 +88,17 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     sai_status_t status;
     {
       TIME_CALL;
+      TIME_SAI_API_CALL(
+          apiType(),
+          SaiObjectTraits::ObjectType,
+          SaiApiOperation::CREATE,
+          "{}: {}",
+          key,
+          createAttributes);
       status = impl()._create(
           &key, switch_id, saiAttributeTs.size(), saiAttributeTs.data());
     }
@@ -121,10 +130,17 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     sai_status_t status;
     {
       TIME_CALL;
+      TIME_SAI_API_CALL(
+          apiType(),
+          SaiObjectTraits::ObjectType,
+          SaiApiOperation::CREATE,
+          "{}: {}",
+          entry,
+          createAttributes);
       status =
           impl()._create(entry, saiAttributeTs.size(), saiAttributeTs.data());
     }
@@ -147,10 +163,16 @@ class SaiApi {
           "Attempting to remove SAI obj {} while hw writes are blocked",
           key);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     sai_status_t status;
     {
       TIME_CALL;
+      TIME_SAI_API_CALL(
+          apiType(),
+          SaiObjectTypeOfAdapterKey<AdapterKeyT>::value,
+          SaiApiOperation::REMOVE,
+          "{}",
+          key);
       status = impl()._remove(key);
     }
     saiApiCheckError(
@@ -181,10 +203,19 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     sai_status_t status;
     {
       TIME_CALL;
+      // Only the attribute id: on SAI_STATUS_BUFFER_OVERFLOW the adapter sets
+      // a list count larger than the buffer, so the value can't be formatted
+      TIME_SAI_API_CALL(
+          apiType(),
+          SaiObjectTypeOfAdapterKey<AdapterKeyT>::value,
+          SaiApiOperation::GET_ATTRIBUTE,
+          "{}: attribute id {}",
+          key,
+          attr.saiAttr()->id);
       status = impl()._getAttribute(key, attr.saiAttr());
     }
     /*
@@ -198,6 +229,13 @@ class SaiApi {
       attr.realloc();
       {
         TIME_CALL;
+        TIME_SAI_API_CALL(
+            apiType(),
+            SaiObjectTypeOfAdapterKey<AdapterKeyT>::value,
+            SaiApiOperation::GET_ATTRIBUTE,
+            "{}: {}",
+            key,
+            attr);
         status = impl()._getAttribute(key, attr.saiAttr());
       }
     }
@@ -311,6 +349,13 @@ class SaiApi {
     sai_status_t status;
     {
       TIME_CALL;
+      TIME_SAI_API_CALL(
+          apiType(),
+          SaiObjectTypeOfAdapterKey<AdapterKeyT>::value,
+          SaiApiOperation::SET_ATTRIBUTE,
+          "{}: {}",
+          key,
+          attr);
       status = impl()._setAttribute(key, saiAttr(attr));
     }
     saiApiCheckError(
@@ -321,7 +366,7 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     setAttributeUnlocked(key, attr);
   }
 
@@ -333,7 +378,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -344,7 +389,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -366,7 +411,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -374,7 +419,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lockApi(apiType());
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -407,6 +452,13 @@ class SaiApi {
       sai_status_t status;
       {
         TIME_CALL
+        TIME_SAI_API_CALL(
+            apiType(),
+            SaiObjectTraits::ObjectType,
+            SaiApiOperation::GET_STATS,
+            "{}: {} counters",
+            key,
+            numCounters);
         status = impl()._getStats(
             key, counters.size(), counterIds, mode, counters.data());
       }
@@ -434,6 +486,13 @@ class SaiApi {
       sai_status_t status;
       {
         TIME_CALL
+        TIME_SAI_API_CALL(
+            apiType(),
+            SaiObjectTraits::ObjectType,
+            SaiApiOperation::CLEAR_STATS,
+            "{}: {} counters",
+            key,
+            numCounters);
         status = impl()._clearStats(key, numCounters, counterIds);
       }
       saiApiCheckError(status, apiType(), "Failed to clear stats");
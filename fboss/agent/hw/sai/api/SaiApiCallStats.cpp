@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiApiCallStats.h"
+
+#include <folly/Singleton.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadId.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+DEFINE_bool(
+    sai_api_call_stats,
+    true,
+    "Track the latency of SAI calls by API, object type and operation");
+DEFINE_int32(
+    sai_slow_call_usecs,
+    1000,
+    "SAI calls taking at least this long are candidates for the slowest "
+    "calls list");
+DEFINE_int32(
+    sai_slow_calls_to_keep,
+    32,
+    "Number of slowest SAI calls to keep, with their attributes");
+
+namespace {
+struct singleton_tag_type {};
+
+// How long to calibrate the timestamp counter against the steady clock for
+constexpr std::chrono::milliseconds kCalibrationTime(10);
+
+bool slowerCall(
+    const facebook::fboss::SaiApiSlowCall& a,
+    const facebook::fboss::SaiApiSlowCall& b) {
+  return a.usecs > b.usecs;
+}
+} // namespace
+
+static folly::Singleton<facebook::fboss::SaiApiCallStats, singleton_tag_type>
+    saiApiCallStatsSingleton{};
+
+namespace facebook::fboss {
+
+std::shared_ptr<SaiApiCallStats> SaiApiCallStats::getInstance() {
+  return saiApiCallStatsSingleton.try_get();
+}
+
+folly::StringPiece saiApiOperationToString(SaiApiOperation operation) {
+  switch (operation) {
+    case SaiApiOperation::CREATE:
+      return "create";
+    case SaiApiOperation::REMOVE:
+      return "remove";
+    case SaiApiOperation::SET_ATTRIBUTE:
+      return "set_attribute";
+    case SaiApiOperation::GET_ATTRIBUTE:
+      return "get_attribute";
+    case SaiApiOperation::GET_STATS:
+      return "get_stats";
+    case SaiApiOperation::CLEAR_STATS:
+      return "clear_stats";
+  }
+  return "unknown";
+}
+
+size_t SaiApiCallLatency::bucket(uint64_t usecs) {
+  size_t bucket = 0;
+  while (usecs && bucket < kNumBuckets - 1) {
+    usecs >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+uint64_t SaiApiCallLatency::bucketUpperBoundUsecs(size_t bucket) {
+  return 1ULL << bucket;
+}
+
+uint64_t SaiApiCallLatency::percentileUsecs(double percentile) const {
+  if (!calls) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(calls * percentile / 100);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += buckets[i];
+    if (seen > target) {
+      return std::min(bucketUpperBoundUsecs(i), maxUsecs);
+    }
+  }
+  return maxUsecs;
+}
+
+void SaiApiCallStats::calibrate() {
+  std::call_once(calibrated_, [this]() {
+    auto startTicks = now();
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(kCalibrationTime);
+    auto ticks = now() - startTicks;
+    auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+    if (ticks && usecs > 0) {
+      ticksPerUsec_ = static_cast<double>(ticks) / usecs;
+    }
+    XLOG(DBG2) << "SAI call timestamp counter ticks per usec: "
+               << ticksPerUsec_.load();
+  });
+}
+
+SaiApiCallStats::Shard& SaiApiCallStats::localShard() {
+  return shards_[folly::getCurrentThreadID() % kNumShards];
+}
+
+bool SaiApiCallStats::recordLatency(
+    const SaiApiCallKey& key,
+    uint64_t usecs) {
+  {
+    auto& shard = localShard();
+    std::lock_guard<std::mutex> g(shard.lock);
+    auto& latency = shard.latencies[key];
+    ++latency.calls;
+    latency.totalUsecs += usecs;
+    latency.maxUsecs = std::max(latency.maxUsecs, usecs);
+    ++latency.buckets[SaiApiCallLatency::bucket(usecs)];
+  }
+
+  if (FLAGS_sai_slow_calls_to_keep <= 0 ||
+      usecs < static_cast<uint64_t>(std::max(FLAGS_sai_slow_call_usecs, 0))) {
+    return false;
+  }
+  std::lock_guard<std::mutex> g(slowCallsLock_);
+  return slowCalls_.size() <
+      static_cast<size_t>(FLAGS_sai_slow_calls_to_keep) ||
+      usecs > slowCalls_.front().usecs;
+}
+
+void SaiApiCallStats::recordSlowCall(
+    const SaiApiCallKey& key,
+    uint64_t usecs,
+    std::string summary) {
+  std::lock_guard<std::mutex> g(slowCallsLock_);
+  auto toKeep = static_cast<size_t>(std::max(FLAGS_sai_slow_calls_to_keep, 1));
+  // Slower calls may have been kept since recordLatency checked
+  if (slowCalls_.size() >= toKeep && usecs <= slowCalls_.front().usecs) {
+    return;
+  }
+  while (slowCalls_.size() >= toKeep) {
+    std::pop_heap(slowCalls_.begin(), slowCalls_.end(), slowerCall);
+    slowCalls_.pop_back();
+  }
+  slowCalls_.push_back({key, usecs, std::move(summary)});
+  std::push_heap(slowCalls_.begin(), slowCalls_.end(), slowerCall);
+}
+
+std::map<SaiApiCallKey, SaiApiCallLatency> SaiApiCallStats::getLatencies()
+    const {
+  std::map<SaiApiCallKey, SaiApiCallLatency> latencies;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> g(shard.lock);
+    for (const auto& keyAndLatency : shard.latencies) {
+      const auto& shardLatency = keyAndLatency.second;
+      auto& latency = latencies[keyAndLatency.first];
+      latency.calls += shardLatency.calls;
+      latency.totalUsecs += shardLatency.totalUsecs;
+      latency.maxUsecs = std::max(latency.maxUsecs, shardLatency.maxUsecs);
+      for (size_t i = 0; i < SaiApiCallLatency::kNumBuckets; ++i) {
+        latency.buckets[i] += shardLatency.buckets[i];
+      }
+    }
+  }
+  return latencies;
+}
+
+std::vector<SaiApiSlowCall> SaiApiCallStats::getSlowCalls() const {
+  std::vector<SaiApiSlowCall> slowCalls;
+  {
+    std::lock_guard<std::mutex> g(slowCallsLock_);
+    slowCalls = slowCalls_;
+  }
+  std::sort(slowCalls.begin(), slowCalls.end(), slowerCall);
+  return slowCalls;
+}
+
+void SaiApiCallStats::clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> g(shard.lock);
+    shard.latencies.clear();
+  }
+  std::lock_guard<std::mutex> g(slowCallsLock_);
+  slowCalls_.clear();
+}
+
+} // namespace facebook::fboss
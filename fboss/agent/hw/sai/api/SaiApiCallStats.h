@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Likely.h>
+#include <folly/Range.h>
+#include <folly/chrono/Hardware.h>
+#include <folly/lang/Align.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+extern "C" {
+#include <sai.h>
+}
+
+DECLARE_bool(sai_api_call_stats);
+DECLARE_int32(sai_slow_call_usecs);
+DECLARE_int32(sai_slow_calls_to_keep);
+
+namespace facebook::fboss {
+
+enum class SaiApiOperation : uint8_t {
+  CREATE,
+  REMOVE,
+  SET_ATTRIBUTE,
+  GET_ATTRIBUTE,
+  GET_STATS,
+  CLEAR_STATS,
+};
+
+folly::StringPiece saiApiOperationToString(SaiApiOperation operation);
+
+struct SaiApiCallKey {
+  sai_api_t api;
+  sai_object_type_t objectType;
+  SaiApiOperation operation;
+
+  bool operator<(const SaiApiCallKey& other) const {
+    return std::tie(api, objectType, operation) <
+        std::tie(other.api, other.objectType, other.operation);
+  }
+};
+
+struct SaiApiCallLatency {
+  // Bucket i counts calls taking [2^(i-1), 2^i) usecs, bucket 0 calls
+  // taking under a usec, the last bucket anything longer
+  static constexpr size_t kNumBuckets = 32;
+
+  uint64_t calls{0};
+  uint64_t totalUsecs{0};
+  uint64_t maxUsecs{0};
+  std::array<uint64_t, kNumBuckets> buckets{};
+
+  static size_t bucket(uint64_t usecs);
+  static uint64_t bucketUpperBoundUsecs(size_t bucket);
+
+  // Upper bound of the bucket the given percentile of calls fall in
+  uint64_t percentileUsecs(double percentile) const;
+};
+
+struct SaiApiSlowCall {
+  SaiApiCallKey key;
+  uint64_t usecs;
+  // The adapter key and attributes of the call
+  std::string summary;
+};
+
+/*
+ * Latency of every SAI call made through SaiApi, by API, object type and
+ * operation, and the slowest calls made, so that time spent programming
+ * the ASIC can be attributed to specific adapter calls.
+ *
+ * Calls are timed with the CPU timestamp counter, which is calibrated
+ * against the steady clock once, by calibrate(). SaiApiTable calibrates when
+ * it queries the apis, so that no SAI call is timed while waiting on the
+ * calibration; until then 1GHz is assumed. Calls are
+ * only summarized, which formats their attributes, if they take at least
+ * --sai_slow_call_usecs and are among the --sai_slow_calls_to_keep slowest
+ * calls so far.
+ *
+ * Latencies are recorded in one of kNumShards shards, picked by thread, each
+ * with its own mutex, and summed up when read. Threads calling apis the
+ * adapter allows to be called concurrently, e.g. the route programming
+ * threads, thus rarely contend. Only calls slow enough to be candidates for
+ * the slowest calls also take the slow call mutex.
+ */
+class SaiApiCallStats {
+ public:
+  static std::shared_ptr<SaiApiCallStats> getInstance();
+
+  SaiApiCallStats() = default;
+
+  // Measure the timestamp counter rate. Only the first call does so.
+  void calibrate();
+
+  static uint64_t now() {
+    return folly::hardware_timestamp();
+  }
+
+  template <typename Summarize>
+  void record(const SaiApiCallKey& key, uint64_t ticks, Summarize& summarize) {
+    auto usecs = static_cast<uint64_t>(
+        ticks / ticksPerUsec_.load(std::memory_order_relaxed));
+    if (UNLIKELY(recordLatency(key, usecs))) {
+      recordSlowCall(key, usecs, summarize());
+    }
+  }
+
+  std::map<SaiApiCallKey, SaiApiCallLatency> getLatencies() const;
+  // Slowest first
+  std::vector<SaiApiSlowCall> getSlowCalls() const;
+  void clear();
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  SaiApiCallStats(SaiApiCallStats const&) = delete;
+  SaiApiCallStats& operator=(SaiApiCallStats const&) = delete;
+
+  // Returns whether the call is slow enough to keep
+  bool recordLatency(const SaiApiCallKey& key, uint64_t usecs);
+  void recordSlowCall(
+      const SaiApiCallKey& key,
+      uint64_t usecs,
+      std::string summary);
+
+  static constexpr size_t kNumShards = 16;
+
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    std::mutex lock;
+    std::map<SaiApiCallKey, SaiApiCallLatency> latencies;
+  };
+
+  Shard& localShard();
+
+  std::once_flag calibrated_;
+  std::atomic<double> ticksPerUsec_{1000};
+
+  mutable std::array<Shard, kNumShards> shards_;
+
+  mutable std::mutex slowCallsLock_;
+  // Min heap on usecs, so the fastest of the slow calls is the first to go
+  std::vector<SaiApiSlowCall> slowCalls_;
+};
+
+/*
+ * Times one SAI call, for the scope of the timer
+ */
+template <typename Summarize>
+class SaiApiCallTimer {
+ public:
+  SaiApiCallTimer(
+      sai_api_t api,
+      sai_object_type_t objectType,
+      SaiApiOperation operation,
+      Summarize summarize)
+      : key_{api, objectType, operation},
+        summarize_(std::move(summarize)),
+        start_(FLAGS_sai_api_call_stats ? SaiApiCallStats::now() : 0) {}
+
+  ~SaiApiCallTimer() {
+    if (start_) {
+      auto ticks = SaiApiCallStats::now() - start_;
+      if (auto stats = SaiApiCallStats::getInstance()) {
+        stats->record(key_, ticks, summarize_);
+      }
+    }
+  }
+
+  SaiApiCallTimer(const SaiApiCallTimer&) = delete;
+  SaiApiCallTimer& operator=(const SaiApiCallTimer&) = delete;
+
+ private:
+  SaiApiCallKey key_;
+  Summarize summarize_;
+  uint64_t start_;
+};
+
+/*
+ * Time a SAI call for the rest of the scope. The trailing arguments are
+ * fmt::format arguments summarizing the call, only formatted for slow calls.
+ */
+#define TIME_SAI_API_CALL(api, objectType, operation, ...)   \
+  SaiApiCallTimer saiApiCallTimer(                           \
+      api, objectType, operation, [&]() {                    \
+        return fmt::format(__VA_ARGS__);                     \
+      });
+
+} // namespace facebook::fboss
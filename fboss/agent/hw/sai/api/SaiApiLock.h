@@ -9,11 +9,41 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
+extern "C" {
+#include <sai.h>
+}
+
 class SaiApiLock {
  public:
   static std::shared_ptr<SaiApiLock> getInstance();
+
+  /*
+   * Lock to hold for a call into the given api. SAI calls are serialized on
+   * the one global lock, unless the adapter's functions for that api were
+   * declared safe to call concurrently, in which case the returned lock is
+   * not held.
+   */
+  std::unique_lock<std::mutex> lockApi(sai_api_t api) {
+    if (concurrentApis_[api].load(std::memory_order_relaxed)) {
+      return std::unique_lock<std::mutex>(lock, std::defer_lock);
+    }
+    return std::unique_lock<std::mutex>(lock);
+  }
+
+  void setConcurrentApi(sai_api_t api, bool concurrent) {
+    concurrentApis_[api].store(concurrent, std::memory_order_relaxed);
+  }
+  bool isConcurrentApi(sai_api_t api) const {
+    return concurrentApis_[api].load(std::memory_order_relaxed);
+  }
+
   std::mutex lock;
+
+ private:
+  std::array<std::atomic<bool>, SAI_API_MAX> concurrentApis_{};
 };
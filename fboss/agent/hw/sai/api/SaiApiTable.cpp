@@ -10,6 +10,7 @@
 
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiCallStats.h"
 
 #include "fboss/lib/TupleUtils.h"
 
@@ -36,6 +37,9 @@ void SaiApiTable::queryApis() {
     return;
   }
   apisQueried_ = true;
+  if (auto callStats = SaiApiCallStats::getInstance()) {
+    callStats->calibrate();
+  }
   std::get<std::unique_ptr<AclApi>>(apis_) = std::make_unique<AclApi>();
   std::get<std::unique_ptr<BridgeApi>>(apis_) = std::make_unique<BridgeApi>();
   std::get<std::unique_ptr<BufferApi>>(apis_) = std::make_unique<BufferApi>();
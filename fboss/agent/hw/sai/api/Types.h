@@ -55,6 +55,63 @@ namespace facebook::fboss {
 
 using SaiCharArray32 = std::array<char, 32>;
 
+/*
+ * Object type of an adapter key, for calls which are handed just the key.
+ * Entry struct keys are mapped where they are defined.
+ */
+template <typename AdapterKeyT>
+struct SaiObjectTypeOfAdapterKey {
+  static constexpr sai_object_type_t value = SAI_OBJECT_TYPE_NULL;
+};
+
+#define SAI_ADAPTER_KEY_OBJECT_TYPE(AdapterKeyT, objectType) \
+  template <>                                                \
+  struct SaiObjectTypeOfAdapterKey<AdapterKeyT> {            \
+    static constexpr sai_object_type_t value = objectType;   \
+  }
+
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    AclTableGroupSaiId, SAI_OBJECT_TYPE_ACL_TABLE_GROUP);
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    AclTableGroupMemberSaiId, SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(AclTableSaiId, SAI_OBJECT_TYPE_ACL_TABLE);
+SAI_ADAPTER_KEY_OBJECT_TYPE(AclEntrySaiId, SAI_OBJECT_TYPE_ACL_ENTRY);
+SAI_ADAPTER_KEY_OBJECT_TYPE(AclCounterSaiId, SAI_OBJECT_TYPE_ACL_COUNTER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(BridgeSaiId, SAI_OBJECT_TYPE_BRIDGE);
+SAI_ADAPTER_KEY_OBJECT_TYPE(BridgePortSaiId, SAI_OBJECT_TYPE_BRIDGE_PORT);
+SAI_ADAPTER_KEY_OBJECT_TYPE(BufferPoolSaiId, SAI_OBJECT_TYPE_BUFFER_POOL);
+SAI_ADAPTER_KEY_OBJECT_TYPE(BufferProfileSaiId, SAI_OBJECT_TYPE_BUFFER_PROFILE);
+SAI_ADAPTER_KEY_OBJECT_TYPE(DebugCounterSaiId, SAI_OBJECT_TYPE_DEBUG_COUNTER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(HashSaiId, SAI_OBJECT_TYPE_HASH);
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    HostifTrapGroupSaiId, SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP);
+SAI_ADAPTER_KEY_OBJECT_TYPE(HostifTrapSaiId, SAI_OBJECT_TYPE_HOSTIF_TRAP);
+SAI_ADAPTER_KEY_OBJECT_TYPE(LagSaiId, SAI_OBJECT_TYPE_LAG);
+SAI_ADAPTER_KEY_OBJECT_TYPE(LagMemberSaiId, SAI_OBJECT_TYPE_LAG_MEMBER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(MirrorSaiId, SAI_OBJECT_TYPE_MIRROR_SESSION);
+SAI_ADAPTER_KEY_OBJECT_TYPE(NextHopSaiId, SAI_OBJECT_TYPE_NEXT_HOP);
+SAI_ADAPTER_KEY_OBJECT_TYPE(NextHopGroupSaiId, SAI_OBJECT_TYPE_NEXT_HOP_GROUP);
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    NextHopGroupMemberSaiId, SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(PortSaiId, SAI_OBJECT_TYPE_PORT);
+SAI_ADAPTER_KEY_OBJECT_TYPE(PortSerdesSaiId, SAI_OBJECT_TYPE_PORT_SERDES);
+SAI_ADAPTER_KEY_OBJECT_TYPE(QosMapSaiId, SAI_OBJECT_TYPE_QOS_MAP);
+SAI_ADAPTER_KEY_OBJECT_TYPE(QueueSaiId, SAI_OBJECT_TYPE_QUEUE);
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    RouterInterfaceSaiId, SAI_OBJECT_TYPE_ROUTER_INTERFACE);
+SAI_ADAPTER_KEY_OBJECT_TYPE(SamplePacketSaiId, SAI_OBJECT_TYPE_SAMPLEPACKET);
+SAI_ADAPTER_KEY_OBJECT_TYPE(SchedulerSaiId, SAI_OBJECT_TYPE_SCHEDULER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(SwitchSaiId, SAI_OBJECT_TYPE_SWITCH);
+SAI_ADAPTER_KEY_OBJECT_TYPE(VirtualRouterSaiId, SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(VlanSaiId, SAI_OBJECT_TYPE_VLAN);
+SAI_ADAPTER_KEY_OBJECT_TYPE(VlanMemberSaiId, SAI_OBJECT_TYPE_VLAN_MEMBER);
+SAI_ADAPTER_KEY_OBJECT_TYPE(WredSaiId, SAI_OBJECT_TYPE_WRED);
+SAI_ADAPTER_KEY_OBJECT_TYPE(TamReportSaiId, SAI_OBJECT_TYPE_TAM_REPORT);
+SAI_ADAPTER_KEY_OBJECT_TYPE(
+    TamEventActionSaiId, SAI_OBJECT_TYPE_TAM_EVENT_ACTION);
+SAI_ADAPTER_KEY_OBJECT_TYPE(TamEventSaiId, SAI_OBJECT_TYPE_TAM_EVENT);
+SAI_ADAPTER_KEY_OBJECT_TYPE(TamSaiId, SAI_OBJECT_TYPE_TAM);
+
 template <typename SaiId>
 sai_object_id_t* rawSaiId(SaiId* id) {
   return reinterpret_cast<sai_object_id_t*>(id);
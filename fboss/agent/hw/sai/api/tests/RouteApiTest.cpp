@@ -10,8 +10,11 @@
 #include "fboss/agent/hw/sai/api/RouteApi.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
 
 #include <folly/IPAddress.h>
+#include <folly/ScopeGuard.h>
+#include <folly/json.h>
 #include <folly/logging/xlog.h>
 
 #include <gtest/gtest.h>
@@ -174,6 +177,30 @@ TEST_F(RouteApiTest, routeKeys) {
   EXPECT_EQ(routeKeys[0], r);
 }
 
+TEST_F(RouteApiTest, createRouteBeyondFakeCapacity) {
+  auto& latencyModel = FakeSaiLatencyModel::getInstance();
+  SCOPE_EXIT {
+    latencyModel.clear();
+  };
+  folly::dynamic profile = folly::dynamic::object(
+      "route_entry",
+      folly::dynamic::object(
+          "create", folly::dynamic::object("fixed_usecs", 1))(
+          "capacity", fs->routeManager.map().size() + 1));
+  latencyModel.loadProfileFromJson(folly::toJson(profile));
+
+  SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+      SAI_PACKET_ACTION_DROP};
+  SaiRouteTraits::RouteEntry r1(0, 0, folly::CIDRNetwork("10.1.1.0", 24));
+  routeApi->create<SaiRouteTraits>(
+      r1, {packetActionAttribute, std::nullopt, std::nullopt});
+  SaiRouteTraits::RouteEntry r2(0, 0, folly::CIDRNetwork("10.1.2.0", 24));
+  EXPECT_THROW(
+      routeApi->create<SaiRouteTraits>(
+          r2, {packetActionAttribute, std::nullopt, std::nullopt}),
+      SaiApiError);
+}
+
 TEST_F(RouteApiTest, formatRouteNextHopId) {
   SaiRouteTraits::Attributes::NextHopId nhid{42};
   std::string expected("NextHopId: 42");
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/api/SaiApiCallStats.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/VlanApi.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
+
+#include <folly/IPAddress.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace facebook::fboss;
+
+class SaiApiCallStatsTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    fs = FakeSai::getInstance();
+    sai_api_initialize(0, nullptr);
+    routeApi = std::make_unique<RouteApi>();
+    stats = SaiApiCallStats::getInstance();
+    stats->calibrate();
+    stats->clear();
+  }
+  void TearDown() override {
+    FakeSaiLatencyModel::getInstance().clear();
+    stats->clear();
+  }
+
+  void createRoute(const std::string& network) {
+    SaiRouteTraits::RouteEntry r(0, 0, folly::CIDRNetwork(network, 24));
+    routeApi->create<SaiRouteTraits>(
+        r,
+        {SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_DROP},
+         std::nullopt,
+         std::nullopt});
+  }
+
+  gflags::FlagSaver flagSaver;
+  std::shared_ptr<FakeSai> fs;
+  std::unique_ptr<RouteApi> routeApi;
+  std::shared_ptr<SaiApiCallStats> stats;
+};
+
+TEST_F(SaiApiCallStatsTest, latencyByObjectTypeAndOperation) {
+  createRoute("10.1.1.0");
+  createRoute("10.1.2.0");
+  SaiRouteTraits::RouteEntry r(
+      0, 0, folly::CIDRNetwork(folly::IPAddress("10.1.1.0"), 24));
+  routeApi->getAttribute(r, SaiRouteTraits::Attributes::PacketAction());
+
+  auto latencies = stats->getLatencies();
+  SaiApiCallKey createKey{
+      SAI_API_ROUTE, SAI_OBJECT_TYPE_ROUTE_ENTRY, SaiApiOperation::CREATE};
+  ASSERT_EQ(1, latencies.count(createKey));
+  EXPECT_EQ(2, latencies[createKey].calls);
+  SaiApiCallKey getKey{
+      SAI_API_ROUTE,
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      SaiApiOperation::GET_ATTRIBUTE};
+  ASSERT_EQ(1, latencies.count(getKey));
+  EXPECT_EQ(1, latencies[getKey].calls);
+}
+
+TEST_F(SaiApiCallStatsTest, slowestCalls) {
+  FLAGS_sai_slow_call_usecs = 500;
+  FLAGS_sai_slow_calls_to_keep = 2;
+  folly::dynamic profile = folly::dynamic::object(
+      "route_entry",
+      folly::dynamic::object(
+          "create", folly::dynamic::object("fixed_usecs", 1000)));
+  FakeSaiLatencyModel::getInstance().loadProfileFromJson(
+      folly::toJson(profile));
+
+  createRoute("10.1.1.0");
+  createRoute("10.1.2.0");
+  createRoute("10.1.3.0");
+
+  // Only the slowest calls are kept, with what they created
+  auto slowCalls = stats->getSlowCalls();
+  ASSERT_EQ(2, slowCalls.size());
+  for (const auto& slowCall : slowCalls) {
+    EXPECT_EQ(SaiApiOperation::CREATE, slowCall.key.operation);
+    EXPECT_GE(slowCall.usecs, 500);
+    EXPECT_NE(std::string::npos, slowCall.summary.find("PacketAction"));
+  }
+  EXPECT_GE(slowCalls[0].usecs, slowCalls[1].usecs);
+
+  auto latencies = stats->getLatencies();
+  const auto& createLatency = latencies[SaiApiCallKey{
+      SAI_API_ROUTE, SAI_OBJECT_TYPE_ROUTE_ENTRY, SaiApiOperation::CREATE}];
+  EXPECT_EQ(3, createLatency.calls);
+  EXPECT_GE(createLatency.percentileUsecs(50), 500);
+}
+
+TEST_F(SaiApiCallStatsTest, slowListGetAfterBufferOverflow) {
+  FLAGS_sai_slow_call_usecs = 0;
+  FLAGS_sai_slow_calls_to_keep = 8;
+  VlanApi vlanApi;
+  auto vlanId = vlanApi.create<SaiVlanTraits>({42}, 0);
+  for (auto bridgePortId : {1, 2, 3}) {
+    vlanApi.create<SaiVlanMemberTraits>(
+        {SaiVlanMemberTraits::Attributes::VlanId{vlanId},
+         SaiVlanMemberTraits::Attributes::BridgePortId{
+             static_cast<sai_object_id_t>(bridgePortId)}},
+        0);
+  }
+  stats->clear();
+
+  // The first get is made with an empty list, so overflows, and must be
+  // summarized without the list the adapter claims to have filled in
+  auto members =
+      vlanApi.getAttribute(vlanId, SaiVlanTraits::Attributes::MemberList());
+  EXPECT_EQ(3, members.size());
+
+  auto slowCalls = stats->getSlowCalls();
+  ASSERT_EQ(2, slowCalls.size());
+  int idOnlySummaries = 0;
+  for (const auto& slowCall : slowCalls) {
+    EXPECT_EQ(SAI_OBJECT_TYPE_VLAN, slowCall.key.objectType);
+    EXPECT_EQ(SaiApiOperation::GET_ATTRIBUTE, slowCall.key.operation);
+    if (slowCall.summary.find("attribute id") != std::string::npos) {
+      ++idOnlySummaries;
+    }
+  }
+  EXPECT_EQ(1, idOnlySummaries);
+}
+
+TEST_F(SaiApiCallStatsTest, disabled) {
+  FLAGS_sai_api_call_stats = false;
+  createRoute("10.1.1.0");
+  EXPECT_TRUE(stats->getLatencies().empty());
+}
+
+TEST(SaiApiCallLatencyTest, buckets) {
+  EXPECT_EQ(0, SaiApiCallLatency::bucket(0));
+  EXPECT_EQ(1, SaiApiCallLatency::bucket(1));
+  EXPECT_EQ(2, SaiApiCallLatency::bucket(3));
+  EXPECT_EQ(11, SaiApiCallLatency::bucket(1024));
+  EXPECT_EQ(
+      SaiApiCallLatency::kNumBuckets - 1,
+      SaiApiCallLatency::bucket(std::numeric_limits<uint64_t>::max()));
+}
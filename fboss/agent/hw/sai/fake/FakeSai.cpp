@@ -8,11 +8,19 @@
  *
  */
 #include "FakeSai.h"
+#include "FakeSaiLatencyModel.h"
 
 #include <folly/FileUtil.h>
 #include <folly/Singleton.h>
 
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+DEFINE_string(
+    fake_sai_latency_profile,
+    "",
+    "JSON file with per object type latencies and table capacities for the "
+    "fake SAI to emulate. See FakeSaiLatencyModel.h for the format");
 
 namespace {
 struct singleton_tag_type {};
@@ -85,6 +93,15 @@ sai_status_t sai_api_initialize(
   if (fs->initialized) {
     return SAI_STATUS_FAILURE;
   }
+  if (!FLAGS_fake_sai_latency_profile.empty()) {
+    try {
+      facebook::fboss::FakeSaiLatencyModel::getInstance().loadProfile(
+          FLAGS_fake_sai_latency_profile);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Failed to load fake SAI latency profile: " << ex.what();
+      return SAI_STATUS_FAILURE;
+    }
+  }
   // Create the default switch per the SAI spec
   fs->switchManager.create();
   // Create the default 1Q bridge per the SAI spec
@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/hw/sai/fake/FakeSaiFdb.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
 
 #include "fboss/agent/hw/sai/api/AddressUtil.h"
 
@@ -17,11 +18,20 @@
 
 using facebook::fboss::FakeFdb;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiLatencyModel;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_fdb_entry_fn(
     const sai_fdb_entry_t* fdb_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_FDB_ENTRY, FakeSaiOp::CREATE, attr_count);
+  if (FakeSaiLatencyModel::getInstance().atCapacity(
+          SAI_OBJECT_TYPE_FDB_ENTRY,
+          FakeSai::getInstance()->fdbManager.map().size())) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   sai_object_id_t bridgePortId = 0;
@@ -48,6 +58,7 @@ sai_status_t create_fdb_entry_fn(
 }
 
 sai_status_t remove_fdb_entry_fn(const sai_fdb_entry_t* fdb_entry) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_FDB_ENTRY, FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   fs->fdbManager.remove(
@@ -58,6 +69,7 @@ sai_status_t remove_fdb_entry_fn(const sai_fdb_entry_t* fdb_entry) {
 sai_status_t set_fdb_entry_attribute_fn(
     const sai_fdb_entry_t* fdb_entry,
     const sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_FDB_ENTRY, FakeSaiOp::SET, 1);
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   auto fdbKey = std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac);
@@ -79,6 +91,7 @@ sai_status_t get_fdb_entry_attribute_fn(
     const sai_fdb_entry_t* fdb_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_FDB_ENTRY, FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   auto fdbKey = std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac);
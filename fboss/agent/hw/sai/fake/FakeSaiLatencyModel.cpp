@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
+
+#include <folly/FileUtil.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+
+#include <stdexcept>
+
+namespace {
+using facebook::fboss::FakeSaiOp;
+
+const std::unordered_map<std::string, sai_object_type_t>& objectTypes() {
+  static const std::unordered_map<std::string, sai_object_type_t> kTypes = {
+      {"fdb_entry", SAI_OBJECT_TYPE_FDB_ENTRY},
+      {"neighbor_entry", SAI_OBJECT_TYPE_NEIGHBOR_ENTRY},
+      {"next_hop", SAI_OBJECT_TYPE_NEXT_HOP},
+      {"next_hop_group", SAI_OBJECT_TYPE_NEXT_HOP_GROUP},
+      {"next_hop_group_member", SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER},
+      {"port", SAI_OBJECT_TYPE_PORT},
+      {"queue", SAI_OBJECT_TYPE_QUEUE},
+      {"route_entry", SAI_OBJECT_TYPE_ROUTE_ENTRY},
+  };
+  return kTypes;
+}
+
+const std::unordered_map<std::string, FakeSaiOp>& ops() {
+  static const std::unordered_map<std::string, FakeSaiOp> kOps = {
+      {"create", FakeSaiOp::CREATE},
+      {"remove", FakeSaiOp::REMOVE},
+      {"set", FakeSaiOp::SET},
+      {"get", FakeSaiOp::GET},
+      {"get_stats", FakeSaiOp::GET_STATS},
+  };
+  return kOps;
+}
+
+thread_local int fakeSaiCallDepth = 0;
+} // namespace
+
+namespace facebook::fboss {
+
+FakeSaiLatencyModel& FakeSaiLatencyModel::getInstance() {
+  static FakeSaiLatencyModel model;
+  return model;
+}
+
+void FakeSaiLatencyModel::loadProfile(const std::string& path) {
+  std::string json;
+  if (!folly::readFile(path.c_str(), json)) {
+    throw std::runtime_error("Unable to read fake SAI latency profile " + path);
+  }
+  loadProfileFromJson(json);
+  XLOG(INFO) << "Loaded fake SAI latency profile from " << path;
+}
+
+void FakeSaiLatencyModel::loadProfileFromJson(const std::string& json) {
+  auto toNsecs = [](const folly::dynamic& cost, const char* key) {
+    auto usecs = cost.getDefault(key, 0).asDouble();
+    return std::chrono::nanoseconds(static_cast<int64_t>(usecs * 1000));
+  };
+  std::unordered_map<sai_object_type_t, ObjectProfile> profiles;
+  for (const auto& [name, spec] : folly::parseJson(json).items()) {
+    auto typeItr = objectTypes().find(name.asString());
+    if (typeItr == objectTypes().end()) {
+      throw std::runtime_error(
+          "Unknown object type in fake SAI latency profile: " +
+          name.asString());
+    }
+    ObjectProfile profile;
+    for (const auto& [key, value] : spec.items()) {
+      if (key.asString() == "capacity") {
+        profile.capacity = value.asInt();
+        continue;
+      }
+      auto opItr = ops().find(key.asString());
+      if (opItr == ops().end()) {
+        throw std::runtime_error(
+            "Unknown op in fake SAI latency profile: " + key.asString());
+      }
+      auto& cost = profile.costs[static_cast<size_t>(opItr->second)];
+      cost.fixed = toNsecs(value, "fixed_usecs");
+      cost.perAttribute = toNsecs(value, "per_attr_usecs");
+    }
+    profiles.emplace(typeItr->second, profile);
+  }
+  profiles_ = std::move(profiles);
+}
+
+void FakeSaiLatencyModel::clear() {
+  profiles_.clear();
+}
+
+void FakeSaiLatencyModel::charge(
+    sai_object_type_t objectType,
+    FakeSaiOp op,
+    uint32_t attrCount) const {
+  auto itr = profiles_.find(objectType);
+  if (itr == profiles_.end()) {
+    return;
+  }
+  const auto& cost = itr->second.costs[static_cast<size_t>(op)];
+  auto latency = cost.fixed + cost.perAttribute * attrCount;
+  if (latency.count() == 0) {
+    return;
+  }
+  // Spin rather than sleep, sleeps are far too coarse for per call
+  // latencies of a few microseconds.
+  auto deadline = std::chrono::steady_clock::now() + latency;
+  while (std::chrono::steady_clock::now() < deadline) {
+  }
+}
+
+bool FakeSaiLatencyModel::atCapacity(
+    sai_object_type_t objectType,
+    size_t tableSize) const {
+  auto itr = profiles_.find(objectType);
+  return itr != profiles_.end() && itr->second.capacity &&
+      tableSize >= *itr->second.capacity;
+}
+
+FakeSaiCall::FakeSaiCall(
+    sai_object_type_t objectType,
+    FakeSaiOp op,
+    uint32_t attrCount) {
+  if (fakeSaiCallDepth++ == 0) {
+    FakeSaiLatencyModel::getInstance().charge(objectType, op, attrCount);
+  }
+}
+
+FakeSaiCall::~FakeSaiCall() {
+  --fakeSaiCallDepth;
+}
+
+} // namespace facebook::fboss
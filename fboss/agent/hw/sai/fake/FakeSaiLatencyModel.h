@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+enum class FakeSaiOp { CREATE, REMOVE, SET, GET, GET_STATS, NUM_OPS };
+
+/*
+ * Fake SAI calls normally complete instantly, which makes agent side
+ * programming benchmarks meaningless without an ASIC. A latency profile
+ * lets us charge each call a configurable cost instead, and cap table
+ * sizes, so those benchmarks can run against the fake SAI.
+ *
+ * The profile is a JSON file keyed by object type, e.g.
+ *
+ *   {
+ *     "route_entry": {
+ *       "create": {"fixed_usecs": 20, "per_attr_usecs": 2},
+ *       "remove": {"fixed_usecs": 15},
+ *       "capacity": 128000
+ *     },
+ *     "port": {"get_stats": {"fixed_usecs": 50, "per_attr_usecs": 1}}
+ *   }
+ *
+ * Valid ops are create, remove, set, get and get_stats. For get_stats the
+ * per attribute cost is charged per counter read. Object types and ops
+ * missing from the profile are free and unbounded.
+ */
+class FakeSaiLatencyModel {
+ public:
+  struct Cost {
+    std::chrono::nanoseconds fixed{0};
+    std::chrono::nanoseconds perAttribute{0};
+  };
+  struct ObjectProfile {
+    std::array<Cost, static_cast<size_t>(FakeSaiOp::NUM_OPS)> costs;
+    std::optional<size_t> capacity;
+  };
+
+  static FakeSaiLatencyModel& getInstance();
+
+  void loadProfile(const std::string& path);
+  void loadProfileFromJson(const std::string& json);
+  void clear();
+
+  /*
+   * Block the calling thread for the cost of the call. Fake SAI functions
+   * use FakeSaiCall rather than calling this directly, so that calls
+   * nested inside another fake SAI call are not charged twice.
+   */
+  void charge(sai_object_type_t objectType, FakeSaiOp op, uint32_t attrCount)
+      const;
+
+  // Whether a table already holding tableSize objects is full
+  bool atCapacity(sai_object_type_t objectType, size_t tableSize) const;
+
+ private:
+  std::unordered_map<sai_object_type_t, ObjectProfile> profiles_;
+};
+
+/*
+ * Charges the latency model for one fake SAI call on construction, unless
+ * constructed within the scope of another FakeSaiCall on the same thread
+ * (e.g. create functions applying their attributes through the set
+ * functions).
+ */
+class FakeSaiCall {
+ public:
+  FakeSaiCall(
+      sai_object_type_t objectType,
+      FakeSaiOp op,
+      uint32_t attrCount = 0);
+  ~FakeSaiCall();
+
+ private:
+  FakeSaiCall(const FakeSaiCall&) = delete;
+  FakeSaiCall& operator=(const FakeSaiCall&) = delete;
+};
+
+} // namespace facebook::fboss
@@ -9,6 +9,7 @@
  */
 #include "FakeSaiNeighbor.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
 
 #include "fboss/agent/hw/sai/api/AddressUtil.h"
 
@@ -17,11 +18,21 @@
 
 using facebook::fboss::FakeNeighbor;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiLatencyModel;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call(
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, FakeSaiOp::CREATE, attr_count);
+  if (FakeSaiLatencyModel::getInstance().atCapacity(
+          SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+          FakeSai::getInstance()->neighborManager.map().size())) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   std::optional<folly::MacAddress> dstMac;
@@ -50,6 +61,7 @@ sai_status_t create_neighbor_entry_fn(
 
 sai_status_t remove_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   fs->neighborManager.remove(
@@ -60,6 +72,7 @@ sai_status_t remove_neighbor_entry_fn(
 sai_status_t set_neighbor_entry_attribute_fn(
     const sai_neighbor_entry_t* neighbor_entry,
     const sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, FakeSaiOp::SET, 1);
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   auto n =
@@ -82,6 +95,7 @@ sai_status_t get_neighbor_entry_attribute_fn(
     const sai_neighbor_entry_t* neighbor_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   auto n =
@@ -8,6 +8,7 @@
  *
  */
 #include "FakeSai.h"
+#include "FakeSaiLatencyModel.h"
 #include "FakeSaiPort.h"
 #include "fboss/agent/hw/sai/api/AddressUtil.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
@@ -17,12 +18,21 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiLatencyModel;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_next_hop_fn(
     sai_object_id_t* next_hop_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP, FakeSaiOp::CREATE, attr_count);
+  if (FakeSaiLatencyModel::getInstance().atCapacity(
+          SAI_OBJECT_TYPE_NEXT_HOP,
+          FakeSai::getInstance()->nextHopManager.map().size())) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_next_hop_type_t> type;
   std::optional<folly::IPAddress> ip;
@@ -70,6 +80,7 @@ sai_status_t create_next_hop_fn(
 }
 
 sai_status_t remove_next_hop_fn(sai_object_id_t next_hop_id) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP, FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->nextHopManager.remove(next_hop_id);
   return SAI_STATUS_SUCCESS;
@@ -78,6 +89,7 @@ sai_status_t remove_next_hop_fn(sai_object_id_t next_hop_id) {
 sai_status_t set_next_hop_attribute_fn(
     sai_object_id_t /* next_hop_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP, FakeSaiOp::SET, 1);
   switch (attr->id) {
     default:
       return SAI_STATUS_INVALID_PARAMETER;
@@ -89,6 +101,7 @@ sai_status_t get_next_hop_attribute_fn(
     sai_object_id_t next_hop_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP, FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& nextHop = fs->nextHopManager.get(next_hop_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -10,6 +10,7 @@
 
 #include "FakeSaiNextHopGroup.h"
 #include "FakeSai.h"
+#include "FakeSaiLatencyModel.h"
 
 #include <folly/logging/xlog.h>
 #include <optional>
@@ -17,12 +18,22 @@
 using facebook::fboss::FakeNextHopGroup;
 using facebook::fboss::FakeNextHopGroupMember;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiLatencyModel;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_next_hop_group_fn(
     sai_object_id_t* next_hop_group_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call(
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP, FakeSaiOp::CREATE, attr_count);
+  if (FakeSaiLatencyModel::getInstance().atCapacity(
+          SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+          FakeSai::getInstance()->nextHopGroupManager.map().size())) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<int32_t> type;
   for (int i = 0; i < attr_count; ++i) {
@@ -46,6 +57,7 @@ sai_status_t create_next_hop_group_fn(
 }
 
 sai_status_t remove_next_hop_group_fn(sai_object_id_t next_hop_group_id) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->nextHopGroupManager.remove(next_hop_group_id);
   return SAI_STATUS_SUCCESS;
@@ -55,6 +67,7 @@ sai_status_t get_next_hop_group_attribute_fn(
     sai_object_id_t next_hop_group_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& nextHopGroup = fs->nextHopGroupManager.get(next_hop_group_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -85,6 +98,7 @@ sai_status_t get_next_hop_group_attribute_fn(
 sai_status_t set_next_hop_group_attribute_fn(
     sai_object_id_t /* next_hop_group_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, FakeSaiOp::SET, 1);
   switch (attr->id) {
     default:
       return SAI_STATUS_NOT_SUPPORTED;
@@ -97,6 +111,8 @@ sai_status_t create_next_hop_group_member_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call(
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, FakeSaiOp::CREATE, attr_count);
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> nextHopGroupId;
   std::optional<sai_object_id_t> nextHopId;
@@ -129,6 +145,7 @@ sai_status_t create_next_hop_group_member_fn(
 
 sai_status_t remove_next_hop_group_member_fn(
     sai_object_id_t next_hop_group_member_id) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->nextHopGroupManager.removeMember(next_hop_group_member_id);
   return SAI_STATUS_SUCCESS;
@@ -138,6 +155,8 @@ sai_status_t get_next_hop_group_member_attribute_fn(
     sai_object_id_t next_hop_group_member_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call(
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& nextHopGroupMember =
       fs->nextHopGroupManager.getMember(next_hop_group_member_id);
@@ -164,6 +183,7 @@ sai_status_t get_next_hop_group_member_attribute_fn(
 sai_status_t set_next_hop_group_member_attribute_fn(
     sai_object_id_t next_hop_group_member_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, FakeSaiOp::SET, 1);
   switch (attr->id) {
     default:
       return SAI_STATUS_NOT_SUPPORTED;
@@ -64,9 +64,11 @@ sai_status_t sai_get_object_count(
     case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
       *count = fs->neighborManager.map().size();
       break;
-    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY: {
+      std::lock_guard<std::mutex> g{facebook::fboss::fakeRouteLock()};
       *count = fs->routeManager.map().size();
       break;
+    }
     case SAI_OBJECT_TYPE_VLAN:
       *count = fs->vlanManager.map().size();
       break;
@@ -269,6 +271,7 @@ sai_status_t sai_get_object_key(
       break;
     }
     case SAI_OBJECT_TYPE_ROUTE_ENTRY: {
+      std::lock_guard<std::mutex> g{facebook::fboss::fakeRouteLock()};
       for (const auto& route : fs->routeManager.map()) {
         object_list[i].key.route_entry.switch_id = std::get<0>(route.first);
         object_list[i].key.route_entry.vr_id = std::get<1>(route.first);
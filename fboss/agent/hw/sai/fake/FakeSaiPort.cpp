@@ -10,12 +10,15 @@
 #include "FakeSaiPort.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
 
 #include <folly/logging/xlog.h>
 #include <optional>
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_port_fn(
     sai_object_id_t* port_id,
@@ -459,6 +462,7 @@ sai_status_t get_port_stats_fn(
     uint32_t num_of_counters,
     const sai_stat_id_t* /*counter_ids*/,
     uint64_t* counters) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_PORT, FakeSaiOp::GET_STATS, num_of_counters);
   for (auto i = 0; i < num_of_counters; ++i) {
     counters[i] = 0;
   }
@@ -9,12 +9,15 @@
  */
 #include "fboss/agent/hw/sai/fake/FakeSaiQueue.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
 
 #include <folly/logging/xlog.h>
 #include <optional>
 
 using facebook::fboss::FakeQueue;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_queue_fn(
     sai_object_id_t* queue_id,
@@ -150,6 +153,8 @@ sai_status_t get_queue_stats_fn(
     uint32_t num_of_counters,
     const sai_stat_id_t* /*counter_ids*/,
     uint64_t* counters) {
+  FakeSaiCall call(
+      SAI_OBJECT_TYPE_QUEUE, FakeSaiOp::GET_STATS, num_of_counters);
   for (auto i = 0; i < num_of_counters; ++i) {
     counters[i] = 0;
   }
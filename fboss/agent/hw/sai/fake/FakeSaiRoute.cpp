@@ -9,15 +9,22 @@
  */
 #include "FakeSaiRoute.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h"
 
 #include "fboss/agent/hw/sai/api/AddressUtil.h"
 
 #include <folly/logging/xlog.h>
 
+#include <mutex>
+
 using facebook::fboss::FakeRoute;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiLatencyModel;
+using facebook::fboss::FakeSaiOp;
 
-sai_status_t set_route_entry_attribute_fn(
+namespace {
+sai_status_t setRouteEntryAttribute(
     const sai_route_entry_t* route_entry,
     const sai_attribute_t* attr) {
   auto fs = FakeSai::getInstance();
@@ -41,11 +48,27 @@ sai_status_t set_route_entry_attribute_fn(
   }
   return SAI_STATUS_SUCCESS;
 }
+} // namespace
+
+sai_status_t set_route_entry_attribute_fn(
+    const sai_route_entry_t* route_entry,
+    const sai_attribute_t* attr) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::SET, 1);
+  std::lock_guard<std::mutex> g{facebook::fboss::fakeRouteLock()};
+  return setRouteEntryAttribute(route_entry, attr);
+}
 
 sai_status_t create_route_entry_fn(
     const sai_route_entry_t* route_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::CREATE, attr_count);
+  std::lock_guard<std::mutex> g{facebook::fboss::fakeRouteLock()};
+  if (FakeSaiLatencyModel::getInstance().atCapacity(
+          SAI_OBJECT_TYPE_ROUTE_ENTRY,
+          FakeSai::getInstance()->routeManager.map().size())) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -53,12 +76,14 @@ sai_status_t create_route_entry_fn(
       facebook::fboss::fromSaiIpPrefix(route_entry->destination));
   fs->routeManager.create(re);
   for (int i = 0; i < attr_count; ++i) {
-    set_route_entry_attribute_fn(route_entry, &attr_list[i]);
+    setRouteEntryAttribute(route_entry, &attr_list[i]);
   }
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_route_entry_fn(const sai_route_entry_t* route_entry) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::REMOVE);
+  std::lock_guard<std::mutex> g{facebook::fboss::fakeRouteLock()};
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -74,6 +99,8 @@ sai_status_t get_route_entry_attribute_fn(
     const sai_route_entry_t* route_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call(SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::GET, attr_count);
+  std::lock_guard<std::mutex> g{facebook::fboss::fakeRouteLock()};
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -100,6 +127,13 @@ sai_status_t get_route_entry_attribute_fn(
 
 namespace facebook::fboss {
 
+std::mutex& fakeRouteLock() {
+  // Latency is charged before taking it, so that concurrent calls overlap
+  // their latency
+  static std::mutex routeLock;
+  return routeLock;
+}
+
 static sai_route_api_t _route_api;
 
 void populate_route_api(sai_route_api_t** route_api) {
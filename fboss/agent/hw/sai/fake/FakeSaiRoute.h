@@ -14,6 +14,7 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 
+#include <mutex>
 #include <tuple>
 
 extern "C" {
@@ -32,6 +33,13 @@ using FakeRouteEntry =
     std::tuple<sai_object_id_t, sai_object_id_t, folly::CIDRNetwork>;
 using FakeRouteManager = FakeManager<FakeRouteEntry, FakeRoute>;
 
+/*
+ * Route entry functions may be called concurrently (see
+ * SaiPlatform::isRouteApiThreadSafe), so route entries are only accessed
+ * while holding this lock.
+ */
+std::mutex& fakeRouteLock();
+
 void populate_route_api(sai_route_api_t** route_api);
 
 } // namespace facebook::fboss
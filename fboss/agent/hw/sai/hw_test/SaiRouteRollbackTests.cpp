@@ -10,14 +10,23 @@
 
 #include "fboss/agent/hw/sai/hw_test/SaiRollbackTest.h"
 
+#include "fboss/agent/hw/sai/switch/SaiRouteManager.h"
+#include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 #include "fboss/agent/hw/test/HwTestEcmpUtils.h"
 #include "fboss/agent/hw/test/HwTestRouteUtils.h"
+#include "fboss/agent/state/RouteTable.h"
+#include "fboss/agent/state/RouteTableMap.h"
 #include "fboss/agent/state/RouteTypes.h"
 #include "fboss/agent/test/EcmpSetupHelper.h"
+#include "fboss/agent/test/RouteDistributionGenerator.h"
 
 #include <folly/IPAddress.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/ScopeGuard.h>
+#include <folly/logging/xlog.h>
+
+#include <chrono>
 
 namespace {
 constexpr auto kEcmpWidth = 2;
@@ -173,4 +182,59 @@ TEST_F(SaiRouteRollbackTest, rollbackEcmp) {
 TEST_F(SaiRouteRollbackTest, rollbackManyTimes) {
   runTest(true, true, 10);
 }
+
+TEST_F(SaiRouteRollbackTest, rollbackFailedScaleTransaction) {
+  auto verify = [this]() {
+    constexpr auto kNumRoutes = 50'000;
+    const RouterID kRouterID(0);
+    auto generator = utility::RouteDistributionGenerator(
+        getProgrammedState(),
+        {{64, kNumRoutes}},
+        {},
+        kNumRoutes,
+        kEcmpWidth,
+        kRouterID);
+    const auto& routeChunk = generator.get().front();
+    const auto& states = generator.getSwitchStates();
+    auto nhopsResolvedState = applyNewState(states.front());
+    const auto& desiredState = states.back();
+
+    // Inject a failure midway through the transaction by programming one of
+    // its routes behind the transaction's back, so adding it again throws.
+    const auto& failNetwork = routeChunk[kNumRoutes / 2].prefix;
+    auto failRoute = desiredState->getRouteTables()
+                         ->getRouteTable(kRouterID)
+                         ->getRibV6()
+                         ->exactMatch(RoutePrefixV6{
+                             failNetwork.first.asV6(), failNetwork.second});
+    ASSERT_NE(failRoute, nullptr);
+    auto& routeManager =
+        static_cast<SaiSwitch*>(getHwSwitch())->managerTable()->routeManager();
+    routeManager.addRoute(failRoute, kRouterID);
+
+    getHwSwitchEnsemble()->setAllowPartialStateApplication(true);
+    SCOPE_EXIT {
+      getHwSwitchEnsemble()->setAllowPartialStateApplication(false);
+    };
+    auto begin = std::chrono::steady_clock::now();
+    auto appliedState = applyNewStateTransaction(desiredState);
+    XLOG(INFO) << "Failed transaction of " << kNumRoutes
+               << " routes applied and rolled back in "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - begin)
+                      .count()
+               << "ms";
+    EXPECT_EQ(appliedState, nhopsResolvedState);
+    routeManager.removeRoute(failRoute, kRouterID);
+
+    for (const auto& route : {routeChunk.front(), routeChunk.back()}) {
+      EXPECT_THROW(
+          utility::getEcmpMembersInHw(
+              getHwSwitch(), route.prefix, kRouterID, kEcmpWidth),
+          FbossError);
+    }
+    verifyInvariants();
+  };
+  verifyAcrossWarmBoots([]() {}, verify);
+}
 } // namespace facebook::fboss
@@ -10,8 +10,20 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include <folly/Function.h>
 #include <folly/Singleton.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    1,
+    "Number of threads used to reload SaiStore object types concurrently. "
+    "1 reloads them sequentially");
+
 namespace {
 struct singleton_tag_type {};
 } // namespace
@@ -39,18 +51,74 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  std::vector<folly::Function<void()>> reloadFns;
+  tupleForEach(
+      [adapterKeysJson, adapterKeys2AdapterHostKeyJson, &reloadFns](
+          auto& store) {
+        reloadFns.emplace_back(
+            [adapterKeysJson, adapterKeys2AdapterHostKeyJson, &store]() {
+              const folly::dynamic* adapterKeys = adapterKeysJson
+                  ? adapterKeysJson->get_ptr(store.objectTypeName())
+                  : nullptr;
+              const folly::dynamic* adapterHostKeys =
+                  adapterKeys2AdapterHostKeyJson
+                  ? adapterKeys2AdapterHostKeyJson->get_ptr(
+                        store.objectTypeName())
+                  : nullptr;
+
+              store.reload(adapterKeys, adapterHostKeys);
+            });
+      },
+      stores_);
+
+  auto numThreads = std::min(
+      static_cast<size_t>(std::max(FLAGS_sai_store_reload_threads, 1)),
+      reloadFns.size());
+  if (numThreads <= 1) {
+    for (auto& reloadFn : reloadFns) {
+      reloadFn();
+    }
+  } else {
+    // Workers pull the next store to reload, so a single large store (e.g.
+    // routes) does not hold up the others queued behind it
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(reloadFns.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < numThreads; ++i) {
+      workers.emplace_back([&reloadFns, &next, &errors]() {
+        for (auto idx = next++; idx < reloadFns.size(); idx = next++) {
+          try {
+            reloadFns[idx]();
+          } catch (...) {
+            errors[idx] = std::current_exception();
+          }
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    for (const auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+  for (const auto& [objectType, duration] : reloadDurations()) {
+    XLOG(DBG2) << "SaiStore reloaded " << objectType << " in "
+               << duration.count() << " usecs";
+  }
+}
+
+std::map<std::string, std::chrono::microseconds> SaiStore::reloadDurations()
+    const {
+  std::map<std::string, std::chrono::microseconds> durations;
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
-        const folly::dynamic* adapterKeys = adapterKeysJson
-            ? adapterKeysJson->get_ptr(store.objectTypeName())
-            : nullptr;
-        const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
-            ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
-            : nullptr;
-
-        store.reload(adapterKeys, adapterHostKeys);
+      [&durations](const auto& store) {
+        durations[store.objectTypeName().str()] += store.reloadDuration();
       },
       stores_);
+  return durations;
 }
 
 void SaiStore::release() {
@@ -21,8 +21,12 @@
 #include "fboss/lib/RefMap.h"
 
 #include <folly/dynamic.h>
+#include <gflags/gflags.h>
 
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <type_traits>
@@ -31,6 +35,8 @@ extern "C" {
 #include <sai.h>
 }
 
+DECLARE_int32(sai_store_reload_threads);
+
 namespace facebook::fboss {
 
 inline constexpr auto kAdapterKey2AdapterHostKey = "adapterKey2AdapterHostKey";
@@ -117,6 +123,7 @@ class SaiObjectStore {
       XLOG(FATAL)
           << "Attempted to reload() on a SaiObjectStore without a switchId";
     }
+    auto begin = std::chrono::steady_clock::now();
     auto keys = getAdapterKeys(adapterKeysJson);
     if constexpr (SaiObjectHasConditionalAttributes<SaiObjectTraits>::value) {
       keys.erase(
@@ -147,6 +154,13 @@ class SaiObjectStore {
       }
       warmBootHandles_.emplace(adapterHostKey, ins.first);
     }
+    reloadDuration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin);
+  }
+
+  // Time taken by the last reload(), zero if never reloaded
+  std::chrono::microseconds reloadDuration() const {
+    return reloadDuration_;
   }
 
   std::shared_ptr<ObjectType> setObject(
@@ -333,20 +347,31 @@ class SaiObjectStore {
     return ObjectType(key);
   }
 
+  /*
+   * Objects with different adapter host keys may be programmed concurrently:
+   * the SAI calls are made without holding programLock_, which only guards
+   * the maps. Nothing else in the store may run at the same time.
+   */
   std::pair<std::shared_ptr<ObjectType>, bool> program(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
       const typename SaiObjectTraits::CreateAttributes& attributes) {
-    auto existingObj = objects_.ref(adapterHostKey);
-    auto ins = existingObj
-        ? std::make_pair(existingObj, false)
-        : objects_.refOrInsert(
-              adapterHostKey,
-              ObjectType(adapterHostKey, attributes, switchId_.value()),
-              true /*force*/);
-    if (!ins.second) {
-      ins.first->setAttributes(attributes);
+    std::shared_ptr<ObjectType> existingObj;
+    {
+      std::lock_guard<std::mutex> g{programLock_};
+      existingObj = objects_.ref(adapterHostKey);
+    }
+    std::pair<std::shared_ptr<ObjectType>, bool> ins;
+    if (existingObj) {
+      existingObj->setAttributes(attributes);
+      ins = std::make_pair(existingObj, false);
+    } else {
+      ObjectType obj(adapterHostKey, attributes, switchId_.value());
+      std::lock_guard<std::mutex> g{programLock_};
+      ins = objects_.refOrInsert(
+          adapterHostKey, std::move(obj), true /*force*/);
     }
     auto notify = ins.second;
+    std::lock_guard<std::mutex> g{programLock_};
     auto iter = warmBootHandles_.find(adapterHostKey);
     if (iter != warmBootHandles_.end()) {
       warmBootHandles_.erase(iter);
@@ -382,6 +407,8 @@ class SaiObjectStore {
       typename SaiObjectTraits::AdapterHostKey,
       std::shared_ptr<ObjectType>>
       warmBootHandles_;
+  std::chrono::microseconds reloadDuration_{0};
+  std::mutex programLock_;
 };
 
 /*
@@ -417,11 +444,25 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   *
+   * Each SaiObjectStore reloads only its own object type, referring to
+   * other objects by SAI id alone, so the stores have no dependencies on
+   * each other and are reloaded concurrently when
+   * --sai_store_reload_threads is more than 1. SAI calls themselves are
+   * still serialized by SaiApiLock; the concurrency overlaps the store side
+   * work (key parsing, adapter host key construction, store insertion) with
+   * the SAI calls of other object types.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
       const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
 
+  /*
+   * Time taken by the last reload() per SAI object type. Object types
+   * backed by several stores (e.g. ip and mpls next hops) report the sum.
+   */
+  std::map<std::string, std::chrono::microseconds> reloadDurations() const;
+
   /*
    *
    */
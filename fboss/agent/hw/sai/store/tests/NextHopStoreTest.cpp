@@ -14,6 +14,8 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/store/tests/SaiStoreTest.h"
 
+#include <folly/ScopeGuard.h>
+
 using namespace facebook::fboss;
 
 class NextHopStoreTest : public SaiStoreTest {
@@ -64,6 +66,36 @@ TEST_F(NextHopStoreTest, loadNextHops) {
   EXPECT_EQ(mplsNhop->adapterKey(), nextHopSaiId4);
 }
 
+TEST_F(NextHopStoreTest, loadNextHopsConcurrently) {
+  folly::IPAddress ip1{"4200::41"};
+  folly::IPAddress ip2{"4200::42"};
+  auto nextHopSaiId1 = createNextHop(ip1);
+  auto nextHopSaiId2 =
+      createMplsNextHop(ip2, std::vector<sai_uint32_t>{2001, 2002});
+
+  auto prevThreads = FLAGS_sai_store_reload_threads;
+  FLAGS_sai_store_reload_threads = 4;
+  SCOPE_EXIT {
+    FLAGS_sai_store_reload_threads = prevThreads;
+  };
+  SaiStore s(0);
+  s.reload();
+
+  SaiIpNextHopTraits::AdapterHostKey k1{42, ip1};
+  auto got = s.get<SaiIpNextHopTraits>().get(k1);
+  ASSERT_NE(got, nullptr);
+  EXPECT_EQ(got->adapterKey(), nextHopSaiId1);
+  SaiMplsNextHopTraits::AdapterHostKey k2{
+      42, ip2, std::vector<sai_uint32_t>{2001, 2002}};
+  auto mplsNhop = s.get<SaiMplsNextHopTraits>().get(k2);
+  ASSERT_NE(mplsNhop, nullptr);
+  EXPECT_EQ(mplsNhop->adapterKey(), nextHopSaiId2);
+
+  auto durations = s.reloadDurations();
+  EXPECT_EQ(
+      durations.count(s.get<SaiIpNextHopTraits>().objectTypeName().str()), 1);
+}
+
 TEST_F(NextHopStoreTest, nextHopLoadCtor) {
   auto ip = folly::IPAddress("::");
   auto nextHopSaiId = createNextHop(ip);
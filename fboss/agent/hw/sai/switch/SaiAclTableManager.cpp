@@ -22,6 +22,31 @@
 
 #include <folly/MacAddress.h>
 
+namespace {
+using facebook::fboss::SaiAclEntryTraits;
+
+template <typename... AttrTs>
+bool sameAttributes(
+    const SaiAclEntryTraits::CreateAttributes& lhs,
+    const SaiAclEntryTraits::CreateAttributes& rhs) {
+  return (
+      (std::get<std::optional<AttrTs>>(lhs) ==
+       std::get<std::optional<AttrTs>>(rhs)) &&
+      ...);
+}
+
+// true if any of the attributes is set in oldAttrs but not in newAttrs
+template <typename... AttrTs>
+bool anyAttributeUnset(
+    const SaiAclEntryTraits::CreateAttributes& oldAttrs,
+    const SaiAclEntryTraits::CreateAttributes& newAttrs) {
+  return (
+      (std::get<std::optional<AttrTs>>(oldAttrs).has_value() &&
+       !std::get<std::optional<AttrTs>>(newAttrs).has_value()) ||
+      ...);
+}
+} // namespace
+
 namespace facebook::fboss {
 
 SaiAclTableManager::SaiAclTableManager(
@@ -452,9 +477,20 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
         "attempted to add a duplicate aclEntry: ", addedAclEntry->getID());
   }
 
-  std::shared_ptr<SaiStore> s = SaiStore::getInstance();
-  auto& aclEntryStore = s->get<SaiAclEntryTraits>();
+  auto saiAclEntryInfo = makeSaiAclEntryInfo(addedAclEntry, aclTableHandle);
+  if (!saiAclEntryInfo) {
+    return AclEntrySaiId{0};
+  }
+  return programAclEntry(
+      addedAclEntry->getPriority(),
+      aclTableHandle,
+      std::move(saiAclEntryInfo.value()));
+}
 
+std::optional<SaiAclTableManager::SaiAclEntryInfo>
+SaiAclTableManager::makeSaiAclEntryInfo(
+    const std::shared_ptr<AclEntry>& addedAclEntry,
+    const SaiAclTableHandle* aclTableHandle) {
   SaiAclEntryTraits::Attributes::TableId aclTableId{
       aclTableHandle->aclTable->adapterKey()};
   SaiAclEntryTraits::Attributes::Priority priority{
@@ -811,7 +847,7 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
          aclActionMirrorEgress.has_value()))) {
     XLOG(DBG)
         << "Unsupported field/action for aclEntry: addedAclEntry->getID())";
-    return AclEntrySaiId{0};
+    return std::nullopt;
   }
 
   SaiAclEntryTraits::AdapterHostKey adapterHostKey{aclTableId, priority};
@@ -849,17 +885,38 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
       aclActionMirrorEgress,
   };
 
-  auto saiAclEntry = aclEntryStore.setObject(adapterHostKey, attributes);
-  auto entryHandle = std::make_unique<SaiAclEntryHandle>();
+  return SaiAclEntryInfo{
+      adapterHostKey, attributes, saiAclCounter, ingressMirror, egressMirror};
+}
+
+AclEntrySaiId SaiAclTableManager::programAclEntry(
+    int priority,
+    SaiAclTableHandle* aclTableHandle,
+    SaiAclEntryInfo&& saiAclEntryInfo) {
+  std::shared_ptr<SaiStore> s = SaiStore::getInstance();
+  auto& aclEntryStore = s->get<SaiAclEntryTraits>();
+
+  /*
+   * If an entry with the same adapter host key (table, priority) is still
+   * programmed, the store diffs the attributes and only sets the ones that
+   * changed. Otherwise, a new entry is created.
+   */
+  auto saiAclEntry = aclEntryStore.setObject(
+      saiAclEntryInfo.adapterHostKey, saiAclEntryInfo.attributes);
+  auto& entryHandle = aclTableHandle->aclTableMembers[priority];
+  if (!entryHandle) {
+    entryHandle = std::make_unique<SaiAclEntryHandle>();
+  }
   entryHandle->aclEntry = saiAclEntry;
-  entryHandle->aclCounter = saiAclCounter;
-  entryHandle->ingressMirror = ingressMirror;
-  entryHandle->egressMirror = egressMirror;
-  auto [it, inserted] = aclTableHandle->aclTableMembers.emplace(
-      addedAclEntry->getPriority(), std::move(entryHandle));
-  CHECK(inserted);
+  /*
+   * Replace the counter only after the entry stopped referring to the old
+   * one, else removing the old counter fails with SAI_STATUS_OBJECT_IN_USE.
+   */
+  entryHandle->aclCounter = std::move(saiAclEntryInfo.aclCounter);
+  entryHandle->ingressMirror = std::move(saiAclEntryInfo.ingressMirror);
+  entryHandle->egressMirror = std::move(saiAclEntryInfo.egressMirror);
 
-  return it->second->aclEntry->adapterKey();
+  return entryHandle->aclEntry->adapterKey();
 }
 
 void SaiAclTableManager::removeAclEntry(
@@ -889,12 +946,88 @@ void SaiAclTableManager::changedAclEntry(
     const std::shared_ptr<AclEntry>& oldAclEntry,
     const std::shared_ptr<AclEntry>& newAclEntry,
     const std::string& aclTableName) {
-  /*
-   * ASIC/SAI implementation typically does not allow modifying an ACL entry.
-   * Thus, remove and re-add.
-   */
-  removeAclEntry(oldAclEntry, aclTableName);
-  addAclEntry(newAclEntry, aclTableName);
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  if (!aclTableHandle) {
+    throw FbossError(
+        "attempted to change AclEntry in a AclTable that does not exist: ",
+        aclTableName);
+  }
+
+  auto itr = aclTableHandle->aclTableMembers.find(oldAclEntry->getPriority());
+  if (oldAclEntry->getPriority() != newAclEntry->getPriority() ||
+      itr == aclTableHandle->aclTableMembers.end()) {
+    removeAclEntry(oldAclEntry, aclTableName);
+    addAclEntry(newAclEntry, aclTableName);
+    ++aclEntriesRecreated_;
+    return;
+  }
+
+  auto saiAclEntryInfo = makeSaiAclEntryInfo(newAclEntry, aclTableHandle);
+  if (!saiAclEntryInfo) {
+    // new entry has no supported field/action, same as addAclEntry
+    aclTableHandle->aclTableMembers.erase(itr);
+    ++aclEntriesRecreated_;
+    return;
+  }
+
+  if (!aclEntryUpdatableInPlace(
+          itr->second->aclEntry->attributes(), saiAclEntryInfo->attributes)) {
+    /*
+     * Qualifiers are part of the TCAM key and ASIC/SAI implementations
+     * typically do not allow modifying them. Also, SAI has no way to unset
+     * an action once set. Thus, remove and re-add.
+     */
+    aclTableHandle->aclTableMembers.erase(itr);
+    ++aclEntriesRecreated_;
+  } else {
+    ++aclEntriesUpdatedInPlace_;
+  }
+  programAclEntry(
+      newAclEntry->getPriority(),
+      aclTableHandle,
+      std::move(saiAclEntryInfo.value()));
+}
+
+bool SaiAclTableManager::aclEntryUpdatableInPlace(
+    const SaiAclEntryTraits::CreateAttributes& oldAttributes,
+    const SaiAclEntryTraits::CreateAttributes& newAttributes) const {
+  using Attributes = SaiAclEntryTraits::Attributes;
+  if (std::get<Attributes::TableId>(oldAttributes) !=
+      std::get<Attributes::TableId>(newAttributes)) {
+    return false;
+  }
+  auto sameQualifiers = sameAttributes<
+      Attributes::Priority,
+      Attributes::FieldSrcIpV6,
+      Attributes::FieldDstIpV6,
+      Attributes::FieldSrcIpV4,
+      Attributes::FieldDstIpV4,
+      Attributes::FieldSrcPort,
+      Attributes::FieldOutPort,
+      Attributes::FieldL4SrcPort,
+      Attributes::FieldL4DstPort,
+      Attributes::FieldIpProtocol,
+      Attributes::FieldTcpFlags,
+      Attributes::FieldIpFrag,
+      Attributes::FieldIcmpV4Type,
+      Attributes::FieldIcmpV4Code,
+      Attributes::FieldIcmpV6Type,
+      Attributes::FieldIcmpV6Code,
+      Attributes::FieldDscp,
+      Attributes::FieldDstMac,
+      Attributes::FieldIpType,
+      Attributes::FieldTtl,
+      Attributes::FieldFdbDstUserMeta,
+      Attributes::FieldRouteDstUserMeta,
+      Attributes::FieldNeighborDstUserMeta>(oldAttributes, newAttributes);
+  auto actionUnset = anyAttributeUnset<
+      Attributes::ActionPacketAction,
+      Attributes::ActionCounter,
+      Attributes::ActionSetTC,
+      Attributes::ActionSetDSCP,
+      Attributes::ActionMirrorIngress,
+      Attributes::ActionMirrorEgress>(oldAttributes, newAttributes);
+  return sameQualifiers && !actionUnset;
 }
 
 const SaiAclEntryHandle* FOLLY_NULLABLE SaiAclTableManager::getAclEntryHandle(
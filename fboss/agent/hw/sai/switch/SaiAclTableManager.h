@@ -141,7 +141,43 @@ class SaiAclTableManager {
       const std::optional<std::string>& mirrorId,
       MirrorAction action);
 
+  /*
+   * Number of changed ACL entries whose new actions were programmed in place
+   * vs. those which had to be removed and re-added.
+   */
+  uint64_t getAclEntriesUpdatedInPlace() const {
+    return aclEntriesUpdatedInPlace_;
+  }
+  uint64_t getAclEntriesRecreated() const {
+    return aclEntriesRecreated_;
+  }
+
  private:
+  struct SaiAclEntryInfo {
+    SaiAclEntryTraits::AdapterHostKey adapterHostKey;
+    SaiAclEntryTraits::CreateAttributes attributes;
+    std::shared_ptr<SaiAclCounter> aclCounter;
+    std::optional<std::string> ingressMirror;
+    std::optional<std::string> egressMirror;
+  };
+
+  std::optional<SaiAclEntryInfo> makeSaiAclEntryInfo(
+      const std::shared_ptr<AclEntry>& addedAclEntry,
+      const SaiAclTableHandle* aclTableHandle);
+
+  AclEntrySaiId programAclEntry(
+      int priority,
+      SaiAclTableHandle* aclTableHandle,
+      SaiAclEntryInfo&& saiAclEntryInfo);
+
+  /*
+   * An entry can be updated in place only if its table, priority and
+   * qualifiers are unchanged, and no action goes from set to unset.
+   */
+  bool aclEntryUpdatableInPlace(
+      const SaiAclEntryTraits::CreateAttributes& oldAttributes,
+      const SaiAclEntryTraits::CreateAttributes& newAttributes) const;
+
   SaiAclTableHandle* FOLLY_NULLABLE
   getAclTableHandleImpl(const std::string& aclTableName) const;
 
@@ -198,6 +234,9 @@ class SaiAclTableManager {
   const sai_uint32_t neighborDstUserMetaDataRangeMin_;
   const sai_uint32_t neighborDstUserMetaDataRangeMax_;
   const sai_uint32_t neighborDstUserMetaDataMask_;
+
+  uint64_t aclEntriesUpdatedInPlace_{0};
+  uint64_t aclEntriesRecreated_{0};
 };
 
 } // namespace facebook::fboss
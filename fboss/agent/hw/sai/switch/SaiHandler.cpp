@@ -9,6 +9,8 @@
  */
 #include "fboss/agent/hw/sai/switch/SaiHandler.h"
 
+#include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiCallStats.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 
 #include <folly/logging/xlog.h>
@@ -56,4 +58,43 @@ void SaiHandler::diagCmd(
   result = diagCmdServer_.diagCmd(std::move(cmd), std::move(client));
 }
 
+namespace {
+template <typename StatT>
+void setCallKey(StatT& stat, const SaiApiCallKey& key) {
+  stat.api_ref() = saiApiTypeToString(key.api).str();
+  if (key.objectType != SAI_OBJECT_TYPE_NULL) {
+    stat.objectType_ref() = saiObjectTypeToString(key.objectType).str();
+  }
+  stat.operation_ref() = saiApiOperationToString(key.operation).str();
+}
+} // namespace
+
+void SaiHandler::getSaiCallStats(SaiCallStats& stats) {
+  auto callStats = SaiApiCallStats::getInstance();
+  if (!callStats) {
+    return;
+  }
+  for (const auto& [key, latency] : callStats->getLatencies()) {
+    SaiCallLatency callLatency;
+    setCallKey(callLatency, key);
+    callLatency.calls_ref() = latency.calls;
+    callLatency.totalUsecs_ref() = latency.totalUsecs;
+    callLatency.maxUsecs_ref() = latency.maxUsecs;
+    for (size_t i = 0; i < SaiApiCallLatency::kNumBuckets; ++i) {
+      if (latency.buckets[i]) {
+        (*callLatency.histogram_ref())
+            [SaiApiCallLatency::bucketUpperBoundUsecs(i)] = latency.buckets[i];
+      }
+    }
+    stats.latencies_ref()->push_back(std::move(callLatency));
+  }
+  for (const auto& slowCall : callStats->getSlowCalls()) {
+    SaiSlowCall call;
+    setCallKey(call, slowCall.key);
+    call.usecs_ref() = slowCall.usecs;
+    call.summary_ref() = slowCall.summary;
+    stats.slowestCalls_ref()->push_back(std::move(call));
+  }
+}
+
 } // namespace facebook::fboss
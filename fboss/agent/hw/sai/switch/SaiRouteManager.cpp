@@ -10,6 +10,7 @@
 
 #include "fboss/agent/hw/sai/switch/SaiRouteManager.h"
 
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
 #include "fboss/agent/hw/sai/switch/SaiNextHopGroupManager.h"
@@ -21,8 +22,52 @@
 
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <exception>
 #include <optional>
 
+DEFINE_int32(
+    sai_route_programming_threads,
+    1,
+    "Number of threads programming the route entries of a state update "
+    "concurrently, on adapters whose route api is thread safe. 1 programs "
+    "them sequentially");
+
+namespace {
+using namespace facebook::fboss;
+
+// Smaller batches are not worth handing off to another thread
+constexpr size_t kMinRouteChangesPerThread = 64;
+
+struct PendingRouteChange {
+  enum class Kind { NONE, ADD, CHANGE, REMOVE };
+  Kind kind{Kind::NONE};
+  SaiRouteTraits::RouteEntry entry;
+  SaiRouteHandle* handle{nullptr};
+  std::optional<SaiRouteTraits::CreateAttributes> attributes;
+  SaiRouteHandle::NextHopHandle nextHopHandle;
+  // The route programmed, or for removals the route to remove
+  std::shared_ptr<SaiRoute> route;
+  bool applied{false};
+  std::exception_ptr error;
+};
+
+void programPendingRoute(PendingRouteChange& change) {
+  if (change.kind == PendingRouteChange::Kind::REMOVE) {
+    // Only the route entry is removed here: the handle, and the next hops
+    // it holds on to, are released by the caller
+    SaiApiTable::getInstance()->routeApi().remove(change.route->adapterKey());
+    change.route->release();
+  } else {
+    auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
+    change.route = store.setObject(change.entry, change.attributes.value());
+  }
+}
+} // namespace
+
 namespace facebook::fboss {
 
 sai_object_id_t SaiRouteHandle::nextHopAdapterKey() const {
@@ -43,7 +88,33 @@ std::shared_ptr<SaiNextHopGroupHandle> SaiRouteHandle::nextHopGroupHandle()
 SaiRouteManager::SaiRouteManager(
     SaiManagerTable* managerTable,
     const SaiPlatform* platform)
-    : managerTable_(managerTable), platform_(platform) {}
+    : managerTable_(managerTable), platform_(platform) {
+  // Route api calls only skip the global SaiApiLock when they may actually
+  // be made concurrently
+  auto concurrent = FLAGS_sai_route_programming_threads > 1 &&
+      platform_->isRouteApiThreadSafe();
+  SaiApiLock::getInstance()->setConcurrentApi(SAI_API_ROUTE, concurrent);
+  if (concurrent) {
+    routeProgrammingExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sai_route_programming_threads,
+        std::make_shared<folly::NamedThreadFactory>("SaiRouteProgramming"));
+  }
+}
+
+bool SaiRouteManager::concurrentRouteProgramming() const {
+  return routeProgrammingExecutor_ != nullptr;
+}
+
+size_t SaiRouteManager::routeProgrammingThreads(size_t numChanges) const {
+  if (!concurrentRouteProgramming()) {
+    return 1;
+  }
+  return std::max(
+      std::min(
+          routeProgrammingExecutor_->numThreads(),
+          numChanges / kMinRouteChangesPerThread),
+      size_t(1));
+}
 
 template <typename AddrT>
 SaiRouteTraits::RouteEntry SaiRouteManager::routeEntryFromSwRoute(
@@ -129,12 +200,11 @@ bool SaiRouteManager::validRoute(const std::shared_ptr<Route<AddrT>>& swRoute) {
 }
 
 template <typename AddrT>
-void SaiRouteManager::addOrUpdateRoute(
-    SaiRouteHandle* routeHandle,
-    RouterID routerId,
+std::pair<SaiRouteTraits::CreateAttributes, SaiRouteHandle::NextHopHandle>
+SaiRouteManager::resolveRoute(
+    const SaiRouteTraits::RouteEntry& entry,
     const std::shared_ptr<Route<AddrT>>& oldRoute,
     const std::shared_ptr<Route<AddrT>>& newRoute) {
-  SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, newRoute);
   auto fwd = newRoute->getForwardInfo();
   sai_int32_t packetAction;
   std::optional<SaiRouteTraits::CreateAttributes> attributes;
@@ -246,8 +316,19 @@ void SaiRouteManager::addOrUpdateRoute(
     attributes = SaiRouteTraits::CreateAttributes{
         packetAction, SAI_NULL_OBJECT_ID, metadata};
   }
+  return std::make_pair(attributes.value(), std::move(nextHopHandle));
+}
+
+template <typename AddrT>
+void SaiRouteManager::addOrUpdateRoute(
+    SaiRouteHandle* routeHandle,
+    RouterID routerId,
+    const std::shared_ptr<Route<AddrT>>& oldRoute,
+    const std::shared_ptr<Route<AddrT>>& newRoute) {
+  SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, newRoute);
+  auto [attributes, nextHopHandle] = resolveRoute(entry, oldRoute, newRoute);
   auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
-  auto route = store.setObject(entry, attributes.value());
+  auto route = store.setObject(entry, attributes);
   routeHandle->route = route;
   routeHandle->nexthopHandle_ = nextHopHandle;
 }
@@ -303,6 +384,141 @@ void SaiRouteManager::removeRoute(
   }
 }
 
+template <typename AddrT>
+void SaiRouteManager::programRoute(
+    const SaiRouteChange<AddrT>& change,
+    RouterID routerId) {
+  if (!change.oldRoute) {
+    addRoute(change.newRoute, routerId);
+  } else if (!change.newRoute) {
+    removeRoute(change.oldRoute, routerId);
+  } else {
+    changeRoute(change.oldRoute, change.newRoute, routerId);
+  }
+}
+
+template <typename AddrT>
+void SaiRouteManager::programRoutes(
+    const std::vector<SaiRouteChange<AddrT>>& changes,
+    RouterID routerId,
+    folly::FunctionRef<void(const SaiRouteChange<AddrT>&)> applied) {
+  auto numThreads = routeProgrammingThreads(changes.size());
+  if (numThreads <= 1) {
+    for (const auto& change : changes) {
+      programRoute(change, routerId);
+      applied(change);
+    }
+    return;
+  }
+
+  // Check the changes and resolve all their next hops first. Nothing is
+  // programmed if any of this fails.
+  std::vector<PendingRouteChange> pending(changes.size());
+  for (size_t i = 0; i < changes.size(); ++i) {
+    const auto& change = changes[i];
+    auto& pendingChange = pending[i];
+    const auto& swRoute = change.newRoute ? change.newRoute : change.oldRoute;
+    pendingChange.entry = routeEntryFromSwRoute(routerId, swRoute);
+    auto itr = handles_.find(pendingChange.entry);
+    if (!change.newRoute) {
+      if (itr == handles_.end()) {
+        throw FbossError(
+            "Failed to remove non-existent route to ",
+            swRoute->prefix().str());
+      }
+      pendingChange.kind = PendingRouteChange::Kind::REMOVE;
+      pendingChange.route = itr->second->route;
+      continue;
+    }
+    if (change.oldRoute && itr == handles_.end()) {
+      throw FbossError(
+          "Failure to update route. Route does not exist ",
+          swRoute->prefix().str());
+    } else if (!change.oldRoute && itr != handles_.end()) {
+      throw FbossError(
+          "Failure to add route. A route already exists to ",
+          swRoute->prefix().str());
+    }
+    if (!validRoute(change.newRoute)) {
+      pendingChange.applied = true;
+      continue;
+    }
+    if (change.oldRoute) {
+      pendingChange.kind = PendingRouteChange::Kind::CHANGE;
+      pendingChange.handle = itr->second.get();
+    } else {
+      pendingChange.kind = PendingRouteChange::Kind::ADD;
+    }
+    std::tie(pendingChange.attributes, pendingChange.nextHopHandle) =
+        resolveRoute(pendingChange.entry, change.oldRoute, change.newRoute);
+  }
+
+  // Program the route entries, each thread owning a shard of them. A shard
+  // stops at its first failure.
+  std::vector<std::vector<PendingRouteChange*>> shards(numThreads);
+  for (auto& pendingChange : pending) {
+    if (pendingChange.kind != PendingRouteChange::Kind::NONE) {
+      auto hash = std::hash<SaiRouteTraits::RouteEntry>()(pendingChange.entry);
+      shards[hash % numThreads].push_back(&pendingChange);
+    }
+  }
+  std::vector<folly::Future<folly::Unit>> programmed;
+  programmed.reserve(shards.size());
+  for (auto& shard : shards) {
+    programmed.push_back(
+        folly::via(routeProgrammingExecutor_.get(), [&shard]() {
+          for (auto* pendingChange : shard) {
+            try {
+              programPendingRoute(*pendingChange);
+              pendingChange->applied = true;
+            } catch (...) {
+              pendingChange->error = std::current_exception();
+              break;
+            }
+          }
+        }));
+  }
+  // Errors are recorded per route, so none are lost here
+  folly::collectAll(programmed).wait();
+
+  // Update the handles of the routes programmed. Next hops no longer used
+  // are released here too, since they are shared across routes.
+  std::exception_ptr error;
+  for (size_t i = 0; i < changes.size(); ++i) {
+    auto& pendingChange = pending[i];
+    if (pendingChange.error && !error) {
+      error = pendingChange.error;
+    }
+    if (!pendingChange.applied) {
+      continue;
+    }
+    switch (pendingChange.kind) {
+      case PendingRouteChange::Kind::NONE:
+        break;
+      case PendingRouteChange::Kind::ADD: {
+        auto routeHandle = std::make_unique<SaiRouteHandle>();
+        routeHandle->route = std::move(pendingChange.route);
+        routeHandle->nexthopHandle_ = std::move(pendingChange.nextHopHandle);
+        handles_.emplace(pendingChange.entry, std::move(routeHandle));
+        break;
+      }
+      case PendingRouteChange::Kind::CHANGE:
+        pendingChange.handle->route = std::move(pendingChange.route);
+        pendingChange.handle->nexthopHandle_ =
+            std::move(pendingChange.nextHopHandle);
+        break;
+      case PendingRouteChange::Kind::REMOVE:
+        pendingChange.route.reset();
+        handles_.erase(pendingChange.entry);
+        break;
+    }
+    applied(changes[i]);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 SaiRouteHandle* SaiRouteManager::getRouteHandle(
     const SaiRouteTraits::RouteEntry& entry) {
   return getRouteHandleImpl(entry);
@@ -442,4 +658,15 @@ template void SaiRouteManager::removeRoute<folly::IPAddressV4>(
     const std::shared_ptr<Route<folly::IPAddressV4>>& swEntry,
     RouterID routerId);
 
+template void SaiRouteManager::programRoutes<folly::IPAddressV6>(
+    const std::vector<SaiRouteChange<folly::IPAddressV6>>& changes,
+    RouterID routerId,
+    folly::FunctionRef<void(const SaiRouteChange<folly::IPAddressV6>&)>
+        applied);
+template void SaiRouteManager::programRoutes<folly::IPAddressV4>(
+    const std::vector<SaiRouteChange<folly::IPAddressV4>>& changes,
+    RouterID routerId,
+    folly::FunctionRef<void(const SaiRouteChange<folly::IPAddressV4>&)>
+        applied);
+
 } // namespace facebook::fboss
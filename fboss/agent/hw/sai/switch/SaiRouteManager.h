@@ -20,8 +20,16 @@
 
 #include "fboss/agent/hw/sai/store/SaiObjectEventSubscriber.h"
 
+#include <folly/Function.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gflags/gflags.h>
+
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
+
+DECLARE_int32(sai_route_programming_threads);
 
 namespace facebook::fboss {
 
@@ -71,6 +79,14 @@ struct SaiRouteHandle {
   std::shared_ptr<SaiNextHopGroupHandle> nextHopGroupHandle() const;
 };
 
+template <typename AddrT>
+struct SaiRouteChange {
+  // Null for a route being added
+  std::shared_ptr<Route<AddrT>> oldRoute;
+  // Null for a route being removed
+  std::shared_ptr<Route<AddrT>> newRoute;
+};
+
 class SaiRouteManager {
  public:
   SaiRouteManager(SaiManagerTable* managerTable, const SaiPlatform* platform);
@@ -100,6 +116,35 @@ class SaiRouteManager {
       const std::shared_ptr<Route<AddrT>>& swRoute,
       RouterID routerId);
 
+  /*
+   * Whether programRoutes() may program route entries concurrently: with
+   * --sai_route_programming_threads above 1 at construction, on adapters
+   * whose route api is thread safe.
+   */
+  bool concurrentRouteProgramming() const;
+
+  /*
+   * Apply a batch of route additions, changes and removals for one router.
+   *
+   * Route entries for different prefixes are independent of each other once
+   * their next hops exist. So when programming concurrently, the next hops
+   * of the whole batch are resolved first, then the route entries are
+   * partitioned by hash into one shard per thread, and each thread of
+   * routeProgrammingExecutor_ programs the entries of its shard. Batches too
+   * small to be worth it, and all batches when not programming concurrently,
+   * are applied one route at a time like changeRoute, addRoute and
+   * removeRoute do.
+   *
+   * applied is called, in batch order, for each change that took effect. If
+   * any change fails, the first error is rethrown after that, and the
+   * changes not applied have no effect.
+   */
+  template <typename AddrT>
+  void programRoutes(
+      const std::vector<SaiRouteChange<AddrT>>& changes,
+      RouterID routerId,
+      folly::FunctionRef<void(const SaiRouteChange<AddrT>&)> applied);
+
   SaiRouteHandle* getRouteHandle(const SaiRouteTraits::RouteEntry& entry);
   const SaiRouteHandle* getRouteHandle(
       const SaiRouteTraits::RouteEntry& entry) const;
@@ -116,6 +161,20 @@ class SaiRouteManager {
       const std::shared_ptr<Route<AddrT>>& oldRoute,
       const std::shared_ptr<Route<AddrT>>& newRoute);
 
+  // Claim the next hops of a route, and work out its attributes
+  template <typename AddrT>
+  std::pair<SaiRouteTraits::CreateAttributes, SaiRouteHandle::NextHopHandle>
+  resolveRoute(
+      const SaiRouteTraits::RouteEntry& entry,
+      const std::shared_ptr<Route<AddrT>>& oldRoute,
+      const std::shared_ptr<Route<AddrT>>& newRoute);
+
+  template <typename AddrT>
+  void programRoute(const SaiRouteChange<AddrT>& change, RouterID routerId);
+
+  // Threads to program a batch of numChanges route changes with
+  size_t routeProgrammingThreads(size_t numChanges) const;
+
   template <typename AddrT>
   bool validRoute(const std::shared_ptr<Route<AddrT>>& swRoute);
 
@@ -123,6 +182,9 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  // Threads programming route entries concurrently, kept across batches.
+  // Only created when programming concurrently.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> routeProgrammingExecutor_;
 };
 
 } // namespace facebook::fboss
@@ -20,6 +20,7 @@
 #include "fboss/agent/hw/sai/api/FdbApi.h"
 #include "fboss/agent/hw/sai/api/HostifApi.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiCallStats.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/api/Types.h"
@@ -54,6 +55,8 @@
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 
+#include <fb303/ServiceData.h>
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include <chrono>
@@ -97,6 +100,33 @@ const std::map<sai_fdb_event_t, facebook::fboss::L2EntryUpdateType>
         {SAI_FDB_EVENT_AGED,
          facebook::fboss::L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE},
 };
+
+void publishSaiApiCallStats() {
+  using namespace facebook::fboss;
+  auto callStats = SaiApiCallStats::getInstance();
+  if (!callStats) {
+    return;
+  }
+  for (const auto& [key, latency] : callStats->getLatencies()) {
+    auto prefix = folly::to<std::string>(
+        kSaiApiCallPrefix,
+        saiApiTypeToString(key.api),
+        ".",
+        key.objectType == SAI_OBJECT_TYPE_NULL
+            ? folly::StringPiece("any")
+            : saiObjectTypeToString(key.objectType),
+        ".",
+        saiApiOperationToString(key.operation),
+        ".");
+    fb303::fbData->setCounter(prefix + "calls", latency.calls);
+    fb303::fbData->setCounter(prefix + "total_usecs", latency.totalUsecs);
+    fb303::fbData->setCounter(
+        prefix + "p50_usecs", latency.percentileUsecs(50));
+    fb303::fbData->setCounter(
+        prefix + "p99_usecs", latency.percentileUsecs(99));
+    fb303::fbData->setCounter(prefix + "max_usecs", latency.maxUsecs);
+  }
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -217,29 +247,64 @@ void SaiSwitch::unregisterCallbacks() noexcept {
   fdbEventBottomHalfThread_->join();
 }
 
+template <typename UndoFn>
+void SaiSwitch::recordUndo(UndoFn&& undoFn) {
+  if (undoLog_) {
+    undoLog_->emplace_back(std::forward<UndoFn>(undoFn));
+  }
+}
+
+template <typename OpFn, typename UndoFn>
+void SaiSwitch::applyUndoable(bool atomic, OpFn&& opFn, UndoFn&& undoFn) {
+  inFlightOpAtomic_ = atomic;
+  opFn();
+  inFlightOpAtomic_ = true;
+  recordUndo(std::forward<UndoFn>(undoFn));
+}
+
 template <typename ManagerT, typename LockPolicyT>
 void SaiSwitch::processDefaultDataPlanePolicyDelta(
     const StateDelta& delta,
     ManagerT& mgr,
     const LockPolicyT& lockPolicy) {
   auto qosDelta = delta.getDefaultDataPlaneQosPolicyDelta();
-  auto& qosMapManager = managerTable_->qosMapManager();
   if ((qosDelta.getOld() != qosDelta.getNew())) {
     [[maybe_unused]] const auto& lock = lockPolicy.lock();
-    if (qosDelta.getOld() && qosDelta.getNew()) {
-      if (*qosDelta.getOld() != *qosDelta.getNew()) {
-        mgr.clearQosPolicy();
-        qosMapManager.removeQosMap();
-        qosMapManager.addQosMap(qosDelta.getNew());
-        mgr.setQosPolicy();
-      }
-    } else if (qosDelta.getNew()) {
-      qosMapManager.addQosMap(qosDelta.getNew());
-      mgr.setQosPolicy();
-    } else if (qosDelta.getOld()) {
+    applyUndoable(
+        false,
+        [&] {
+          updateDefaultDataPlaneQosPolicy(
+              mgr, qosDelta.getOld(), qosDelta.getNew());
+        },
+        [this,
+         &mgr,
+         oldPolicy = qosDelta.getOld(),
+         newPolicy = qosDelta.getNew()](
+            const std::lock_guard<std::mutex>& /*lock*/) {
+          updateDefaultDataPlaneQosPolicy(mgr, newPolicy, oldPolicy);
+        });
+  }
+}
+
+template <typename ManagerT>
+void SaiSwitch::updateDefaultDataPlaneQosPolicy(
+    ManagerT& mgr,
+    const std::shared_ptr<QosPolicy>& oldPolicy,
+    const std::shared_ptr<QosPolicy>& newPolicy) {
+  auto& qosMapManager = managerTable_->qosMapManager();
+  if (oldPolicy && newPolicy) {
+    if (*oldPolicy != *newPolicy) {
       mgr.clearQosPolicy();
       qosMapManager.removeQosMap();
+      qosMapManager.addQosMap(newPolicy);
+      mgr.setQosPolicy();
     }
+  } else if (newPolicy) {
+    qosMapManager.addQosMap(newPolicy);
+    mgr.setQosPolicy();
+  } else if (oldPolicy) {
+    mgr.clearQosPolicy();
+    qosMapManager.removeQosMap();
   }
 }
 
@@ -272,8 +337,17 @@ void SaiSwitch::processLinkStateChangeDelta(
 
         if (adminStateChanged || operStateChanged) {
           auto platformPort = platform_->getPort(id);
-          platformPort->linkStatusChanged(
-              newPort->isUp(), newPort->isEnabled());
+          applyUndoable(
+              true,
+              [&] {
+                platformPort->linkStatusChanged(
+                    newPort->isUp(), newPort->isEnabled());
+              },
+              [platformPort, oldPort](
+                  const std::lock_guard<std::mutex>& /*lock*/) {
+                platformPort->linkStatusChanged(
+                    oldPort->isUp(), oldPort->isEnabled());
+              });
         }
       });
 }
@@ -288,16 +362,55 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedTransaction(
     const StateDelta& delta) {
   CHECK(
       platform_->getAsic()->getAsicType() != HwAsic::AsicType::ASIC_TYPE_TAJO);
+  undoLog_.emplace();
+  inFlightOpAtomic_ = true;
+  SCOPE_EXIT {
+    undoLog_.reset();
+  };
   try {
     return stateChanged(delta);
   } catch (const FbossError& e) {
     XLOG(WARNING) << " Transaction failed with error : " << *e.message_ref()
                   << " attempting rollback";
-    rollback(delta.oldState());
+    rollbackFromUndoLog(delta.oldState());
   }
   return delta.oldState();
 }
 
+void SaiSwitch::rollbackFromUndoLog(
+    const std::shared_ptr<SwitchState>& knownGoodState) noexcept {
+  CHECK(undoLog_);
+  auto undoLog = std::move(*undoLog_);
+  undoLog_.reset();
+  if (!inFlightOpAtomic_) {
+    // Undoing the operations that succeeded would leave behind whatever
+    // the failed one did before it threw
+    XLOG(WARNING) << "Failed operation may have been partially applied,"
+                  << " falling back to full rollback";
+    rollback(knownGoodState);
+    return;
+  }
+  auto begin = std::chrono::steady_clock::now();
+  try {
+    std::lock_guard<std::mutex> lock(saiSwitchMutex_);
+    // The failed operation left no state behind, so undoing the operations
+    // that did succeed, latest first, gets us back to knownGoodState.
+    for (auto itr = undoLog.rbegin(); itr != undoLog.rend(); ++itr) {
+      (*itr)(lock);
+    }
+    XLOG(INFO) << " Rolled back " << undoLog.size() << " operations in "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - begin)
+                      .count()
+               << "ms";
+    return;
+  } catch (const std::exception& ex) {
+    XLOG(WARNING) << " Undo log rollback failed with : " << ex.what()
+                  << ", falling back to full rollback";
+  }
+  rollback(knownGoodState);
+}
+
 void SaiSwitch::rollback(
     const std::shared_ptr<SwitchState>& knownGoodState) noexcept {
   auto curBootType = getBootType();
@@ -407,7 +520,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
       delta.getPortsDelta(),
       managerTable_->portManager(),
       lockPolicy,
-      &SaiPortManager::removePort);
+      &SaiPortManager::removePort,
+      &SaiPortManager::addPort);
   processChangedDelta(
       delta.getPortsDelta(),
       managerTable_->portManager(),
@@ -417,7 +531,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
       delta.getPortsDelta(),
       managerTable_->portManager(),
       lockPolicy,
-      &SaiPortManager::addPort);
+      &SaiPortManager::addPort,
+      &SaiPortManager::removePort);
   processDelta(
       delta.getVlansDelta(),
       managerTable_->vlanManager(),
@@ -480,30 +595,29 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
   for (const auto& routeDelta : delta.getRouteTablesDelta()) {
     auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
                                         : routeDelta.getNew()->getID();
-    processDelta(
-        routeDelta.getRoutesV4Delta(),
-        managerTable_->routeManager(),
-        lockPolicy,
-        &SaiRouteManager::changeRoute<folly::IPAddressV4>,
-        &SaiRouteManager::addRoute<folly::IPAddressV4>,
-        &SaiRouteManager::removeRoute<folly::IPAddressV4>,
-        routerID);
-
-    processDelta(
-        routeDelta.getRoutesV6Delta(),
-        managerTable_->routeManager(),
-        lockPolicy,
-        &SaiRouteManager::changeRoute<folly::IPAddressV6>,
-        &SaiRouteManager::addRoute<folly::IPAddressV6>,
-        &SaiRouteManager::removeRoute<folly::IPAddressV6>,
-        routerID);
+    processRouteDelta<folly::IPAddressV4>(
+        routeDelta.getRoutesV4Delta(), routerID, lockPolicy);
+    processRouteDelta<folly::IPAddressV6>(
+        routeDelta.getRoutesV6Delta(), routerID, lockPolicy);
   }
 
   {
     auto controlPlaneDelta = delta.getControlPlaneDelta();
     if (controlPlaneDelta.getOld() != controlPlaneDelta.getNew()) {
       [[maybe_unused]] const auto& lock = lockPolicy.lock();
-      managerTable_->hostifManager().processHostifDelta(controlPlaneDelta);
+      applyUndoable(
+          false,
+          [&] {
+            managerTable_->hostifManager().processHostifDelta(
+                controlPlaneDelta);
+          },
+          [this,
+           oldControlPlane = controlPlaneDelta.getOld(),
+           newControlPlane = controlPlaneDelta.getNew()](
+              const std::lock_guard<std::mutex>& /*lock*/) {
+            managerTable_->hostifManager().processHostifDelta(
+                DeltaValue<ControlPlane>(newControlPlane, oldControlPlane));
+          });
     }
   }
 
@@ -635,7 +749,13 @@ void SaiSwitch::processSwitchSettingsChanged(
   CHECK(newSwitchSettings);
 
   if (oldSwitchSettings != newSwitchSettings) {
-    processSwitchSettingsChangedLocked(lockPolicy.lock(), delta);
+    applyUndoable(
+        false,
+        [&] { processSwitchSettingsChangedLocked(lockPolicy.lock(), delta); },
+        [this, reverseDelta = StateDelta(delta.newState(), delta.oldState())](
+            const std::lock_guard<std::mutex>& lock) {
+          processSwitchSettingsChangedLocked(lock, reverseDelta);
+        });
   }
 }
 
@@ -682,6 +802,7 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
     HwResourceStatsPublisher().publish(hwResourceStats_);
   }
+  publishSaiApiCallStats();
 }
 
 uint64_t SaiSwitch::getDeviceWatermarkBytes() const {
@@ -793,28 +914,45 @@ cfg::PortSpeed SaiSwitch::getPortMaxSpeed(PortID port) const {
 void SaiSwitch::linkStateChangedCallbackTopHalf(
     uint32_t count,
     const sai_port_oper_status_notification_t* operStatus) {
-  std::vector<sai_port_oper_status_notification_t> operStatusTmp;
-  operStatusTmp.resize(count);
-  std::copy(operStatus, operStatus + count, operStatusTmp.data());
-  linkStateBottomHalfEventBase_.runInEventBaseThread(
-      [this, operStatus = std::move(operStatusTmp)]() mutable {
-        linkStateChangedCallbackBottomHalf(std::move(operStatus));
-      });
+  auto now = std::chrono::steady_clock::now();
+  for (auto i = 0; i < count; i++) {
+    linkStateEventQueue_.enqueue(LinkStateNotification{operStatus[i], now});
+  }
+  // Schedule a drain unless one is already pending. The bottom half clears
+  // the flag before draining, so events enqueued after that are either
+  // picked up by the current drain or trigger a new one.
+  if (!linkStateDrainScheduled_.exchange(true)) {
+    linkStateBottomHalfEventBase_.runInEventBaseThread(
+        [this]() { linkStateChangedCallbackBottomHalf(); });
+  }
 }
 
-void SaiSwitch::linkStateChangedCallbackBottomHalf(
-    std::vector<sai_port_oper_status_notification_t> operStatus) {
-  std::map<PortID, bool> swPortId2Status;
-  for (auto i = 0; i < operStatus.size(); i++) {
-    bool up = operStatus[i].port_state == SAI_PORT_OPER_STATUS_UP;
+void SaiSwitch::linkStateChangedCallbackBottomHalf() {
+  linkStateDrainScheduled_ = false;
+  std::vector<LinkStateNotification> operStatus;
+  while (auto queued = linkStateEventQueue_.try_dequeue()) {
+    operStatus.push_back(*queued);
+  }
+  if (operStatus.empty()) {
+    return;
+  }
+
+  struct PortLinkEvents {
+    bool sawDown{false};
+    bool up{false};
+  };
+  std::map<PortID, PortLinkEvents> swPortId2Events;
+  for (const auto& queued : operStatus) {
+    const auto& status = queued.data;
+    bool up = status.port_state == SAI_PORT_OPER_STATUS_UP;
 
     // Look up SwitchState PortID by port sai id in ConcurrentIndices
     const auto portItr =
-        concurrentIndices_->portIds.find(PortSaiId(operStatus[i].port_id));
+        concurrentIndices_->portIds.find(PortSaiId(status.port_id));
     if (portItr == concurrentIndices_->portIds.cend()) {
       XLOG(WARNING)
           << "received port notification for port with unknown sai id: "
-          << operStatus[i].port_id;
+          << status.port_id;
       continue;
     }
     PortID swPortId = portItr->second;
@@ -823,45 +961,64 @@ void SaiSwitch::linkStateChangedCallbackBottomHalf(
         INFO,
         "Link state changed {} ({}): {}",
         swPortId,
-        PortSaiId{operStatus[i].port_id},
+        PortSaiId{status.port_id},
         up ? "up" : "down");
 
-    if (!up) {
-      /*
-       * Only link down are handled in the fast path. We let the
-       * link up processing happen via the regular state change
-       * mechanism. Reason for that is, post a link down
-       * - We signal FDB entry, neighbor entry, next hop and next hop group
-       *   that a link went down.
-       * - Next hop group then shrinks the group based on which next hops are
-       * affected.
-       * - We now signal the callback (SwSwitch for wedge_agent, HwTest for hw
-       * tests) for this link down state
-       *    - SwSwitch in turn schedules a non coalescing port down state update
-       *    - Schedules a neighbor remove state update
-       * - Meanwhile, if we get a port up event, we will just signal this upto
-       * the SwSwitch and not handle this is in the fast path. Reason being,
-       * post a link up the link is not immediately ready for packet handling,
-       * so if we expand ECMP groups in the fast path, we will see some ms of
-       * traffic loss. So we let the link up processing happen via switch
-       * updates, which means that it will be queued behind the link down and
-       * neighbor purge. So a ECMP group reexpansion would need both a link up
-       * and neighbor add state update for expansion. At this point we are
-       * guaranteed to have the link be ready for packet transmission, since we
-       * already resolved neighbors over that link.
-       */
-      std::lock_guard<std::mutex> lock{saiSwitchMutex_};
-      managerTable_->fdbManager().handleLinkDown(swPortId);
+    auto& events = swPortId2Events[swPortId];
+    events.sawDown |= !up;
+    events.up = up;
+  }
+
+  /*
+   * Only link down are handled in the fast path. We let the
+   * link up processing happen via the regular state change
+   * mechanism. Reason for that is, post a link down
+   * - We signal FDB entry, neighbor entry, next hop and next hop group
+   *   that a link went down.
+   * - Next hop group then shrinks the group based on which next hops are
+   * affected.
+   * - We now signal the callback (SwSwitch for wedge_agent, HwTest for hw
+   * tests) for this link down state
+   *    - SwSwitch in turn schedules a non coalescing port down state update
+   *    - Schedules a neighbor remove state update
+   * - Meanwhile, if we get a port up event, we will just signal this upto
+   * the SwSwitch and not handle this is in the fast path. Reason being,
+   * post a link up the link is not immediately ready for packet handling,
+   * so if we expand ECMP groups in the fast path, we will see some ms of
+   * traffic loss. So we let the link up processing happen via switch
+   * updates, which means that it will be queued behind the link down and
+   * neighbor purge. So a ECMP group reexpansion would need both a link up
+   * and neighbor add state update for expansion. At this point we are
+   * guaranteed to have the link be ready for packet transmission, since we
+   * already resolved neighbors over that link.
+   *
+   * All link downs seen in this drain are handled under a single
+   * acquisition of saiSwitchMutex_.
+   */
+  {
+    std::lock_guard<std::mutex> lock{saiSwitchMutex_};
+    for (const auto& [swPortId, events] : swPortId2Events) {
+      if (events.sawDown) {
+        managerTable_->fdbManager().handleLinkDown(swPortId);
+      }
     }
-    swPortId2Status[swPortId] = up;
   }
   // Issue callbacks in a separate loop so fast link status change
   // processing is not at the mercy of what the callback (SwSwitch, HwTest)
-  // does with the callback notification.
-  for (auto swPortIdAndStatus : swPortId2Status) {
-    callback_->linkStateChanged(
-        swPortIdAndStatus.first, swPortIdAndStatus.second);
+  // does with the callback notification. A port which flapped within
+  // the drain is reported down before up, so that the down processing
+  // (neighbor purge, ECMP shrink) is not lost.
+  for (const auto& [swPortId, events] : swPortId2Events) {
+    if (events.sawDown && events.up) {
+      callback_->linkStateChanged(swPortId, false);
+    }
+    callback_->linkStateChanged(swPortId, events.up);
   }
+
+  auto drainUsecs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - operStatus.front().received);
+  getSwitchStats()->linkStateEventsDrained(
+      operStatus.size(), drainUsecs.count());
 }
 
 BootType SaiSwitch::getBootType() const {
@@ -953,6 +1110,11 @@ void SaiSwitch::initStoreAndManagersLocked(
   auto saiStore = SaiStore::getInstance();
   saiStore->setSwitchId(switchId_);
   saiStore->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  for (const auto& [objectType, duration] : saiStore->reloadDurations()) {
+    fb303::fbData->setCounter(
+        folly::to<std::string>(kSaiStoreReloadUsecsPrefix, objectType),
+        duration.count());
+  }
   managerTable_->createSaiTableManagers(platform_, concurrentIndices_.get());
   /*
    * SwitchState does not have notion of AclTableGroup or AclTable today.
@@ -1416,7 +1578,7 @@ void SaiSwitch::fdbEventCallback(
    * we used the bridge port id to fetch the port id from the SDK.
    * Going with option 2 for fdb event notifications.
    */
-  std::vector<FdbEventNotificationData> fdbEventNotificationDataTmp;
+  auto now = std::chrono::steady_clock::now();
   for (auto i = 0; i < count; i++) {
     BridgePortSaiId bridgePortSaiId{0};
     for (auto j = 0; j < data[i].attr_count; j++) {
@@ -1428,15 +1590,55 @@ void SaiSwitch::fdbEventCallback(
           break;
       }
     }
-    fdbEventNotificationDataTmp.push_back(FdbEventNotificationData(
-        data[i].event_type, data[i].fdb_entry, bridgePortSaiId));
-  }
-  fdbEventBottomHalfEventBase_.runInEventBaseThread(
-      [this,
-       fdbNotifications = std::move(fdbEventNotificationDataTmp)]() mutable {
-        auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
-        fdbEventCallbackLockedBottomHalf(lock, std::move(fdbNotifications));
-      });
+    fdbEventQueue_.enqueue(FdbNotification{
+        FdbEventNotificationData(
+            data[i].event_type, data[i].fdb_entry, bridgePortSaiId),
+        now});
+  }
+  if (!fdbDrainScheduled_.exchange(true)) {
+    fdbEventBottomHalfEventBase_.runInEventBaseThread(
+        [this]() { fdbEventCallbackBottomHalf(); });
+  }
+}
+
+void SaiSwitch::fdbEventCallbackBottomHalf() {
+  fdbDrainScheduled_ = false;
+  /*
+   * Merge events for the same (bridge/vlan, MAC): only the latest one
+   * matters, e.g. a MAC moving back and forth between ports during a
+   * storm results in a single learn for its last port.
+   */
+  std::vector<FdbEventNotificationData> fdbNotifications;
+  std::map<std::pair<sai_object_id_t, folly::MacAddress>, size_t>
+      fdbEntry2Index;
+  std::optional<std::chrono::steady_clock::time_point> oldest;
+  size_t drained{0};
+  while (auto queued = fdbEventQueue_.try_dequeue()) {
+    if (!oldest) {
+      oldest = queued->received;
+    }
+    ++drained;
+    auto key = std::make_pair(
+        queued->data.fdbEntry.bv_id,
+        fromSaiMacAddress(queued->data.fdbEntry.mac_address));
+    auto [itr, inserted] =
+        fdbEntry2Index.emplace(key, fdbNotifications.size());
+    if (inserted) {
+      fdbNotifications.push_back(std::move(queued->data));
+    } else {
+      fdbNotifications[itr->second] = std::move(queued->data);
+    }
+  }
+  if (!drained) {
+    return;
+  }
+  {
+    auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
+    fdbEventCallbackLockedBottomHalf(lock, std::move(fdbNotifications));
+  }
+  auto drainUsecs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - oldest.value());
+  getSwitchStats()->fdbEventsDrained(drained, drainUsecs.count());
 }
 
 void SaiSwitch::fdbEventCallbackLockedBottomHalf(
@@ -1534,15 +1736,33 @@ void SaiSwitch::processDelta(
       [&](const std::shared_ptr<typename Delta::Node>& removed,
           const std::shared_ptr<typename Delta::Node>& added) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
-        (manager.*changedFunc)(removed, added, args...);
+        applyUndoable(
+            false,
+            [&] { (manager.*changedFunc)(removed, added, args...); },
+            [&manager, changedFunc, removed, added, args...](
+                const std::lock_guard<std::mutex>& /*lock*/) {
+              (manager.*changedFunc)(added, removed, args...);
+            });
       },
       [&](const std::shared_ptr<typename Delta::Node>& added) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
-        (manager.*addedFunc)(added, args...);
+        applyUndoable(
+            false,
+            [&] { (manager.*addedFunc)(added, args...); },
+            [&manager, removedFunc, added, args...](
+                const std::lock_guard<std::mutex>& /*lock*/) {
+              (manager.*removedFunc)(added, args...);
+            });
       },
       [&](const std::shared_ptr<typename Delta::Node>& removed) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
-        (manager.*removedFunc)(removed, args...);
+        applyUndoable(
+            false,
+            [&] { (manager.*removedFunc)(removed, args...); },
+            [&manager, addedFunc, removed, args...](
+                const std::lock_guard<std::mutex>& /*lock*/) {
+              (manager.*addedFunc)(removed, args...);
+            });
       });
 }
 
@@ -1560,10 +1780,16 @@ void SaiSwitch::processChangedDelta(
     Args... args) {
   DeltaFunctions::forEachChanged(
       delta,
-      [&](const std::shared_ptr<typename Delta::Node>& added,
-          const std::shared_ptr<typename Delta::Node>& removed) {
+      [&](const std::shared_ptr<typename Delta::Node>& removed,
+          const std::shared_ptr<typename Delta::Node>& added) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
-        (manager.*changedFunc)(added, removed, args...);
+        applyUndoable(
+            false,
+            [&] { (manager.*changedFunc)(removed, added, args...); },
+            [&manager, changedFunc, removed, added, args...](
+                const std::lock_guard<std::mutex>& /*lock*/) {
+              (manager.*changedFunc)(added, removed, args...);
+            });
       });
 }
 
@@ -1572,17 +1798,25 @@ template <
     typename Manager,
     typename LockPolicyT,
     typename... Args,
-    typename AddedFunc>
+    typename AddedFunc,
+    typename RemovedFunc>
 void SaiSwitch::processAddedDelta(
     Delta delta,
     Manager& manager,
     const LockPolicyT& lockPolicy,
     AddedFunc addedFunc,
+    RemovedFunc undoFunc,
     Args... args) {
   DeltaFunctions::forEachAdded(
       delta, [&](const std::shared_ptr<typename Delta::Node>& added) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
-        (manager.*addedFunc)(added, args...);
+        applyUndoable(
+            false,
+            [&] { (manager.*addedFunc)(added, args...); },
+            [&manager, undoFunc, added, args...](
+                const std::lock_guard<std::mutex>& /*lock*/) {
+              (manager.*undoFunc)(added, args...);
+            });
       });
 }
 
@@ -1591,17 +1825,106 @@ template <
     typename Manager,
     typename LockPolicyT,
     typename... Args,
-    typename RemovedFunc>
+    typename RemovedFunc,
+    typename AddedFunc>
 void SaiSwitch::processRemovedDelta(
     Delta delta,
     Manager& manager,
     const LockPolicyT& lockPolicy,
     RemovedFunc removedFunc,
+    AddedFunc undoFunc,
     Args... args) {
   DeltaFunctions::forEachRemoved(
       delta, [&](const std::shared_ptr<typename Delta::Node>& removed) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
-        (manager.*removedFunc)(removed, args...);
+        applyUndoable(
+            false,
+            [&] { (manager.*removedFunc)(removed, args...); },
+            [&manager, undoFunc, removed, args...](
+                const std::lock_guard<std::mutex>& /*lock*/) {
+              (manager.*undoFunc)(removed, args...);
+            });
+      });
+}
+
+template <typename AddrT, typename Delta, typename LockPolicyT>
+void SaiSwitch::processRouteDelta(
+    const Delta& delta,
+    RouterID routerID,
+    const LockPolicyT& lockPolicy) {
+  auto& routeManager = managerTable_->routeManager();
+  if (!routeManager.concurrentRouteProgramming()) {
+    // Adding and removing a route leave nothing behind when they fail, as
+    // any next hops resolved for the route are released as they unwind.
+    // Changing a route may have set some of its attributes.
+    DeltaFunctions::forEachChanged(
+        delta,
+        [&](const std::shared_ptr<Route<AddrT>>& removed,
+            const std::shared_ptr<Route<AddrT>>& added) {
+          [[maybe_unused]] const auto& lock = lockPolicy.lock();
+          applyUndoable(
+              false,
+              [&] {
+                routeManager.changeRoute<AddrT>(removed, added, routerID);
+              },
+              [&routeManager, removed, added, routerID](
+                  const std::lock_guard<std::mutex>& /*lock*/) {
+                routeManager.changeRoute<AddrT>(added, removed, routerID);
+              });
+        },
+        [&](const std::shared_ptr<Route<AddrT>>& added) {
+          [[maybe_unused]] const auto& lock = lockPolicy.lock();
+          applyUndoable(
+              true,
+              [&] { routeManager.addRoute<AddrT>(added, routerID); },
+              [&routeManager, added, routerID](
+                  const std::lock_guard<std::mutex>& /*lock*/) {
+                routeManager.removeRoute<AddrT>(added, routerID);
+              });
+        },
+        [&](const std::shared_ptr<Route<AddrT>>& removed) {
+          [[maybe_unused]] const auto& lock = lockPolicy.lock();
+          applyUndoable(
+              true,
+              [&] { routeManager.removeRoute<AddrT>(removed, routerID); },
+              [&routeManager, removed, routerID](
+                  const std::lock_guard<std::mutex>& /*lock*/) {
+                routeManager.addRoute<AddrT>(removed, routerID);
+              });
+        });
+    return;
+  }
+  std::vector<SaiRouteChange<AddrT>> changes;
+  bool atomic = true;
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](const std::shared_ptr<Route<AddrT>>& removed,
+          const std::shared_ptr<Route<AddrT>>& added) {
+        changes.push_back({removed, added});
+        atomic = false;
+      },
+      [&](const std::shared_ptr<Route<AddrT>>& added) {
+        changes.push_back({nullptr, added});
+      },
+      [&](const std::shared_ptr<Route<AddrT>>& removed) {
+        changes.push_back({removed, nullptr});
+      });
+  if (changes.empty()) {
+    return;
+  }
+  [[maybe_unused]] const auto& lock = lockPolicy.lock();
+  // Routes programmed before a failure are recorded as they are applied,
+  // so the batch as a whole is as atomic as its individual changes
+  inFlightOpAtomic_ = atomic;
+  routeManager.programRoutes<AddrT>(
+      changes, routerID, [&](const SaiRouteChange<AddrT>& change) {
+        recordUndo([&routeManager, change, routerID](
+                       const std::lock_guard<std::mutex>& /*lock*/) {
+          std::vector<SaiRouteChange<AddrT>> undo{
+              {change.newRoute, change.oldRoute}};
+          routeManager.programRoutes<AddrT>(
+              undo, routerID, [](const SaiRouteChange<AddrT>&) {});
+        });
       });
 }
 
@@ -18,17 +18,24 @@
 #include "fboss/agent/hw/sai/switch/SaiRxPacket.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <folly/Function.h>
+#include <folly/concurrency/UnboundedQueue.h>
 #include <folly/io/async/EventBase.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <vector>
 
 DECLARE_bool(flexports);
 
 namespace facebook::fboss {
 
 class ConcurrentIndices;
+class QosPolicy;
 /*
  * This is equivalent to sai_fdb_event_notification_data_t. Copy only the
  * necessary FDB event attributes from sai_fdb_event_notification_data_t.
@@ -175,6 +182,21 @@ class SaiSwitch : public HwSwitch {
       const LockPolicyT& lk);
   friend class SaiRollbackTest;
   void rollback(const std::shared_ptr<SwitchState>& knownGoodState) noexcept;
+  /*
+   * Revert a failed transaction by replaying undoLog_ in reverse. Falls
+   * back to the full rollback() if the failed operation may have been
+   * partially applied, or if any undo operation fails.
+   */
+  void rollbackFromUndoLog(
+      const std::shared_ptr<SwitchState>& knownGoodState) noexcept;
+  template <typename UndoFn>
+  void recordUndo(UndoFn&& undoFn);
+  /*
+   * Run opFn and record undoFn once it succeeds. atomic says whether opFn
+   * leaves no state behind when it throws.
+   */
+  template <typename OpFn, typename UndoFn>
+  void applyUndoable(bool atomic, OpFn&& opFn, UndoFn&& undoFn);
   std::string listObjectsLocked(
       const std::vector<sai_object_type_t>& objects,
       bool cached,
@@ -244,6 +266,8 @@ class SaiSwitch : public HwSwitch {
       const std::lock_guard<std::mutex>& lock,
       PortID port) const;
 
+  void fdbEventCallbackBottomHalf();
+
   void fdbEventCallbackLockedBottomHalf(
       const std::lock_guard<std::mutex>& lock,
       std::vector<FdbEventNotificationData> data);
@@ -265,8 +289,7 @@ class SaiSwitch : public HwSwitch {
   folly::F14FastMap<std::string, HwPortStats> getPortStatsLocked(
       const std::lock_guard<std::mutex>& lock) const;
 
-  void linkStateChangedCallbackBottomHalf(
-      std::vector<sai_port_oper_status_notification_t> data);
+  void linkStateChangedCallbackBottomHalf();
 
   uint64_t getDeviceWatermarkBytesLocked(
       const std::lock_guard<std::mutex>& lock) const;
@@ -280,6 +303,11 @@ class SaiSwitch : public HwSwitch {
       const StateDelta& delta,
       ManagerT& mgr,
       const LockPolicyT& lk);
+  template <typename ManagerT>
+  void updateDefaultDataPlaneQosPolicy(
+      ManagerT& mgr,
+      const std::shared_ptr<QosPolicy>& oldPolicy,
+      const std::shared_ptr<QosPolicy>& newPolicy);
 
   template <typename LockPolicyT>
   void processLinkStateChangeDelta(
@@ -330,12 +358,15 @@ class SaiSwitch : public HwSwitch {
       typename LockPolicyT,
       typename... Args,
       typename AddedFunc = void (
+          Manager::*)(const std::shared_ptr<typename Delta::Node>&, Args...),
+      typename RemovedFunc = void (
           Manager::*)(const std::shared_ptr<typename Delta::Node>&, Args...)>
   void processAddedDelta(
       Delta delta,
       Manager& manager,
       const LockPolicyT& lockPolicy,
       AddedFunc addedFunc,
+      RemovedFunc undoFunc,
       Args... args);
 
   template <
@@ -344,14 +375,28 @@ class SaiSwitch : public HwSwitch {
       typename LockPolicyT,
       typename... Args,
       typename RemovedFunc = void (
+          Manager::*)(const std::shared_ptr<typename Delta::Node>&, Args...),
+      typename AddedFunc = void (
           Manager::*)(const std::shared_ptr<typename Delta::Node>&, Args...)>
   void processRemovedDelta(
       Delta delta,
       Manager& manager,
       const LockPolicyT& lockPolicy,
       RemovedFunc removedFunc,
+      AddedFunc undoFunc,
       Args... args);
 
+  /*
+   * Routes are processed like any other delta, unless SaiRouteManager
+   * programs them concurrently, in which case the whole batch of routes is
+   * programmed under one lock rather than taking it route by route.
+   */
+  template <typename AddrT, typename Delta, typename LockPolicyT>
+  void processRouteDelta(
+      const Delta& delta,
+      RouterID routerID,
+      const LockPolicyT& lockPolicy);
+
   template <typename LockPolicyT>
   void processSwitchSettingsChanged(
       const StateDelta& delta,
@@ -392,15 +437,54 @@ class SaiSwitch : public HwSwitch {
 
   std::unique_ptr<SaiManagerTable> managerTable_;
   std::atomic<BootType> bootType_{BootType::UNINITIALIZED};
+
+  /*
+   * Set only while stateChangedTransaction() is applying a delta. Every
+   * manager operation that succeeds records its inverse here, so a failed
+   * transaction is reverted by undoing just the operations it performed,
+   * rather than reloading SaiStore from HW and replaying the whole state.
+   * Undo operations run with saiSwitchMutex_ held.
+   */
+  using UndoOperation =
+      folly::Function<void(const std::lock_guard<std::mutex>& lock)>;
+  std::optional<std::vector<UndoOperation>> undoLog_;
+  /*
+   * Whether the operation in flight, if any, leaves no state behind when it
+   * fails. Most manager operations program several SAI objects or
+   * attributes one at a time and have no such guarantee, so a failure in
+   * one of them can only be reverted by the full rollback().
+   */
+  bool inFlightOpAtomic_{true};
   SaiPlatform* platform_;
   Callback* callback_{nullptr};
 
   SwitchSaiId switchId_;
 
+  /*
+   * Link state and FDB notifications are pushed by the SAI callback threads
+   * (top half) into lock free queues, and drained in bulk by the bottom half
+   * threads. A drain is scheduled on the bottom half event base only if one
+   * is not already pending, so a storm of notifications results in a few
+   * drains, each of which merges events for the same port/MAC and takes
+   * saiSwitchMutex_ once.
+   */
+  template <typename T>
+  struct QueuedNotification {
+    T data;
+    std::chrono::steady_clock::time_point received;
+  };
+  using LinkStateNotification =
+      QueuedNotification<sai_port_oper_status_notification_t>;
+  using FdbNotification = QueuedNotification<FdbEventNotificationData>;
+
   std::unique_ptr<std::thread> linkStateBottomHalfThread_;
   folly::EventBase linkStateBottomHalfEventBase_;
+  folly::UMPSCQueue<LinkStateNotification, false> linkStateEventQueue_;
+  std::atomic<bool> linkStateDrainScheduled_{false};
   std::unique_ptr<std::thread> fdbEventBottomHalfThread_;
   folly::EventBase fdbEventBottomHalfEventBase_;
+  folly::UMPSCQueue<FdbNotification, false> fdbEventQueue_;
+  std::atomic<bool> fdbDrainScheduled_{false};
 
   HwResourceStats hwResourceStats_;
   std::atomic<SwitchRunState> runState_{SwitchRunState::UNINITIALIZED};
@@ -6,9 +6,39 @@ namespace py3 neteng.fboss
 include "fboss/agent/if/fboss.thrift"
 include "fboss/agent/if/ctrl.thrift"
 
+// Latency of the SAI calls of one api, object type and operation
+struct SaiCallLatency {
+  1: string api,
+  // Empty where the object type is not known, i.e. for calls taking just an
+  // adapter key
+  2: string objectType,
+  3: string operation,
+  4: i64 calls,
+  5: i64 totalUsecs,
+  6: i64 maxUsecs,
+  // Number of calls by the upper bound of their latency bucket, in usecs
+  7: map<i64, i64> histogram,
+}
+
+struct SaiSlowCall {
+  1: string api,
+  2: string objectType,
+  3: string operation,
+  4: i64 usecs,
+  // Adapter key and attributes of the call
+  5: string summary,
+}
+
+struct SaiCallStats {
+  1: list<SaiCallLatency> latencies,
+  // Slowest first
+  2: list<SaiSlowCall> slowestCalls,
+}
+
 service SaiCtrl extends ctrl.FbossCtrl {
   string, stream<string> startDiagShell()
     throws (1: fboss.FbossBaseError error)
   void produceDiagShellInput(1: string input, 2: ctrl.ClientInformation client)
     throws (1: fboss.FbossBaseError error)
+  SaiCallStats getSaiCallStats()
 }
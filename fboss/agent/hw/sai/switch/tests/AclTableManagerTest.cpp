@@ -224,3 +224,99 @@ TEST_F(AclTableManagerTest, checkNonExistentAclEntry) {
       aclTableHandle, kPriority());
   EXPECT_FALSE(aclEntryHandle);
 }
+
+TEST_F(AclTableManagerTest, changeAclEntryActionInPlace) {
+  auto aclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  aclEntry->setDscp(kDscp());
+  aclEntry->setActionType(kActionType());
+
+  AclEntrySaiId aclEntryId = saiManagerTable->aclTableManager().addAclEntry(
+      aclEntry, SaiSwitch::kAclTable1);
+
+  auto counter = cfg::TrafficCounter();
+  *counter.name_ref() = "stat0.c";
+  MatchAction action = MatchAction();
+  action.setTrafficCounter(counter);
+
+  auto newAclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  newAclEntry->setDscp(kDscp());
+  newAclEntry->setActionType(kActionType());
+  newAclEntry->setAclAction(action);
+
+  saiManagerTable->aclTableManager().changedAclEntry(
+      aclEntry, newAclEntry, SaiSwitch::kAclTable1);
+
+  auto aclTableHandle = saiManagerTable->aclTableManager().getAclTableHandle(
+      SaiSwitch::kAclTable1);
+  auto aclEntryHandle = saiManagerTable->aclTableManager().getAclEntryHandle(
+      aclTableHandle, kPriority());
+  // Same SAI object, only the counter action was set
+  EXPECT_EQ(aclEntryHandle->aclEntry->adapterKey(), aclEntryId);
+  EXPECT_TRUE(aclEntryHandle->aclCounter);
+  auto aclCounterIdGot =
+      saiApiTable->aclApi()
+          .getAttribute(
+              aclEntryId, SaiAclEntryTraits::Attributes::ActionCounter())
+          .getData();
+  EXPECT_EQ(aclCounterIdGot, aclEntryHandle->aclCounter->adapterKey());
+  EXPECT_EQ(
+      saiManagerTable->aclTableManager().getAclEntriesUpdatedInPlace(), 1);
+  EXPECT_EQ(saiManagerTable->aclTableManager().getAclEntriesRecreated(), 0);
+}
+
+TEST_F(AclTableManagerTest, changeAclEntryQualifierRecreates) {
+  auto aclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  aclEntry->setDscp(kDscp());
+  aclEntry->setActionType(kActionType());
+
+  saiManagerTable->aclTableManager().addAclEntry(
+      aclEntry, SaiSwitch::kAclTable1);
+
+  auto newAclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  newAclEntry->setDscp(kDscp2());
+  newAclEntry->setActionType(kActionType());
+
+  saiManagerTable->aclTableManager().changedAclEntry(
+      aclEntry, newAclEntry, SaiSwitch::kAclTable1);
+
+  auto aclTableHandle = saiManagerTable->aclTableManager().getAclTableHandle(
+      SaiSwitch::kAclTable1);
+  auto aclEntryHandle = saiManagerTable->aclTableManager().getAclEntryHandle(
+      aclTableHandle, kPriority());
+  auto dscpGot = saiApiTable->aclApi().getAttribute(
+      aclEntryHandle->aclEntry->adapterKey(),
+      SaiAclEntryTraits::Attributes::FieldDscp());
+  EXPECT_EQ(dscpGot.getDataAndMask().first, kDscp2());
+  EXPECT_EQ(
+      saiManagerTable->aclTableManager().getAclEntriesUpdatedInPlace(), 0);
+  EXPECT_EQ(saiManagerTable->aclTableManager().getAclEntriesRecreated(), 1);
+}
+
+TEST_F(AclTableManagerTest, changeAclEntryActionUnsetRecreates) {
+  auto counter = cfg::TrafficCounter();
+  *counter.name_ref() = "stat0.c";
+  MatchAction action = MatchAction();
+  action.setTrafficCounter(counter);
+
+  auto aclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  aclEntry->setDscp(kDscp());
+  aclEntry->setActionType(kActionType());
+  aclEntry->setAclAction(action);
+
+  saiManagerTable->aclTableManager().addAclEntry(
+      aclEntry, SaiSwitch::kAclTable1);
+
+  auto newAclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  newAclEntry->setDscp(kDscp());
+  newAclEntry->setActionType(kActionType());
+
+  saiManagerTable->aclTableManager().changedAclEntry(
+      aclEntry, newAclEntry, SaiSwitch::kAclTable1);
+
+  auto aclTableHandle = saiManagerTable->aclTableManager().getAclTableHandle(
+      SaiSwitch::kAclTable1);
+  auto aclEntryHandle = saiManagerTable->aclTableManager().getAclEntryHandle(
+      aclTableHandle, kPriority());
+  EXPECT_FALSE(aclEntryHandle->aclCounter);
+  EXPECT_EQ(saiManagerTable->aclTableManager().getAclEntriesRecreated(), 1);
+}
@@ -18,6 +18,9 @@
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/types.h"
 
+#include <folly/Format.h>
+#include <gflags/gflags.h>
+
 using namespace facebook::fboss;
 class RouteManagerTest : public ManagerTestBase {
  public:
@@ -301,6 +304,106 @@ TEST_F(RouteManagerTest, updateCpuRoutetoNextHopRoute) {
   EXPECT_FALSE(saiRouteHandle->nextHopGroupHandle());
 }
 
+class ConcurrentRouteManagerTest : public RouteManagerTest {
+ public:
+  using RouteChanges = std::vector<SaiRouteChange<folly::IPAddressV4>>;
+
+  void SetUp() override {
+    FLAGS_sai_route_programming_threads = 4;
+    RouteManagerTest::SetUp();
+  }
+
+  // Routes alternate between an ECMP next hop and a single next hop
+  RouteChanges addRoutes(int numRoutes) const {
+    RouteChanges changes;
+    for (int i = 0; i < numRoutes; ++i) {
+      TestRoute tr;
+      tr.destination = {
+          folly::IPAddress(folly::sformat("10.{}.{}.0", i / 256, i % 256)),
+          24};
+      if (i % 2) {
+        tr.nextHopInterfaces = {testInterfaces.at(1)};
+      } else {
+        tr.nextHopInterfaces = tr1.nextHopInterfaces;
+      }
+      changes.push_back({nullptr, makeRoute(tr)});
+    }
+    return changes;
+  }
+
+  size_t programRoutes(const RouteChanges& changes) {
+    size_t applied = 0;
+    saiManagerTable->routeManager().programRoutes<folly::IPAddressV4>(
+        changes, RouterID(0), [&applied](const auto&) { ++applied; });
+    return applied;
+  }
+
+  SaiRouteHandle* getRouteHandle(
+      const std::shared_ptr<Route<folly::IPAddressV4>>& route) {
+    auto entry = saiManagerTable->routeManager().routeEntryFromSwRoute(
+        RouterID(0), route);
+    return saiManagerTable->routeManager().getRouteHandle(entry);
+  }
+
+  gflags::FlagSaver flagSaver;
+};
+
+TEST_F(ConcurrentRouteManagerTest, addChangeRemoveRoutes) {
+  ASSERT_TRUE(saiManagerTable->routeManager().concurrentRouteProgramming());
+  auto fs = FakeSai::getInstance();
+  auto numFakeRoutes = fs->routeManager.map().size();
+
+  auto added = addRoutes(1000);
+  EXPECT_EQ(added.size(), programRoutes(added));
+  EXPECT_EQ(numFakeRoutes + added.size(), fs->routeManager.map().size());
+  for (const auto& change : added) {
+    EXPECT_TRUE(getRouteHandle(change.newRoute));
+  }
+
+  tr1.nextHopInterfaces = {testInterfaces.at(4), testInterfaces.at(5)};
+  RouteChanges changed;
+  for (const auto& change : added) {
+    tr1.destination = {
+        change.newRoute->prefix().network, change.newRoute->prefix().mask};
+    changed.push_back({change.newRoute, makeRoute(tr1)});
+  }
+  EXPECT_EQ(changed.size(), programRoutes(changed));
+  for (const auto& change : changed) {
+    auto nextHopGroupHandle =
+        getRouteHandle(change.newRoute)->nextHopGroupHandle();
+    ASSERT_TRUE(nextHopGroupHandle);
+    EXPECT_EQ(2, nextHopGroupHandle->members_.size());
+  }
+
+  RouteChanges removed;
+  for (const auto& change : changed) {
+    removed.push_back({change.newRoute, nullptr});
+  }
+  EXPECT_EQ(removed.size(), programRoutes(removed));
+  EXPECT_EQ(numFakeRoutes, fs->routeManager.map().size());
+  for (const auto& change : removed) {
+    EXPECT_FALSE(getRouteHandle(change.oldRoute));
+  }
+}
+
+TEST_F(ConcurrentRouteManagerTest, invalidBatch) {
+  auto fs = FakeSai::getInstance();
+  auto numFakeRoutes = fs->routeManager.map().size();
+  auto changes = addRoutes(1000);
+  // Adding a route that already exists fails the whole batch
+  auto r1 = makeRoute(tr1);
+  saiManagerTable->routeManager().addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  changes.push_back({nullptr, r1});
+  size_t applied = 0;
+  EXPECT_THROW(
+      saiManagerTable->routeManager().programRoutes<folly::IPAddressV4>(
+          changes, RouterID(0), [&applied](const auto&) { ++applied; }),
+      FbossError);
+  EXPECT_EQ(0, applied);
+  EXPECT_EQ(numFakeRoutes + 1, fs->routeManager.map().size());
+  EXPECT_FALSE(getRouteHandle(changes.front().newRoute));
+}
+
 /*
  * Test for ToMe routes doesn't want to do all the setup, because
  * setting up the router interfaces will result in creating ToMeRoutes
@@ -158,6 +158,32 @@ struct L2EntryThrift {
   6: optional i32 classID,
 }
 
+enum L2LearningEventType {
+  // A MAC was learned
+  LEARN = 0,
+  // A MAC aged out or was removed
+  AGE = 1,
+  // A MAC was learned on a different port than it was last learned on
+  MOVE = 2,
+}
+
+/*
+ * An L2 learning callback from the hardware, as seen by the agent. Only
+ * generated with SOFTWARE L2 learning, as the agent does not hear of MACs
+ * the hardware learns by itself.
+ */
+struct L2LearningEvent {
+  1: L2LearningEventType type,
+  // For AGE, the entry that went away
+  2: L2EntryThrift entry,
+  // For MOVE, the port (or trunk) the MAC was last learned on. Only one of
+  // them is set.
+  3: optional i32 oldPort,
+  4: optional i32 oldTrunk,
+  // When the agent got the callback, in microseconds since the epoch
+  5: i64 timestampUsecs,
+}
+
 enum LacpPortRateThrift {
   SLOW = 0,
   FAST = 1,
@@ -829,6 +855,13 @@ service FbossCtrl extends fb303.FacebookService {
     throws (1: fboss.FbossBaseError error)
   list<L2EntryThrift> getL2Table()
     throws (1: fboss.FbossBaseError error)
+
+  /*
+   * Stream L2 learning events as the hardware reports them, from the time
+   * of subscribing on
+   */
+  stream<L2LearningEvent> subscribeL2LearningEvents()
+    throws (1: fboss.FbossBaseError error)
   list<AclEntryThrift> getAclTable()
     throws (1: fboss.FbossBaseError error)
 
@@ -56,6 +56,10 @@ class SaiFakePlatform : public SaiPlatform {
 
   void initLEDs() override {}
 
+  bool isRouteApiThreadSafe() const override {
+    return true;
+  }
+
  private:
   folly::test::TemporaryDirectory tmpDir_;
   std::unique_ptr<FakeAsic> asic_;
@@ -113,6 +113,14 @@ class SaiPlatform : public Platform, public StateObserver {
     return std::nullopt;
   }
 
+  /*
+   * Whether the adapter's route entry functions may be called concurrently,
+   * from several threads, for different route entries.
+   */
+  virtual bool isRouteApiThreadSafe() const {
+    return false;
+  }
+
  private:
   void initImpl(uint32_t hwFeaturesDesired) override;
   void initSaiProfileValues();
@@ -69,7 +69,8 @@ std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
 ForwardingInformationBaseUpdater::createUpdatedFib(
     const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
     const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
-        fib) {
+        fib,
+    FibDelta<AddressT>* delta) {
   typename facebook::fboss::ForwardingInformationBase<
       AddressT>::Base::NodeContainer updatedFib;
 
@@ -96,22 +97,31 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
       } else {
         updated = true;
         fibRoute = toFibRoute(ribRoute, fibRoute);
+        if (delta) {
+          delta->addedOrChanged.push_back(fibRoute);
+        }
       }
     } else {
       // new route
       updated = true;
       fibRoute = toFibRoute(ribRoute, fibRoute);
+      if (delta) {
+        delta->addedOrChanged.push_back(fibRoute);
+      }
     }
 
     updatedFib.emplace_hint(updatedFib.cend(), fibPrefix, fibRoute);
   }
   // Check for deleted routes. Routes that were in the previous FIB
-  // and have now been removed
+  // and have now been removed, or are no longer resolved
   for (const auto& fibEntry : *fib) {
     const auto& prefix = fibEntry->prefix();
-    if (rib.exactMatch(prefix.network, prefix.mask) == rib.end()) {
+    if (updatedFib.find(prefix) == updatedFib.end()) {
       updated = true;
-      break;
+      if (!delta) {
+        break;
+      }
+      delta->removed.push_back(prefix);
     }
   }
 
@@ -169,9 +179,11 @@ ForwardingInformationBaseUpdater::toFibRoute(
   fibPrefix.network = ribRoute.prefix().network;
   fibPrefix.mask = ribRoute.prefix().mask;
 
+  using FibRoute = facebook::fboss::Route<AddrT>;
   auto fibRoute = curFibRoute
       ? curFibRoute->clone()
-      : std::make_shared<facebook::fboss::Route<AddrT>>(fibPrefix);
+      : std::allocate_shared<FibRoute>(
+            facebook::fboss::StateNodeAllocator<FibRoute>(), fibPrefix);
 
   fibRoute->setResolved(toFibNextHop(ribRoute.getForwardInfo()));
   if (ribRoute.isConnected()) {
@@ -182,6 +194,17 @@ ForwardingInformationBaseUpdater::toFibRoute(
   return fibRoute;
 }
 
+template std::shared_ptr<ForwardingInformationBase<folly::IPAddressV4>>
+ForwardingInformationBaseUpdater::createUpdatedFib<folly::IPAddressV4>(
+    const NetworkToRouteMap<folly::IPAddressV4>&,
+    const std::shared_ptr<ForwardingInformationBase<folly::IPAddressV4>>&,
+    FibDelta<folly::IPAddressV4>*);
+template std::shared_ptr<ForwardingInformationBase<folly::IPAddressV6>>
+ForwardingInformationBaseUpdater::createUpdatedFib<folly::IPAddressV6>(
+    const NetworkToRouteMap<folly::IPAddressV6>&,
+    const std::shared_ptr<ForwardingInformationBase<folly::IPAddressV6>>&,
+    FibDelta<folly::IPAddressV6>*);
+
 template std::shared_ptr<facebook::fboss::Route<folly::IPAddressV4>>
 ForwardingInformationBaseUpdater::toFibRoute<folly::IPAddressV4>(
     const Route<folly::IPAddressV4>&,
@@ -17,6 +17,7 @@
 #include "fboss/agent/types.h"
 
 #include <memory>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -38,6 +39,30 @@ class ForwardingInformationBaseUpdater {
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
 
+  /*
+   * Routes a FIB update adds or changes, and prefixes it removes
+   */
+  template <typename AddressT>
+  struct FibDelta {
+    std::vector<std::shared_ptr<facebook::fboss::Route<AddressT>>>
+        addedOrChanged;
+    std::vector<facebook::fboss::RoutePrefix<AddressT>> removed;
+  };
+
+  /*
+   * Return the FIB for the resolved routes in rib, reusing routes of fib
+   * that did not change, or null if it would be the same as fib. If delta is
+   * given, the differences from fib are added to it.
+   */
+  template <typename AddressT>
+  static std::shared_ptr<
+      typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  createUpdatedFib(
+      const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib,
+      FibDelta<AddressT>* delta = nullptr);
+
   static facebook::fboss::RouteNextHopEntry toFibNextHop(
       const RouteNextHopEntry& ribNextHopEntry);
   template <typename AddrT>
@@ -47,16 +72,6 @@ class ForwardingInformationBaseUpdater {
           nullptr);
 
  private:
-  /*
-   * Return updated FIB on change, null otherwise
-   */
-  template <typename AddressT>
-  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
-  createUpdatedFib(
-      const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
-      const std::shared_ptr<
-          facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
-
   RouterID vrf_;
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
@@ -84,6 +84,7 @@ void RoutingInformationBase::reconfigure(
 
     *lockedRouteTables = constructRouteTables(
         lockedRouteTables, configRouterIDToInterfaceRoutes);
+    ++reconfigureGeneration_;
 
     // Because of this sequential loop over each VRF, config application scales
     // linearly with the number of VRFs. If FBOSS is run in a multi-VRF routing
@@ -118,6 +119,7 @@ void RoutingInformationBase::reconfigure(
       configApplier.updateRibAndFib();
     }
   };
+  ++reconfigureRequests_;
   ribUpdateEventBase_.runInEventBaseThreadAndWait(updateFn);
 }
 
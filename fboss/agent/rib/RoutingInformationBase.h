@@ -16,6 +16,7 @@
 
 #include <folly/Synchronized.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -123,6 +124,23 @@ class RoutingInformationBase {
     return !(*this == other);
   }
 
+  /*
+   * Bumped each time reconfigure() recomputes the FIBs of every VRF from the
+   * RIB, which supersedes any FIB update computed before it.
+   */
+  uint64_t getReconfigureGeneration() const {
+    return reconfigureGeneration_.load();
+  }
+
+  /*
+   * Whether a reconfigure() call is waiting for the RIB thread. FIB update
+   * callbacks which block the RIB thread on the update thread must not wait
+   * while this is set, as reconfigure() is called from the update thread.
+   */
+  bool isReconfigurePending() const {
+    return reconfigureRequests_.load() != reconfigureGeneration_.load();
+  }
+
   void waitForRibUpdates() {
     ribUpdateEventBase_.runInEventBaseThreadAndWait([] { return; });
   }
@@ -167,6 +185,9 @@ class RoutingInformationBase {
           configRouterIDToInterfaceRoutes) const;
 
   SynchronizedRouteTables synchronizedRouteTables_;
+  std::atomic<uint64_t> reconfigureGeneration_{0};
+  // Bumped as reconfigure() is called, ahead of reconfigureGeneration_
+  std::atomic<uint64_t> reconfigureRequests_{0};
   std::unique_ptr<std::thread> ribUpdateThread_;
   folly::EventBase ribUpdateEventBase_;
 };
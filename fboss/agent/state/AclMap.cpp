@@ -38,6 +38,6 @@ FBOSS_INSTANTIATE_NODE_MAP(PrioAclMap, PrioAclMapTraits);
 template class NodeMapDelta<
     PrioAclMap,
     DeltaValue<PrioAclMap::Node>,
-    MapUniquePointerTraits<PrioAclMap>>;
+    MapSharedPointerTraits<PrioAclMap>>;
 
 } // namespace facebook::fboss
@@ -98,6 +98,6 @@ class PrioAclMap : public NodeMapT<PrioAclMap, PrioAclMapTraits> {
 using AclMapDelta = NodeMapDelta<
     PrioAclMap,
     DeltaValue<PrioAclMap::Node>,
-    MapUniquePointerTraits<PrioAclMap>>;
+    MapSharedPointerTraits<PrioAclMap>>;
 
 } // namespace facebook::fboss
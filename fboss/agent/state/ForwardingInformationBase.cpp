@@ -30,6 +30,28 @@ template <typename AddressT>
 std::shared_ptr<Route<AddressT>>
 ForwardingInformationBase<AddressT>::longestMatch(
     const AddressT& address) const {
+  if (!Base::isPublished()) {
+    // Routes may still be added or removed, so we can't index them yet
+    return longestMatchScan(address);
+  }
+  folly::call_once(lpmIndexBuilt_, [this]() {
+    auto lpmIndex = std::make_unique<LpmIndex>();
+    for (const auto& prefixAndRoute : Base::getAllNodes()) {
+      lpmIndex->insert(
+          prefixAndRoute.first.network,
+          prefixAndRoute.first.mask,
+          prefixAndRoute.second);
+    }
+    lpmIndex_ = std::move(lpmIndex);
+  });
+  auto itr = lpmIndex_->longestMatch(address, address.bitCount());
+  return itr != lpmIndex_->end() ? itr->value() : nullptr;
+}
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>>
+ForwardingInformationBase<AddressT>::longestMatchScan(
+    const AddressT& address) const {
   std::shared_ptr<Route<AddressT>> longestMatchRoute = nullptr;
   // longestCommonLength must be wider than int8_t because it needs to hold
   // values in the range [-1, 128].
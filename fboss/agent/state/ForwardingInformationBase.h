@@ -12,9 +12,13 @@
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/lib/RadixTree.h"
 
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/synchronization/CallOnce.h>
+
+#include <memory>
 
 namespace facebook::fboss {
 
@@ -42,12 +46,26 @@ class ForwardingInformationBase
     return exactMatch(prefix);
   }
 
+  /*
+   * Published FIBs are immutable, so the first longestMatch() on one builds
+   * a radix tree index of its routes that all later lookups use. Lookups on
+   * an unpublished FIB scan every route.
+   */
   std::shared_ptr<Route<AddressT>> longestMatch(const AddressT& address) const;
 
  private:
+  using LpmIndex = facebook::network::
+      RadixTree<AddressT, std::shared_ptr<Route<AddressT>>>;
+
+  std::shared_ptr<Route<AddressT>> longestMatchScan(
+      const AddressT& address) const;
+
   // Inherit the constructors required for clone()
   using Base::Base;
   friend class CloneAllocator;
+
+  mutable folly::once_flag lpmIndexBuilt_;
+  mutable std::unique_ptr<LpmIndex> lpmIndex_;
 };
 
 using ForwardingInformationBaseV4 =
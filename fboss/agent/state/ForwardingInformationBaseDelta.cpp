@@ -15,6 +15,9 @@ namespace facebook::fboss {
 
 NodeMapDelta<ForwardingInformationBaseV4>
 ForwardingInformationBaseContainerDelta::getV4FibDelta() const {
+  if (memoized_) {
+    return memoized_->v4FibDelta;
+  }
   return NodeMapDelta<ForwardingInformationBaseV4>(
       getOld() ? getOld()->getFibV4().get() : nullptr,
       getNew() ? getNew()->getFibV4().get() : nullptr);
@@ -22,11 +25,25 @@ ForwardingInformationBaseContainerDelta::getV4FibDelta() const {
 
 NodeMapDelta<ForwardingInformationBaseV6>
 ForwardingInformationBaseContainerDelta::getV6FibDelta() const {
+  if (memoized_) {
+    return memoized_->v6FibDelta;
+  }
   return NodeMapDelta<ForwardingInformationBaseV6>(
       getOld() ? getOld()->getFibV6().get() : nullptr,
       getNew() ? getNew()->getFibV6().get() : nullptr);
 }
 
+void ForwardingInformationBaseContainerDelta::memoize() {
+  if (memoized_) {
+    return;
+  }
+  auto memoized = std::make_shared<MemoizedDeltas>(
+      MemoizedDeltas{getV4FibDelta(), getV6FibDelta()});
+  memoized->v4FibDelta.memoize();
+  memoized->v6FibDelta.memoize();
+  memoized_ = std::move(memoized);
+}
+
 template class NodeMapDelta<ForwardingInformationBaseV4>;
 template class NodeMapDelta<ForwardingInformationBaseV6>;
 template class NodeMapDelta<
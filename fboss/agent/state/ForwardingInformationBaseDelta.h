@@ -32,6 +32,18 @@ class ForwardingInformationBaseContainerDelta
       return getV6FibDelta();
     }
   }
+
+  /*
+   * Memoize the v4 and v6 FIB deltas, see NodeMapDelta::memoize()
+   */
+  void memoize();
+
+ private:
+  struct MemoizedDeltas {
+    NodeMapDelta<ForwardingInformationBaseV4> v4FibDelta;
+    NodeMapDelta<ForwardingInformationBaseV6> v6FibDelta;
+  };
+  std::shared_ptr<const MemoizedDeltas> memoized_;
 };
 
 using ForwardingInformationBaseMapDelta = NodeMapDelta<
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/NodeArena.h"
+
+#include <glog/logging.h>
+
+DEFINE_bool(
+    state_node_arenas,
+    false,
+    "Allocate the nodes cloned by each state update from an arena freed in "
+    "bulk once the nodes are all gone");
+
+namespace {
+
+constexpr size_t kAlignment = alignof(std::max_align_t);
+
+thread_local facebook::fboss::NodeArena* currentArena{nullptr};
+thread_local facebook::fboss::StateNodeAllocations threadAllocs;
+
+std::atomic<uint64_t> numLiveArenas{0};
+
+size_t alignUp(size_t bytes) {
+  return (bytes + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+NodeArena::Scope::Scope()
+    : prevArena_(currentArena), start_(threadAllocs) {
+  if (FLAGS_state_node_arenas) {
+    arena_ = new NodeArena();
+    currentArena = arena_;
+  }
+}
+
+NodeArena::Scope::~Scope() {
+  if (arena_) {
+    DCHECK_EQ(currentArena, arena_);
+    currentArena = prevArena_;
+    arena_->release();
+  }
+}
+
+StateNodeAllocations NodeArena::Scope::allocations() const {
+  return threadAllocs - start_;
+}
+
+NodeArena* NodeArena::current() {
+  return currentArena;
+}
+
+StateNodeAllocations NodeArena::threadAllocations() {
+  return threadAllocs;
+}
+
+uint64_t NodeArena::liveArenas() {
+  return numLiveArenas.load(std::memory_order_relaxed);
+}
+
+void NodeArena::recordAllocation(size_t bytes, bool fromArena) {
+  ++threadAllocs.allocations;
+  threadAllocs.bytes += bytes;
+  if (fromArena) {
+    ++threadAllocs.arenaAllocations;
+  }
+}
+
+NodeArena::NodeArena() {
+  numLiveArenas.fetch_add(1, std::memory_order_relaxed);
+}
+
+NodeArena::~NodeArena() {
+  numLiveArenas.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void* NodeArena::allocate(size_t bytes) {
+  DCHECK_EQ(currentArena, this) << "Arena allocation outside of its scope";
+  bytes = alignUp(bytes);
+  if (bytes > kMaxChunkAllocation) {
+    chunks_.emplace_back(new char[bytes]);
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    return chunks_.back().get();
+  }
+  if (static_cast<size_t>(end_ - next_) < bytes) {
+    chunks_.emplace_back(new char[kChunkSize]);
+    next_ = chunks_.back().get();
+    end_ = next_ + kChunkSize;
+  }
+  auto p = next_;
+  next_ += bytes;
+  refs_.fetch_add(1, std::memory_order_relaxed);
+  return p;
+}
+
+void NodeArena::deallocate() noexcept {
+  release();
+}
+
+void NodeArena::release() noexcept {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+} // namespace facebook::fboss
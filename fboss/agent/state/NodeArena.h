@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+DECLARE_bool(state_node_arenas);
+
+namespace facebook::fboss {
+
+/*
+ * SwitchState node allocations made through StateNodeAllocator
+ */
+struct StateNodeAllocations {
+  uint64_t allocations{0};
+  uint64_t bytes{0};
+  // Of the above, the allocations carved out of an arena
+  uint64_t arenaAllocations{0};
+
+  StateNodeAllocations operator-(const StateNodeAllocations& other) const {
+    return {
+        allocations - other.allocations,
+        bytes - other.bytes,
+        arenaAllocations - other.arenaAllocations};
+  }
+};
+
+/*
+ * NodeArena bulk allocates the nodes cloned while building one SwitchState
+ * version.
+ *
+ * A state update clones the SwitchState, and every node on the path to what
+ * it changes, each clone being an allocate_shared of the node and its
+ * control block. While a NodeArena::Scope is active on a thread, those
+ * allocations are carved out of 64KB chunks owned by the scope's arena
+ * instead of each going to malloc. Nodes never return their memory to the
+ * arena: it frees all of its chunks at once, when the scope has ended and
+ * the last node allocated from it is gone, i.e. once no published state
+ * still refers to any node of that generation.
+ *
+ * The flip side is that one long lived node keeps its whole arena alive, so
+ * arenas are only used with --state_node_arenas.
+ *
+ * Arena allocations are only made on the thread the scope is active on.
+ * Nodes can be freed from any thread.
+ */
+class NodeArena {
+ public:
+  static constexpr size_t kChunkSize = 64 * 1024;
+  // Larger allocations get a chunk of their own
+  static constexpr size_t kMaxChunkAllocation = kChunkSize / 8;
+
+  class Scope {
+   public:
+    /*
+     * Make a new arena current on this thread for the scope, if
+     * --state_node_arenas is set. Allocations are counted either way.
+     */
+    Scope();
+    ~Scope();
+
+    // Allocations made on this thread since the scope started
+    StateNodeAllocations allocations() const;
+
+   private:
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+    NodeArena* arena_{nullptr};
+    NodeArena* prevArena_{nullptr};
+    StateNodeAllocations start_;
+  };
+
+  // The arena of the innermost scope active on this thread, if any
+  static NodeArena* current();
+
+  // Allocations made on this thread so far
+  static StateNodeAllocations threadAllocations();
+
+  // Arenas not freed yet
+  static uint64_t liveArenas();
+
+  void* allocate(size_t bytes);
+  void deallocate() noexcept;
+
+  // Count an allocation on this thread
+  static void recordAllocation(size_t bytes, bool fromArena);
+
+ private:
+  NodeArena();
+  ~NodeArena();
+
+  // Forbidden copy constructor and assignment operator
+  NodeArena(NodeArena const&) = delete;
+  NodeArena& operator=(NodeArena const&) = delete;
+
+  void release() noexcept;
+
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  char* next_{nullptr};
+  char* end_{nullptr};
+  // Allocations not yet freed, plus one while the scope is active
+  std::atomic<uint64_t> refs_{1};
+};
+
+/*
+ * Allocator for SwitchState nodes, allocating from the current NodeArena if
+ * there is one, or else from the heap.
+ *
+ * The arena is captured when the allocator is constructed, and
+ * allocate_shared keeps a copy of the allocator in the control block to
+ * free the node with, so nodes go back to where they came from whichever
+ * thread frees them.
+ */
+template <typename T>
+class StateNodeAllocator {
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = StateNodeAllocator<U>;
+  };
+
+  StateNodeAllocator() : arena_(NodeArena::current()) {}
+
+  template <typename U>
+  StateNodeAllocator(const StateNodeAllocator<U>& other)
+      : arena_(other.arena_) {}
+
+  T* allocate(size_t n) {
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "Over aligned types can't be allocated from a NodeArena");
+    auto bytes = n * sizeof(T);
+    NodeArena::recordAllocation(bytes, arena_ != nullptr);
+    if (arena_) {
+      return static_cast<T*>(arena_->allocate(bytes));
+    }
+    return static_cast<T*>(::operator new(bytes));
+  }
+
+  void deallocate(T* p, size_t /*n*/) noexcept {
+    if (arena_) {
+      arena_->deallocate();
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  template <typename U>
+  bool operator==(const StateNodeAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const StateNodeAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class StateNodeAllocator;
+
+  NodeArena* arena_;
+};
+
+} // namespace facebook::fboss
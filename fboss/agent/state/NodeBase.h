@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/agent/Utils.h"
+#include "fboss/agent/state/NodeArena.h"
 #include "fboss/agent/types.h"
 
 #include <boost/cast.hpp>
@@ -171,9 +172,9 @@ class NodeBaseT : public NodeBase {
    * published and committed.
    *
    * The new node is returned as a shared_ptr for efficient allocation with
-   * make_shared (since published node objects must eventually be stored in a
-   * shared_ptr).  However, the caller is the sole owner of the new object when
-   * it is returned.
+   * allocate_shared (since published node objects must eventually be stored
+   * in a shared_ptr).  However, the caller is the sole owner of the new object
+   * when it is returned.  The node comes from the current NodeArena, if any.
    */
   std::shared_ptr<Node> clone() const;
 
@@ -236,7 +237,7 @@ class NodeBaseT : public NodeBase {
         fields_(orig->fields_, std::forward<Args>(args)...) {}
 
  protected:
-  class CloneAllocator : public std::allocator<NodeT> {
+  class CloneAllocator : public StateNodeAllocator<NodeT> {
    public:
     template <typename... Args>
     void construct(void* p, Args&&... args) {
@@ -73,6 +73,10 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::updateValue() {
 
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
+  if (memoized_) {
+    ++change_;
+    return;
+  }
   // If we have already hit the end of one side, advance the other.
   // We are immediately done after this.
   if (oldIt_ == oldMap_->end()) {
@@ -109,4 +113,33 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
   updateValue();
 }
 
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::memoize() {
+  if (changes_) {
+    return;
+  }
+  auto changes = std::make_shared<std::vector<VALUE>>();
+  for (auto it = walkBegin(); it != walkEnd(); ++it) {
+    changes->push_back(*it);
+    if constexpr (detail::HasMemoize<VALUE>::value) {
+      changes->back().memoize();
+    }
+  }
+  changes_ = std::move(changes);
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+std::vector<typename MAP::KeyType>
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::getChangedKeys() const {
+  std::vector<KeyType> keys;
+  if (changes_) {
+    keys.reserve(changes_->size());
+  }
+  for (const auto& change : *this) {
+    keys.push_back(MAP::Traits::getKey(
+        change.getOld() ? change.getOld() : change.getNew()));
+  }
+  return keys;
+}
+
 } // namespace facebook::fboss
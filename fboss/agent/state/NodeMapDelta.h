@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <folly/functional/ApplyTuple.h>
 
@@ -49,12 +50,41 @@ class MapUniquePointerTraits {
     return map.get();
   }
 };
+
+template <typename MAP>
+class MapSharedPointerTraits {
+ public:
+  using RawConstPointerType = const MAP*;
+  // For maps created on the fly, like MapUniquePointerTraits, but letting
+  // copies of the delta share them.
+  using MapPointerType = std::shared_ptr<MAP>;
+  static RawConstPointerType getRawPointer(const MapPointerType& map) {
+    return map.get();
+  }
+};
+
+namespace detail {
+// Whether delta values have sub-deltas of their own to memoize
+template <typename VALUE, typename = void>
+struct HasMemoize : std::false_type {};
+template <typename VALUE>
+struct HasMemoize<
+    VALUE,
+    std::void_t<decltype(std::declval<VALUE&>().memoize())>>
+    : std::true_type {};
+} // namespace detail
+
 /*
  * NodeMapDelta contains code for examining the differences between two NodeMap
  * objects.
  *
  * The main function of this class is the Iterator that it provides.  This
  * allows caller to walk over the changed, added, and removed nodes.
+ *
+ * Walking the delta walks both maps, skipping the nodes they share. A delta
+ * that is walked by several callers can instead be memoized: memoize() walks
+ * the maps once and records the changes, which the delta and all of its
+ * copies then iterate over directly.
  */
 template <
     typename MAP,
@@ -65,6 +95,7 @@ class NodeMapDelta {
   using MapPointerType = typename MAPPOINTERTRAITS::MapPointerType;
   using RawConstPointerType = typename MAPPOINTERTRAITS::RawConstPointerType;
   using Node = typename MAP::Node;
+  using KeyType = typename MAP::KeyType;
   class Iterator;
 
   NodeMapDelta(MapPointerType&& oldMap, MapPointerType&& newMap)
@@ -87,7 +118,25 @@ class NodeMapDelta {
    */
   Iterator end() const;
 
+  /*
+   * Walk the maps once and record the changes, along with those of the
+   * values' own sub-deltas, for this delta and its copies to iterate over.
+   * Not thread safe, memoize before sharing the delta.
+   */
+  void memoize();
+  bool isMemoized() const {
+    return changes_ != nullptr;
+  }
+
+  /*
+   * Keys of the changed, added and removed nodes, in key order.
+   */
+  std::vector<KeyType> getChangedKeys() const;
+
  private:
+  Iterator walkBegin() const;
+  Iterator walkEnd() const;
+
   /*
    * NodeMapDelta is used by StateDelta.  StateDelta holds a shared_ptr to
    * the old and new SwitchState objects, which in turn holds
@@ -100,6 +149,8 @@ class NodeMapDelta {
    */
   MapPointerType old_;
   MapPointerType new_;
+  // Set by memoize(), shared with copies of the delta
+  std::shared_ptr<const std::vector<VALUE>> changes_;
 };
 
 template <typename NODE>
@@ -156,13 +207,15 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
       typename MapType::Iterator oldIt,
       const MapType* newMap,
       typename MapType::Iterator newIt);
+  // Iterator over memoized changes
+  explicit Iterator(const VALUE* change) : change_(change), memoized_(true) {}
   Iterator();
 
   const value_type& operator*() const {
-    return value_;
+    return memoized_ ? *change_ : value_;
   }
   const value_type* operator->() const {
-    return &value_;
+    return memoized_ ? change_ : &value_;
   }
 
   Iterator& operator++() {
@@ -176,6 +229,9 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   }
 
   bool operator==(const Iterator& other) const {
+    if (memoized_) {
+      return change_ == other.change_;
+    }
     return oldIt_ == other.oldIt_ && newIt_ == other.newIt_;
   }
   bool operator!=(const Iterator& other) const {
@@ -193,7 +249,9 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   InnerIter newIt_{nullptr};
   const MapType* oldMap_{nullptr};
   const MapType* newMap_{nullptr};
-  VALUE value_;
+  VALUE value_{nullNode_, nullNode_};
+  const VALUE* change_{nullptr};
+  bool memoized_{false};
 
   static std::shared_ptr<Node> nullNode_;
 };
@@ -201,6 +259,24 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 typename NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator
 NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::begin() const {
+  if (changes_) {
+    return Iterator(changes_->data());
+  }
+  return walkBegin();
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+typename NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::end() const {
+  if (changes_) {
+    return Iterator(changes_->data() + changes_->size());
+  }
+  return walkEnd();
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+typename NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::walkBegin() const {
   if (old_ == new_) {
     return end();
   }
@@ -219,7 +295,7 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::begin() const {
 
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 typename NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator
-NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::end() const {
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::walkEnd() const {
   if (!old_) {
     return Iterator(getNew(), new_->end(), getNew(), new_->end());
   }
@@ -130,7 +130,8 @@ void RouteUpdater::addRouteImpl(
     newRoute->update(clientId, std::move(entry));
     XLOG(DBG3) << "Updated route " << newRoute->str();
   } else {
-    auto newRoute = make_shared<RouteT>(prefix, clientId, std::move(entry));
+    auto newRoute = std::allocate_shared<RouteT>(
+        StateNodeAllocator<RouteT>(), prefix, clientId, std::move(entry));
     rib->addRoute(newRoute);
     XLOG(DBG3) << "Added route " << newRoute->str();
   }
@@ -41,54 +41,97 @@ namespace facebook::fboss {
 
 StateDelta::~StateDelta() {}
 
+template <typename Delta, typename MakeDeltaFn>
+Delta StateDelta::getMemoized(
+    MemoizedDelta<Delta>& memoized,
+    MakeDeltaFn makeDelta) {
+  folly::call_once(memoized.once, [&memoized, &makeDelta] {
+    auto delta = makeDelta();
+    delta.memoize();
+    memoized.delta.emplace(std::move(delta));
+  });
+  // Copies share the memoized changes
+  return *memoized.delta;
+}
+
 NodeMapDelta<PortMap> StateDelta::getPortsDelta() const {
-  return NodeMapDelta<PortMap>(old_->getPorts().get(), new_->getPorts().get());
+  return getMemoized(portsDelta_, [this] {
+    return NodeMapDelta<PortMap>(
+        old_->getPorts().get(), new_->getPorts().get());
+  });
 }
 
 VlanMapDelta StateDelta::getVlansDelta() const {
-  return VlanMapDelta(old_->getVlans().get(), new_->getVlans().get());
+  return getMemoized(vlansDelta_, [this] {
+    return VlanMapDelta(old_->getVlans().get(), new_->getVlans().get());
+  });
 }
 
 NodeMapDelta<InterfaceMap> StateDelta::getIntfsDelta() const {
-  return NodeMapDelta<InterfaceMap>(
-      old_->getInterfaces().get(), new_->getInterfaces().get());
+  return getMemoized(intfsDelta_, [this] {
+    return NodeMapDelta<InterfaceMap>(
+        old_->getInterfaces().get(), new_->getInterfaces().get());
+  });
 }
 
 RTMapDelta StateDelta::getRouteTablesDelta() const {
-  return RTMapDelta(old_->getRouteTables().get(), new_->getRouteTables().get());
+  return getMemoized(routeTablesDelta_, [this] {
+    return RTMapDelta(
+        old_->getRouteTables().get(), new_->getRouteTables().get());
+  });
 }
 
 AclMapDelta StateDelta::getAclsDelta() const {
-  std::unique_ptr<PrioAclMap> oldAcls, newAcls;
-  if (old_->getAcls()) {
-    oldAcls.reset(new PrioAclMap());
-    oldAcls->addAcls(old_->getAcls());
-  }
-  if (new_->getAcls()) {
-    newAcls.reset(new PrioAclMap());
-    newAcls->addAcls(new_->getAcls());
-  }
-  return AclMapDelta(std::move(oldAcls), std::move(newAcls));
+  return getMemoized(aclsDelta_, [this] {
+    std::shared_ptr<PrioAclMap> oldAcls, newAcls;
+    if (old_->getAcls() == new_->getAcls()) {
+      // Sort the unchanged ACLs by priority just once, and share them so the
+      // delta is empty without walking them
+      if (new_->getAcls()) {
+        newAcls = std::make_shared<PrioAclMap>();
+        newAcls->addAcls(new_->getAcls());
+      }
+      oldAcls = newAcls;
+      return AclMapDelta(std::move(oldAcls), std::move(newAcls));
+    }
+    if (old_->getAcls()) {
+      oldAcls = std::make_shared<PrioAclMap>();
+      oldAcls->addAcls(old_->getAcls());
+    }
+    if (new_->getAcls()) {
+      newAcls = std::make_shared<PrioAclMap>();
+      newAcls->addAcls(new_->getAcls());
+    }
+    return AclMapDelta(std::move(oldAcls), std::move(newAcls));
+  });
 }
 
 QosPolicyMapDelta StateDelta::getQosPoliciesDelta() const {
-  return QosPolicyMapDelta(
-      old_->getQosPolicies().get(), new_->getQosPolicies().get());
+  return getMemoized(qosPoliciesDelta_, [this] {
+    return QosPolicyMapDelta(
+        old_->getQosPolicies().get(), new_->getQosPolicies().get());
+  });
 }
 
 NodeMapDelta<AggregatePortMap> StateDelta::getAggregatePortsDelta() const {
-  return NodeMapDelta<AggregatePortMap>(
-      old_->getAggregatePorts().get(), new_->getAggregatePorts().get());
+  return getMemoized(aggregatePortsDelta_, [this] {
+    return NodeMapDelta<AggregatePortMap>(
+        old_->getAggregatePorts().get(), new_->getAggregatePorts().get());
+  });
 }
 
 NodeMapDelta<SflowCollectorMap> StateDelta::getSflowCollectorsDelta() const {
-  return NodeMapDelta<SflowCollectorMap>(
-      old_->getSflowCollectors().get(), new_->getSflowCollectors().get());
+  return getMemoized(sflowCollectorsDelta_, [this] {
+    return NodeMapDelta<SflowCollectorMap>(
+        old_->getSflowCollectors().get(), new_->getSflowCollectors().get());
+  });
 }
 
 NodeMapDelta<LoadBalancerMap> StateDelta::getLoadBalancersDelta() const {
-  return NodeMapDelta<LoadBalancerMap>(
-      old_->getLoadBalancers().get(), new_->getLoadBalancers().get());
+  return getMemoized(loadBalancersDelta_, [this] {
+    return NodeMapDelta<LoadBalancerMap>(
+        old_->getLoadBalancers().get(), new_->getLoadBalancers().get());
+  });
 }
 
 DeltaValue<ControlPlane> StateDelta::getControlPlaneDelta() const {
@@ -97,13 +140,17 @@ DeltaValue<ControlPlane> StateDelta::getControlPlaneDelta() const {
 }
 
 NodeMapDelta<MirrorMap> StateDelta::getMirrorsDelta() const {
-  return NodeMapDelta<MirrorMap>(
-      old_->getMirrors().get(), new_->getMirrors().get());
+  return getMemoized(mirrorsDelta_, [this] {
+    return NodeMapDelta<MirrorMap>(
+        old_->getMirrors().get(), new_->getMirrors().get());
+  });
 }
 
 ForwardingInformationBaseMapDelta StateDelta::getFibsDelta() const {
-  return ForwardingInformationBaseMapDelta(
-      old_->getFibs().get(), new_->getFibs().get());
+  return getMemoized(fibsDelta_, [this] {
+    return ForwardingInformationBaseMapDelta(
+        old_->getFibs().get(), new_->getFibs().get());
+  });
 }
 
 DeltaValue<SwitchSettings> StateDelta::getSwitchSettingsDelta() const {
@@ -113,9 +160,11 @@ DeltaValue<SwitchSettings> StateDelta::getSwitchSettingsDelta() const {
 
 NodeMapDelta<LabelForwardingInformationBase>
 StateDelta::getLabelForwardingInformationBaseDelta() const {
-  return NodeMapDelta<LabelForwardingInformationBase>(
-      old_->getLabelForwardingInformationBase().get(),
-      new_->getLabelForwardingInformationBase().get());
+  return getMemoized(labelFibDelta_, [this] {
+    return NodeMapDelta<LabelForwardingInformationBase>(
+        old_->getLabelForwardingInformationBase().get(),
+        new_->getLabelForwardingInformationBase().get());
+  });
 }
 
 DeltaValue<QosPolicy> StateDelta::getDefaultDataPlaneQosPolicyDelta() const {
@@ -124,6 +173,49 @@ DeltaValue<QosPolicy> StateDelta::getDefaultDataPlaneQosPolicyDelta() const {
       new_->getDefaultDataPlaneQosPolicy());
 }
 
+bool StateDelta::isChanged(SwitchStateSubsystem subsystem) const {
+  switch (subsystem) {
+    case SwitchStateSubsystem::PORTS:
+      return old_->getPorts() != new_->getPorts();
+    case SwitchStateSubsystem::VLANS:
+      return old_->getVlans() != new_->getVlans();
+    case SwitchStateSubsystem::INTERFACES:
+      return old_->getInterfaces() != new_->getInterfaces();
+    case SwitchStateSubsystem::ROUTE_TABLES:
+      return old_->getRouteTables() != new_->getRouteTables();
+    case SwitchStateSubsystem::FIBS:
+      return old_->getFibs() != new_->getFibs();
+    case SwitchStateSubsystem::LABEL_FIB:
+      return old_->getLabelForwardingInformationBase() !=
+          new_->getLabelForwardingInformationBase();
+    case SwitchStateSubsystem::ACLS:
+      return old_->getAcls() != new_->getAcls();
+    case SwitchStateSubsystem::QOS_POLICIES:
+      return old_->getQosPolicies() != new_->getQosPolicies();
+    case SwitchStateSubsystem::DEFAULT_DATA_PLANE_QOS_POLICY:
+      return old_->getDefaultDataPlaneQosPolicy() !=
+          new_->getDefaultDataPlaneQosPolicy();
+    case SwitchStateSubsystem::AGGREGATE_PORTS:
+      return old_->getAggregatePorts() != new_->getAggregatePorts();
+    case SwitchStateSubsystem::SFLOW_COLLECTORS:
+      return old_->getSflowCollectors() != new_->getSflowCollectors();
+    case SwitchStateSubsystem::LOAD_BALANCERS:
+      return old_->getLoadBalancers() != new_->getLoadBalancers();
+    case SwitchStateSubsystem::CONTROL_PLANE:
+      return old_->getControlPlane() != new_->getControlPlane();
+    case SwitchStateSubsystem::MIRRORS:
+      return old_->getMirrors() != new_->getMirrors();
+    case SwitchStateSubsystem::SWITCH_SETTINGS:
+      return old_->getSwitchSettings() != new_->getSwitchSettings();
+    case SwitchStateSubsystem::QCM_CFG:
+      return old_->getQcmCfg() != new_->getQcmCfg();
+    case SwitchStateSubsystem::BUFFER_POOL_CFGS:
+      return old_->getBufferPoolCfgs() != new_->getBufferPoolCfgs();
+  }
+  // Unreachable, all subsystems are handled above
+  return true;
+}
+
 std::ostream& operator<<(std::ostream& out, const StateDelta& stateDelta) {
   // Leverage the folly::dynamic printing facilities
   folly::dynamic diff = folly::dynamic::object;
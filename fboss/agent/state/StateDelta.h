@@ -9,10 +9,14 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 
+#include <folly/synchronization/CallOnce.h>
+
 #include "fboss/agent/state/AclMap.h"
 #include "fboss/agent/state/AggregatePortMap.h"
 #include "fboss/agent/state/DeltaFunctions.h"
@@ -36,9 +40,38 @@ namespace facebook::fboss {
 class SwitchState;
 class ControlPlane;
 
+/*
+ * Top level subsystems of a SwitchState, see StateDelta::isChanged().
+ * Neighbor and MAC tables live under VLANS.
+ */
+enum class SwitchStateSubsystem : uint8_t {
+  PORTS,
+  VLANS,
+  INTERFACES,
+  ROUTE_TABLES,
+  FIBS,
+  LABEL_FIB,
+  ACLS,
+  QOS_POLICIES,
+  DEFAULT_DATA_PLANE_QOS_POLICY,
+  AGGREGATE_PORTS,
+  SFLOW_COLLECTORS,
+  LOAD_BALANCERS,
+  CONTROL_PLANE,
+  MIRRORS,
+  SWITCH_SETTINGS,
+  QCM_CFG,
+  BUFFER_POOL_CFGS,
+};
+
 /*
  * StateDelta contains code for examining the differences between two
  * SwitchStates.
+ *
+ * The same StateDelta is handed to the HwSwitch and to every state observer.
+ * Sub-deltas of node maps are memoized the first time they are asked for,
+ * see NodeMapDelta::memoize(), so the maps are diffed once per delta and
+ * every later caller just iterates over the recorded changes.
  */
 class StateDelta {
  public:
@@ -76,13 +109,46 @@ class StateDelta {
   getLabelForwardingInformationBaseDelta() const;
   DeltaValue<SwitchSettings> getSwitchSettingsDelta() const;
 
+  /*
+   * Whether anything in the given subsystem changed. SwitchState is copy on
+   * write, so an untouched subsystem is the very same node in both states
+   * and this is a pointer comparison, letting HwSwitch implementations skip
+   * untouched subsystems without building or walking their deltas.
+   */
+  bool isChanged(SwitchStateSubsystem subsystem) const;
+
  private:
   // Forbidden copy constructor and assignment operator
   StateDelta(StateDelta const&) = delete;
   StateDelta& operator=(StateDelta const&) = delete;
 
+  template <typename Delta>
+  struct MemoizedDelta {
+    folly::once_flag once;
+    std::optional<Delta> delta;
+  };
+
+  template <typename Delta, typename MakeDeltaFn>
+  static Delta getMemoized(
+      MemoizedDelta<Delta>& memoized,
+      MakeDeltaFn makeDelta);
+
   std::shared_ptr<SwitchState> old_;
   std::shared_ptr<SwitchState> new_;
+
+  mutable MemoizedDelta<NodeMapDelta<PortMap>> portsDelta_;
+  mutable MemoizedDelta<VlanMapDelta> vlansDelta_;
+  mutable MemoizedDelta<NodeMapDelta<InterfaceMap>> intfsDelta_;
+  mutable MemoizedDelta<RTMapDelta> routeTablesDelta_;
+  mutable MemoizedDelta<AclMapDelta> aclsDelta_;
+  mutable MemoizedDelta<QosPolicyMapDelta> qosPoliciesDelta_;
+  mutable MemoizedDelta<NodeMapDelta<AggregatePortMap>> aggregatePortsDelta_;
+  mutable MemoizedDelta<NodeMapDelta<SflowCollectorMap>> sflowCollectorsDelta_;
+  mutable MemoizedDelta<NodeMapDelta<LoadBalancerMap>> loadBalancersDelta_;
+  mutable MemoizedDelta<NodeMapDelta<MirrorMap>> mirrorsDelta_;
+  mutable MemoizedDelta<ForwardingInformationBaseMapDelta> fibsDelta_;
+  mutable MemoizedDelta<NodeMapDelta<LabelForwardingInformationBase>>
+      labelFibDelta_;
 };
 
 std::ostream& operator<<(std::ostream& out, const StateDelta& stateDelta);
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <folly/FBString.h>
@@ -29,6 +30,10 @@ class SwitchState;
  * single update notification to the HwSwitch and other update subscribers.
  * Therefore the applyUpdate() may be called with an unpublished SwitchState in
  * some cases.
+ *
+ * Pending updates are applied in order of priority, and only updates of the
+ * same priority are batched together. Updates of the same priority are
+ * always applied in the order they were scheduled.
  */
 class StateUpdate {
  public:
@@ -39,13 +44,49 @@ class StateUpdate {
   };
   static constexpr int kDefaultBehaviorFlags =
       static_cast<int>(BehaviorFlags::NONE);
-  explicit StateUpdate(folly::StringPiece name, int behaviorFlags)
-      : name_(name.str()), behaviorFlags_(behaviorFlags) {}
+
+  // Highest priority first
+  enum class Priority : uint8_t {
+    // Port and aggregate port member oper state changes
+    LINK_STATE,
+    // Neighbor and MAC table entries, including their class IDs. They all
+    // share one class so updates to an entry are never reordered.
+    NEIGHBOR,
+    // Routes, config and any other update not classified otherwise
+    ROUTE,
+    // Updates driven by periodically collected stats, which can always wait
+    STATS,
+  };
+  static constexpr size_t kNumPriorities = 4;
+  static constexpr Priority kDefaultPriority = Priority::ROUTE;
+
+  static folly::StringPiece priorityName(Priority priority) {
+    switch (priority) {
+      case Priority::LINK_STATE:
+        return "link_state";
+      case Priority::NEIGHBOR:
+        return "neighbor";
+      case Priority::ROUTE:
+        return "route";
+      case Priority::STATS:
+        return "stats";
+    }
+    return "unknown";
+  }
+
+  explicit StateUpdate(
+      folly::StringPiece name,
+      int behaviorFlags,
+      Priority priority = kDefaultPriority)
+      : name_(name.str()), behaviorFlags_(behaviorFlags), priority_(priority) {}
   virtual ~StateUpdate() {}
 
   const std::string& getName() const {
     return name_;
   }
+  Priority getPriority() const {
+    return priority_;
+  }
 
   bool allowsCoalescing() const {
     return !isNonCoalescing();
@@ -98,6 +139,9 @@ class StateUpdate {
 
   std::string name_;
   int behaviorFlags_{static_cast<int>(BehaviorFlags::NONE)};
+  Priority priority_{kDefaultPriority};
+  // When the update was scheduled, set by SwSwitch
+  std::chrono::steady_clock::time_point scheduledAt_;
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
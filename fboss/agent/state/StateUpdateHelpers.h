@@ -32,8 +32,9 @@ class FunctionStateUpdate : public StateUpdate {
   FunctionStateUpdate(
       folly::StringPiece name,
       StateUpdateFn fn,
-      int flags = kDefaultBehaviorFlags)
-      : StateUpdate(name, flags), function_(fn) {}
+      int flags = kDefaultBehaviorFlags,
+      Priority priority = kDefaultPriority)
+      : StateUpdate(name, flags, priority), function_(fn) {}
 
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& origState) override {
@@ -104,8 +105,9 @@ class BlockingStateUpdate : public StateUpdate {
       folly::StringPiece name,
       StateUpdateFn fn,
       std::shared_ptr<BlockingUpdateResult> result,
-      int flags = kDefaultBehaviorFlags)
-      : StateUpdate(name, flags), function_(fn), result_(result) {}
+      int flags = kDefaultBehaviorFlags,
+      Priority priority = kDefaultPriority)
+      : StateUpdate(name, flags, priority), function_(fn), result_(result) {}
 
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& origState) override {
@@ -13,6 +13,18 @@
 
 namespace facebook::fboss {
 
+void VlanDelta::memoize() {
+  if (memoized_) {
+    return;
+  }
+  auto memoized = std::make_shared<MemoizedDeltas>(
+      MemoizedDeltas{getArpDelta(), getNdpDelta(), getMacDelta()});
+  memoized->arpDelta.memoize();
+  memoized->ndpDelta.memoize();
+  memoized->macDelta.memoize();
+  memoized_ = std::move(memoized);
+}
+
 template class NodeMapDelta<ArpTable>;
 template class NodeMapDelta<NdpTable>;
 template class NodeMapDelta<MacTable>;
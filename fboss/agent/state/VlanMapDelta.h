@@ -32,11 +32,17 @@ class VlanDelta : public DeltaValue<Vlan> {
   using DeltaValue<Vlan>::DeltaValue;
 
   ArpTableDelta getArpDelta() const {
+    if (memoized_) {
+      return memoized_->arpDelta;
+    }
     return ArpTableDelta(
         getOld() ? getOld()->getArpTable().get() : nullptr,
         getNew() ? getNew()->getArpTable().get() : nullptr);
   }
   NdpTableDelta getNdpDelta() const {
+    if (memoized_) {
+      return memoized_->ndpDelta;
+    }
     return NdpTableDelta(
         getOld() ? getOld()->getNdpTable().get() : nullptr,
         getNew() ? getNew()->getNdpTable().get() : nullptr);
@@ -45,10 +51,26 @@ class VlanDelta : public DeltaValue<Vlan> {
   NodeMapDelta<NTableT> getNeighborDelta() const;
 
   MacTableDelta getMacDelta() const {
+    if (memoized_) {
+      return memoized_->macDelta;
+    }
     return MacTableDelta(
         getOld() ? getOld()->getMacTable().get() : nullptr,
         getNew() ? getNew()->getMacTable().get() : nullptr);
   }
+
+  /*
+   * Memoize the neighbor and MAC table deltas, see NodeMapDelta::memoize()
+   */
+  void memoize();
+
+ private:
+  struct MemoizedDeltas {
+    ArpTableDelta arpDelta;
+    NdpTableDelta ndpDelta;
+    MacTableDelta macDelta;
+  };
+  std::shared_ptr<const MemoizedDeltas> memoized_;
 };
 
 typedef NodeMapDelta<VlanMap, VlanDelta> VlanMapDelta;
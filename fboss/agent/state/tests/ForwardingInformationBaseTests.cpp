@@ -153,6 +153,25 @@ TEST_F(ForwardingInformationBaseV6Test, LPMDoesNotExist) {
   EXPECT_EQ(nullptr, fib.longestMatch(address));
 }
 
+TEST_F(ForwardingInformationBaseV4Test, PublishedLPM) {
+  // Published FIBs look routes up in an index rather than scanning them
+  fib.publish();
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV4("0.0.0.0")), ip4_0, 4);
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV4("64.1.0.1")), ip4_64, 3);
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV4("161.16.8.1")), ip4_160, 3);
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV4("72.0.0.1")), ip4_72, 6);
+  EXPECT_EQ(nullptr, fib.longestMatch(folly::IPAddressV4("192.0.0.0")));
+}
+
+TEST_F(ForwardingInformationBaseV6Test, PublishedLPM) {
+  fib.publish();
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV6("::")), ip6_0, 4);
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV6("4001:1::")), ip6_64, 3);
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV6("A110:801::")), ip6_160, 3);
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV6("4801::")), ip6_72, 6);
+  EXPECT_EQ(nullptr, fib.longestMatch(folly::IPAddressV6("C000::")));
+}
+
 TEST_F(ForwardingInformationBaseV4Test, IncreasingLPMSequence) {
   folly::IPAddressV4 address("255.255.255.255");
   for (uint8_t mask = 0; mask <= address.bitCount(); ++mask) {
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/NodeArena.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::fboss;
+using std::make_shared;
+
+namespace {
+
+std::shared_ptr<SwitchState> publishedState() {
+  auto state = make_shared<SwitchState>();
+  state->registerPort(PortID(1), "port1");
+  state->publish();
+  return state;
+}
+
+} // namespace
+
+TEST(NodeArena, countsAllocationsWithoutArena) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_node_arenas = false;
+  auto state = publishedState();
+  auto liveArenas = NodeArena::liveArenas();
+
+  NodeArena::Scope scope;
+  EXPECT_EQ(nullptr, NodeArena::current());
+  auto newState = state->clone();
+  auto allocations = scope.allocations();
+  EXPECT_EQ(1, allocations.allocations);
+  EXPECT_GE(allocations.bytes, sizeof(SwitchState));
+  EXPECT_EQ(0, allocations.arenaAllocations);
+  EXPECT_EQ(liveArenas, NodeArena::liveArenas());
+}
+
+TEST(NodeArena, freedWithLastNode) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_node_arenas = true;
+  auto state = publishedState();
+  auto liveArenas = NodeArena::liveArenas();
+
+  std::shared_ptr<SwitchState> newState;
+  {
+    NodeArena::Scope scope;
+    EXPECT_NE(nullptr, NodeArena::current());
+    newState = state->clone();
+    state->getPorts()->getPort(PortID(1))->modify(&newState);
+    auto allocations = scope.allocations();
+    // SwitchState, PortMap and Port
+    EXPECT_EQ(3, allocations.allocations);
+    EXPECT_EQ(3, allocations.arenaAllocations);
+  }
+  EXPECT_EQ(nullptr, NodeArena::current());
+  // The nodes outlive the scope, and keep the arena alive
+  EXPECT_EQ(liveArenas + 1, NodeArena::liveArenas());
+  EXPECT_NE(
+      state->getPorts()->getPort(PortID(1)),
+      newState->getPorts()->getPort(PortID(1)));
+  state.reset();
+  EXPECT_EQ(liveArenas + 1, NodeArena::liveArenas());
+  // The last node may go away on any thread
+  std::thread([&newState]() { newState.reset(); }).join();
+  EXPECT_EQ(liveArenas, NodeArena::liveArenas());
+}
+
+TEST(NodeArena, emptyScope) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_node_arenas = true;
+  auto liveArenas = NodeArena::liveArenas();
+  { NodeArena::Scope scope; }
+  EXPECT_EQ(liveArenas, NodeArena::liveArenas());
+}
+
+TEST(NodeArena, nestedScopes) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_node_arenas = true;
+  auto state = publishedState();
+
+  NodeArena::Scope outer;
+  auto outerArena = NodeArena::current();
+  {
+    NodeArena::Scope inner;
+    EXPECT_NE(outerArena, NodeArena::current());
+    auto newState = state->clone();
+    EXPECT_EQ(1, inner.allocations().allocations);
+  }
+  EXPECT_EQ(outerArena, NodeArena::current());
+  // Inner allocations count towards the outer scope too
+  EXPECT_EQ(1, outer.allocations().allocations);
+}
@@ -17,6 +17,7 @@
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortMap.h"
 #include "fboss/agent/state/PortQueue.h"
+#include "fboss/agent/state/QcmConfig.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
@@ -1118,3 +1119,65 @@ TEST(PortMap, iterateOrder) {
   ++it;
   EXPECT_EQ(ports->end(), it);
 }
+
+TEST(PortMap, stateDeltaIsChanged) {
+  auto stateV0 = make_shared<SwitchState>();
+  stateV0->registerPort(PortID(1), "port1");
+  stateV0->publish();
+
+  auto stateV1 = stateV0;
+  auto port = stateV1->getPorts()->getPort(PortID(1))->modify(&stateV1);
+  port->setAdminState(cfg::PortState::ENABLED);
+  ASSERT_NE(stateV0, stateV1);
+
+  StateDelta delta(stateV0, stateV1);
+  EXPECT_TRUE(delta.isChanged(SwitchStateSubsystem::PORTS));
+  // Only the port map was cloned, every other subsystem is shared
+  EXPECT_FALSE(delta.isChanged(SwitchStateSubsystem::VLANS));
+  EXPECT_FALSE(delta.isChanged(SwitchStateSubsystem::INTERFACES));
+  EXPECT_FALSE(delta.isChanged(SwitchStateSubsystem::ACLS));
+  EXPECT_FALSE(delta.isChanged(SwitchStateSubsystem::SWITCH_SETTINGS));
+  EXPECT_FALSE(delta.isChanged(SwitchStateSubsystem::QCM_CFG));
+  EXPECT_FALSE(delta.isChanged(SwitchStateSubsystem::BUFFER_POOL_CFGS));
+
+  StateDelta noopDelta(stateV1, stateV1);
+  EXPECT_FALSE(noopDelta.isChanged(SwitchStateSubsystem::PORTS));
+
+  // QCM config has no node map, but is still tracked on its own
+  auto stateV2 = stateV1->clone();
+  stateV2->resetQcmCfg(make_shared<QcmCfg>());
+  stateV2->publish();
+  StateDelta qcmDelta(stateV1, stateV2);
+  EXPECT_TRUE(qcmDelta.isChanged(SwitchStateSubsystem::QCM_CFG));
+  EXPECT_FALSE(qcmDelta.isChanged(SwitchStateSubsystem::PORTS));
+  EXPECT_FALSE(qcmDelta.isChanged(SwitchStateSubsystem::BUFFER_POOL_CFGS));
+}
+
+TEST(PortMap, stateDeltaMemoized) {
+  auto stateV0 = make_shared<SwitchState>();
+  stateV0->registerPort(PortID(1), "port1");
+  stateV0->registerPort(PortID(2), "port2");
+  stateV0->registerPort(PortID(3), "port3");
+  stateV0->publish();
+
+  auto stateV1 = stateV0;
+  stateV1->getPorts()->getPort(PortID(1))->modify(&stateV1)->setAdminState(
+      cfg::PortState::ENABLED);
+  stateV1->getPorts()->getPort(PortID(3))->modify(&stateV1)->setAdminState(
+      cfg::PortState::ENABLED);
+
+  StateDelta delta(stateV0, stateV1);
+  auto portsDelta = delta.getPortsDelta();
+  EXPECT_TRUE(portsDelta.isMemoized());
+  EXPECT_EQ(
+      (std::vector<PortID>{PortID(1), PortID(3)}),
+      portsDelta.getChangedKeys());
+
+  // Later callers iterate over the very same changes
+  auto portsDeltaAgain = delta.getPortsDelta();
+  EXPECT_EQ(&*portsDelta.begin(), &*portsDeltaAgain.begin());
+  EXPECT_EQ(2, std::distance(portsDeltaAgain.begin(), portsDeltaAgain.end()));
+
+  // Unchanged subsystems memoize to no changes
+  EXPECT_TRUE(delta.getVlansDelta().getChangedKeys().empty());
+}
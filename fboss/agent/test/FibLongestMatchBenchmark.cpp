@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/Route.h"
+
+#include <folly/Conv.h>
+#include <folly/IPAddressV6.h>
+
+#include <memory>
+#include <vector>
+
+DEFINE_int32(fib_size, 100000, "Number of /64 routes in the FIB");
+
+using namespace facebook::fboss;
+using folly::IPAddressV6;
+
+namespace {
+
+// FIB lookups on the slow path are for hosts, so look up addresses within
+// the routes, spread across the whole FIB
+constexpr auto kNumLookupAddresses = 1024;
+
+std::shared_ptr<ForwardingInformationBaseV6> scannedFib;
+std::shared_ptr<ForwardingInformationBaseV6> indexedFib;
+std::vector<IPAddressV6> lookupAddresses;
+
+IPAddressV6 routeNetwork(int i) {
+  return IPAddressV6(folly::to<std::string>(
+      "2001:", (i >> 16) & 0xffff, ":", i & 0xffff, "::"));
+}
+
+void init() {
+  scannedFib = std::make_shared<ForwardingInformationBaseV6>();
+  for (int i = 0; i < FLAGS_fib_size; ++i) {
+    RoutePrefixV6 prefix{routeNetwork(i), 64};
+    scannedFib->addNode(std::make_shared<RouteV6>(RouteFields(prefix)));
+  }
+  // Publishing is what enables the LPM index
+  indexedFib = scannedFib->clone();
+  indexedFib->publish();
+  // Build the index outside of the measured loop
+  indexedFib->longestMatch(routeNetwork(0));
+
+  for (int i = 0; i < kNumLookupAddresses; ++i) {
+    auto route = static_cast<int64_t>(i) * FLAGS_fib_size / kNumLookupAddresses;
+    lookupAddresses.push_back(IPAddressV6(folly::to<std::string>(
+        "2001:", (route >> 16) & 0xffff, ":", route & 0xffff, "::1")));
+  }
+}
+
+template <typename Fib>
+void lookup(const Fib& fib, size_t numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    folly::doNotOptimizeAway(
+        fib->longestMatch(lookupAddresses[n % lookupAddresses.size()]));
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(FibLongestMatchScan, numIters) {
+  lookup(scannedFib, numIters);
+}
+
+BENCHMARK_RELATIVE(FibLongestMatchIndexed, numIters) {
+  lookup(indexedFib, numIters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Building a large FIB is fairly expensive, do this once before running
+  // the benchmarks.
+  init();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "fboss/agent/FibUpdatePipeline.h"
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/IPAddressV6.h>
+#include <gflags/gflags.h>
+
+using folly::IPAddressV6;
+
+namespace facebook::fboss {
+
+class FibUpdatePipelineTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_pipelined_fib_programming = true;
+    // Small chunks, so every update spans several of them
+    FLAGS_fib_pipeline_chunk_size = 2;
+    auto config = testConfigA();
+    handle_ = createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+    sw_ = handle_->getSw();
+  }
+
+  IPAddressV6 prefix(int i) const {
+    return IPAddressV6(folly::to<std::string>("2001:db8:", i, "::"));
+  }
+
+  void updateRoutes(int numAdd, int numDel, const IPAddressV6& nexthop) {
+    SwSwitchRouteUpdateWrapper routeUpdater(sw_);
+    for (int i = 0; i < numAdd; ++i) {
+      routeUpdater.addRoute(
+          RouterID(0),
+          prefix(i),
+          64,
+          ClientID(1),
+          RouteNextHopEntry(
+              RouteNextHopSet{UnresolvedNextHop(nexthop, UCMP_DEFAULT_WEIGHT)},
+              AdminDistance::EBGP));
+    }
+    for (int i = numAdd; i < numAdd + numDel; ++i) {
+      routeUpdater.delRoute(RouterID(0), prefix(i), 64, ClientID(1));
+    }
+    routeUpdater.program();
+    sw_->getFibUpdatePipeline()->waitForIdle();
+  }
+
+  std::shared_ptr<RouteV6> fibRoute(int i) const {
+    return sw_->getState()
+        ->getFibs()
+        ->getFibContainer(RouterID(0))
+        ->getFibV6()
+        ->exactMatch(RoutePrefixV6{prefix(i), 64});
+  }
+
+  void verifyRoutes(int numRoutes, int numAbsent, const IPAddressV6& nexthop) {
+    for (int i = 0; i < numRoutes; ++i) {
+      auto route = fibRoute(i);
+      ASSERT_NE(nullptr, route);
+      const auto& nexthops = route->getForwardInfo().getNextHopSet();
+      ASSERT_EQ(1, nexthops.size());
+      EXPECT_EQ(nexthop, nexthops.begin()->addr());
+    }
+    for (int i = numRoutes; i < numRoutes + numAbsent; ++i) {
+      EXPECT_EQ(nullptr, fibRoute(i));
+    }
+  }
+
+ protected:
+  gflags::FlagSaver flagSaver_;
+  std::unique_ptr<HwTestHandle> handle_;
+  SwSwitch* sw_;
+};
+
+TEST_F(FibUpdatePipelineTest, addChangeDelete) {
+  IPAddressV6 nexthopA("2401:db00:2110:3001::2");
+  IPAddressV6 nexthopB("2401:db00:2110:3055::2");
+
+  // The first update of a VRF is queued as a whole FIB
+  updateRoutes(7, 0, nexthopA);
+  verifyRoutes(7, 0, nexthopA);
+
+  // Then as chunks of changed routes, followed by chunks of removed ones
+  updateRoutes(4, 3, nexthopB);
+  verifyRoutes(4, 3, nexthopB);
+  EXPECT_EQ(0, sw_->getFibUpdatePipeline()->pendingChunks());
+
+  // No-op updates queue nothing
+  updateRoutes(4, 0, nexthopB);
+  verifyRoutes(4, 3, nexthopB);
+}
+
+TEST_F(FibUpdatePipelineTest, boundedPendingChunks) {
+  // Every chunk of an update waits for the one before it
+  FLAGS_fib_pipeline_max_pending_chunks = 1;
+  IPAddressV6 nexthopA("2401:db00:2110:3001::2");
+  IPAddressV6 nexthopB("2401:db00:2110:3055::2");
+
+  updateRoutes(20, 0, nexthopA);
+  verifyRoutes(20, 0, nexthopA);
+
+  updateRoutes(10, 10, nexthopB);
+  verifyRoutes(10, 10, nexthopB);
+  EXPECT_EQ(0, sw_->getFibUpdatePipeline()->pendingChunks());
+  EXPECT_NO_THROW(sw_->getFibUpdatePipeline()->checkChunkErrors());
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/L2LearningEventStream.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+const auto kMac = folly::MacAddress("01:02:03:04:05:06");
+
+L2Entry l2Entry(PortDescriptor port) {
+  return L2Entry(
+      kMac, VlanID(1), port, L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+}
+
+} // namespace
+
+class L2LearningEventStreamTest : public ::testing::Test {
+ public:
+  std::optional<L2LearningEvent> learn(PortDescriptor port) {
+    return stream.update(
+        l2Entry(port), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+
+  std::optional<L2LearningEvent> age(PortDescriptor port) {
+    return stream.update(
+        l2Entry(port), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+  }
+
+  L2LearningEventStream stream;
+};
+
+TEST_F(L2LearningEventStreamTest, learnAndAge) {
+  auto event = learn(PortDescriptor(PortID(1)));
+  ASSERT_TRUE(event.has_value());
+  EXPECT_EQ(L2LearningEventType::LEARN, *event->type_ref());
+  EXPECT_EQ(kMac.toString(), *event->entry_ref()->mac_ref());
+  EXPECT_EQ(1, *event->entry_ref()->vlanID_ref());
+  EXPECT_EQ(1, *event->entry_ref()->port_ref());
+  EXPECT_GT(*event->timestampUsecs_ref(), 0);
+
+  // Learning again on the same port is nothing new
+  EXPECT_FALSE(learn(PortDescriptor(PortID(1))).has_value());
+
+  event = age(PortDescriptor(PortID(1)));
+  ASSERT_TRUE(event.has_value());
+  EXPECT_EQ(L2LearningEventType::AGE, *event->type_ref());
+  EXPECT_EQ(1, *event->entry_ref()->port_ref());
+}
+
+TEST_F(L2LearningEventStreamTest, moveReportedAsLearn) {
+  learn(PortDescriptor(PortID(1)));
+  auto event = learn(PortDescriptor(AggregatePortID(2)));
+  ASSERT_TRUE(event.has_value());
+  EXPECT_EQ(L2LearningEventType::MOVE, *event->type_ref());
+  EXPECT_EQ(2, event->entry_ref()->trunk_ref().value_or(0));
+  EXPECT_EQ(1, event->oldPort_ref().value_or(0));
+  EXPECT_FALSE(event->oldTrunk_ref().has_value());
+
+  // The removal from the old port is stale
+  EXPECT_FALSE(age(PortDescriptor(PortID(1))).has_value());
+}
+
+TEST_F(L2LearningEventStreamTest, moveReportedAsAgeAndLearn) {
+  learn(PortDescriptor(PortID(1)));
+  auto event = age(PortDescriptor(PortID(1)));
+  ASSERT_TRUE(event.has_value());
+  EXPECT_EQ(L2LearningEventType::AGE, *event->type_ref());
+
+  event = learn(PortDescriptor(PortID(2)));
+  ASSERT_TRUE(event.has_value());
+  EXPECT_EQ(L2LearningEventType::MOVE, *event->type_ref());
+  EXPECT_EQ(2, *event->entry_ref()->port_ref());
+  EXPECT_EQ(1, event->oldPort_ref().value_or(0));
+}
+
+TEST_F(L2LearningEventStreamTest, relearnOnSamePort) {
+  learn(PortDescriptor(PortID(1)));
+  age(PortDescriptor(PortID(1)));
+  auto event = learn(PortDescriptor(PortID(1)));
+  ASSERT_TRUE(event.has_value());
+  EXPECT_EQ(L2LearningEventType::LEARN, *event->type_ref());
+}
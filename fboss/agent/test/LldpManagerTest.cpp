@@ -142,6 +142,31 @@ TEST(LldpManagerTest, LldpSend) {
   lldpManager.sendLldpOnAllPorts();
 }
 
+TEST(LldpManagerTest, LldpSendSpreadAcrossSlots) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+
+  int numUpPorts = 0;
+  for (const auto& port : *sw->getState()->getPorts()) {
+    numUpPorts += port->isPortUp() ? 1 : 0;
+  }
+  // Every up port goes out exactly once over all the slots of an interval,
+  // and the cached frame templates still produce valid PDUs on reuse.
+  EXPECT_HW_CALL(
+      sw,
+      sendPacketOutOfPortAsync_(
+          TxPacketMatcher::createMatcher("Lldp PDU", checkLldpPDU()),
+          _,
+          std::optional<uint8_t>(kNCStrictPriorityQueue)))
+      .Times(2 * numUpPorts);
+  LldpManager lldpManager(sw);
+  for (auto round = 0; round < 2; ++round) {
+    for (uint16_t slot = 0; slot < LldpManager::LLDP_TX_SLOTS; ++slot) {
+      lldpManager.sendLldpOnSlot(slot);
+    }
+  }
+}
+
 TEST(LldpManagerTest, LldpSendPeriodic) {
   auto handle = setupTestHandle();
   auto sw = handle->getSw();
@@ -10,6 +10,7 @@
 #include "fboss/agent/test/RouteDistributionGenerator.h"
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/state/NodeArena.h"
 #include "fboss/agent/test/EcmpSetupHelper.h"
 
 #include <glog/logging.h>
@@ -114,6 +115,8 @@ RouteDistributionGenerator::getSwitchStates() const {
             RoutePrefixV4{cidrNetwork.first.asV4(), cidrNetwork.second});
       }
     }
+    // Build each state version from an arena of its own, as SwSwitch does
+    NodeArena::Scope arenaScope;
     auto newState = generatedStates_->back()->clone();
     newState =
         ecmpHelper6.setupECMPForwarding(newState, ecmpWidth(), v6Prefixes);
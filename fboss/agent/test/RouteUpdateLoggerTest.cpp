@@ -168,6 +168,12 @@ class RouteUpdateLoggerTest : public ::testing::Test {
     routeUpdateLogger->stopLoggingForLabel(label, identifier);
   }
 
+  // Route changes are logged on the logger's own thread
+  void stateUpdated(const StateDelta& delta) {
+    routeUpdateLogger->stateUpdated(delta);
+    routeUpdateLogger->waitForLogging();
+  }
+
   void logAllRouteUpdates() {
     startLogging("::", 0);
     startLogging("0.0.0.0", 0);
@@ -239,7 +245,7 @@ class RouteUpdateLoggerTest : public ::testing::Test {
 // Adding some routes will get logged correctly
 TEST_F(RouteUpdateLoggerTest, LogAdded) {
   logAllRouteUpdates();
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(5, mockRouteLoggerV4->added.size());
   EXPECT_EQ(3, mockRouteLoggerV6->added.size());
   // Default route changes
@@ -251,7 +257,7 @@ TEST_F(RouteUpdateLoggerTest, LogAdded) {
 // Removing some routes will get logged correctly
 TEST_F(RouteUpdateLoggerTest, LogRemoved) {
   logAllRouteUpdates();
-  routeUpdateLogger->stateUpdated(*deltaRemove);
+  stateUpdated(*deltaRemove);
   EXPECT_EQ(5, mockRouteLoggerV4->removed.size());
   EXPECT_EQ(3, mockRouteLoggerV6->removed.size());
   // Default route changes
@@ -262,8 +268,8 @@ TEST_F(RouteUpdateLoggerTest, LogRemoved) {
 
 // If no logging is enabled, nothing gets logged
 TEST_F(RouteUpdateLoggerTest, LogUntracked) {
-  routeUpdateLogger->stateUpdated(*deltaAdd);
-  routeUpdateLogger->stateUpdated(*deltaRemove);
+  stateUpdated(*deltaAdd);
+  stateUpdated(*deltaRemove);
   expectNoLogging();
 }
 
@@ -271,7 +277,7 @@ TEST_F(RouteUpdateLoggerTest, LogUntracked) {
 TEST_F(RouteUpdateLoggerTest, TrackWrongPrefix) {
   startLogging("1:1:1:1::", 64);
   startLogging("1.1.1.1", 16);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   expectNoChanged();
 }
 
@@ -280,7 +286,7 @@ TEST_F(RouteUpdateLoggerTest, TrackWrongPrefix) {
 TEST_F(RouteUpdateLoggerTest, LogTrackedPrefix) {
   startLogging("192.168.0.0", 24);
   startLogging("2401:db00:2110:3001::", 64);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(1, mockRouteLoggerV4->added.size());
   EXPECT_EQ(1, mockRouteLoggerV6->added.size());
 }
@@ -289,7 +295,7 @@ TEST_F(RouteUpdateLoggerTest, LogTrackedPrefix) {
 TEST_F(RouteUpdateLoggerTest, MoreSpecificPrefix) {
   startLogging("192.168.0.0", 16);
   startLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
 }
@@ -299,7 +305,7 @@ TEST_F(RouteUpdateLoggerTest, MoreSpecificPrefix) {
 TEST_F(RouteUpdateLoggerTest, MoreSpecificPrefixExactLogging) {
   startLogging("192.168.0.0", 16, "", true);
   startLogging("2401:db00::", 32, "", true);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   expectNoChanged();
   expectNoRemoved();
 }
@@ -308,15 +314,15 @@ TEST_F(RouteUpdateLoggerTest, MoreSpecificPrefixExactLogging) {
 TEST_F(RouteUpdateLoggerTest, StopLogging) {
   startLogging("192.168.0.0", 16);
   startLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   stopLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(4, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   stopLogging("192.168.0.0", 16);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(4, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   expectNoChanged();
@@ -327,16 +333,16 @@ TEST_F(RouteUpdateLoggerTest, StopLogging) {
 TEST_F(RouteUpdateLoggerTest, RestartLogging) {
   startLogging("192.168.0.0", 16);
   startLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   stopLogging("192.168.0.0", 16);
   stopLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   startLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(4, mockRouteLoggerV6->added.size());
   expectNoChanged();
@@ -348,12 +354,12 @@ TEST_F(RouteUpdateLoggerTest, RestartLogging) {
 TEST_F(RouteUpdateLoggerTest, SwitchToExact) {
   startLogging("192.168.0.0", 16);
   startLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   startLogging("192.168.0.0", 16, "", true);
   startLogging("2401:db00::", 32, "", true);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   expectNoChanged();
@@ -365,11 +371,11 @@ TEST_F(RouteUpdateLoggerTest, SwitchToExact) {
 TEST_F(RouteUpdateLoggerTest, SwitchToAllowMoreSpecific) {
   startLogging("192.168.0.0", 16, "", true);
   startLogging("2401:db00::", 32, "", true);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   expectNoLogging();
   startLogging("192.168.0.0", 16);
   startLogging("2401:db00::", 32);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   expectNoChanged();
@@ -380,7 +386,7 @@ TEST_F(RouteUpdateLoggerTest, SwitchToAllowMoreSpecific) {
 TEST_F(RouteUpdateLoggerTest, StartLoggingFromDifferentUsers) {
   startLogging("192.168.0.0", 16, "foo", false);
   startLogging("2401:db00::", 32, "bar", false);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   expectNoChanged();
@@ -391,15 +397,15 @@ TEST_F(RouteUpdateLoggerTest, StartLoggingFromDifferentUsers) {
 TEST_F(RouteUpdateLoggerTest, StopForOneUser) {
   startLogging("2401:db00::", 32, "foo", false);
   startLogging("2401:db00::", 32, "bar", false);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(0, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   stopLogging("2401:db00::", 32, "bar");
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(0, mockRouteLoggerV4->added.size());
   EXPECT_EQ(4, mockRouteLoggerV6->added.size());
   stopLogging("2401:db00::", 32, "foo");
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(0, mockRouteLoggerV4->added.size());
   EXPECT_EQ(4, mockRouteLoggerV6->added.size());
   expectNoChanged();
@@ -411,11 +417,11 @@ TEST_F(RouteUpdateLoggerTest, ClearForOneUser) {
   startLogging("192.168.0.0", 16, "foo", false);
   startLogging("2401:db00::", 32, "foo", false);
   startLogging("2401:db00::", 32, "bar", false);
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(2, mockRouteLoggerV6->added.size());
   routeUpdateLogger->stopLoggingForIdentifier("foo");
-  routeUpdateLogger->stateUpdated(*deltaAdd);
+  stateUpdated(*deltaAdd);
   EXPECT_EQ(2, mockRouteLoggerV4->added.size());
   EXPECT_EQ(4, mockRouteLoggerV6->added.size());
 }
@@ -429,7 +435,7 @@ TEST_F(RouteUpdateLoggerTest, LabelAdded) {
   state = addLabel(state, 200);
   state = addLabel(state, 300);
 
-  routeUpdateLogger->stateUpdated(StateDelta(initState, state));
+  stateUpdated(StateDelta(initState, state));
   EXPECT_EQ(3, mockMplsRouteLogger->added.size());
 }
 
@@ -441,11 +447,11 @@ TEST_F(RouteUpdateLoggerTest, LabelRemoved) {
   auto state = addLabel(initState, 100);
   state = addLabel(state, 200);
   state = addLabel(state, 300);
-  routeUpdateLogger->stateUpdated(StateDelta(initState, state));
+  stateUpdated(StateDelta(initState, state));
   EXPECT_EQ(3, mockMplsRouteLogger->added.size());
 
   auto newState = removeLabel(state, 300);
-  routeUpdateLogger->stateUpdated(StateDelta(state, newState));
+  stateUpdated(StateDelta(state, newState));
   EXPECT_EQ(1, mockMplsRouteLogger->removed.size());
 }
 
@@ -453,11 +459,11 @@ TEST_F(RouteUpdateLoggerTest, LabelChanged) {
   startLogging(100);
 
   auto state = addLabel(initState, 100);
-  routeUpdateLogger->stateUpdated(StateDelta(initState, state));
+  stateUpdated(StateDelta(initState, state));
   EXPECT_EQ(1, mockMplsRouteLogger->added.size());
   auto newState = removeLabel(state, 100);
   newState = addLabel(newState, 100, ClientID::STATIC_ROUTE);
-  routeUpdateLogger->stateUpdated(StateDelta(state, newState));
+  stateUpdated(StateDelta(state, newState));
   EXPECT_EQ(1, mockMplsRouteLogger->changed.size());
 }
 
@@ -469,13 +475,13 @@ TEST_F(RouteUpdateLoggerTest, MultipleSubscribers) {
   auto state = addLabel(initState, 100);
   state = addLabel(state, 200);
 
-  routeUpdateLogger->stateUpdated(StateDelta(initState, state));
+  stateUpdated(StateDelta(initState, state));
   EXPECT_EQ(1, mockMplsRouteLogger->added.size());
   EXPECT_EQ(3, mockMplsRouteLogger->addedFor.size());
 
   stopLogging(100, "foo");
   auto newState = removeLabel(state, 100);
-  routeUpdateLogger->stateUpdated(StateDelta(state, newState));
+  stateUpdated(StateDelta(state, newState));
   EXPECT_EQ(1, mockMplsRouteLogger->removed.size());
   EXPECT_EQ(2, mockMplsRouteLogger->removedFor.size());
 
@@ -484,7 +490,7 @@ TEST_F(RouteUpdateLoggerTest, MultipleSubscribers) {
   startLogging(200, "foobar");
   auto anotherNewState = removeLabel(newState, 200);
   anotherNewState = addLabel(anotherNewState, 200, ClientID::STATIC_ROUTE);
-  routeUpdateLogger->stateUpdated(StateDelta(newState, anotherNewState));
+  stateUpdated(StateDelta(newState, anotherNewState));
   EXPECT_EQ(1, mockMplsRouteLogger->changed.size());
   EXPECT_EQ(3, mockMplsRouteLogger->changedFor.size());
 
@@ -495,7 +501,7 @@ TEST_F(RouteUpdateLoggerTest, MultipleSubscribers) {
       removeLabel(anotherNewState, 200, ClientID::STATIC_ROUTE);
   oneMoreNewState = addLabel(oneMoreNewState, 200);
 
-  routeUpdateLogger->stateUpdated(StateDelta(anotherNewState, oneMoreNewState));
+  stateUpdated(StateDelta(anotherNewState, oneMoreNewState));
   EXPECT_EQ(1, mockMplsRouteLogger->changed.size());
   EXPECT_EQ(2, mockMplsRouteLogger->changedFor.size());
 }
@@ -508,14 +514,14 @@ TEST_F(RouteUpdateLoggerTest, TrackAllLabelsManySubscribers) {
   state = addLabel(state, 200);
   state = addLabel(state, 300);
 
-  routeUpdateLogger->stateUpdated(StateDelta(initState, state));
+  stateUpdated(StateDelta(initState, state));
   EXPECT_EQ(3, mockMplsRouteLogger->added.size());
   EXPECT_EQ(6, mockMplsRouteLogger->addedFor.size());
 
   stopLogging(-1, "bar");
   auto newState = removeLabel(state, 100);
   newState = addLabel(newState, 100, ClientID::STATIC_ROUTE);
-  routeUpdateLogger->stateUpdated(StateDelta(state, newState));
+  stateUpdated(StateDelta(state, newState));
   EXPECT_EQ(1, mockMplsRouteLogger->changed.size());
   EXPECT_EQ(1, mockMplsRouteLogger->changedFor.size());
 }
@@ -13,6 +13,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace facebook::fboss;
 
 namespace {
@@ -155,4 +157,34 @@ TEST_F(PrefixTrackerTest, DeleteLessSpecificUntracked) {
   checkNotTracking(p2);
 }
 
+// Identifiers tracking overlapping prefixes each use their own longest match
+TEST_F(PrefixTrackerTest, OverlappingIdentifiers) {
+  startTracking("1:1::", 32, "exact", true);
+  startTracking("1::", 16, "longest", false);
+  startTracking("1:1:1:1::", 64, "longest", true);
+
+  std::vector<std::string> ids;
+  EXPECT_TRUE(tracker.tracking(p2, ids));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ((std::vector<std::string>{"exact", "longest"}), ids);
+
+  // "longest" tracks p1 exactly, "exact" does not track it at all
+  EXPECT_TRUE(tracker.tracking(p1, ids));
+  EXPECT_EQ(std::vector<std::string>{"longest"}, ids);
+
+  // ...and more specific routes than p1 are tracked by neither
+  RoutePrefix<folly::IPAddressV6> p3{folly::IPAddressV6{"1:1:1:1::"}, 96};
+  checkNotTracking(p3);
+
+  // Under p2 but not p1, only "longest" tracks, through 1::/16
+  RoutePrefix<folly::IPAddressV6> p4{folly::IPAddressV6{"1:1:2::"}, 48};
+  EXPECT_TRUE(tracker.tracking(p4, ids));
+  EXPECT_EQ(std::vector<std::string>{"longest"}, ids);
+
+  tracker.stopTracking("longest");
+  checkNotTracking(p1);
+  checkNotTracking(p4);
+  checkTracking(p2);
+}
+
 } // namespace
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/state/NodeArena.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/MacAddress.h>
+#include <folly/logging/xlog.h>
+
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kEcmpWidth = 4;
+
+std::shared_ptr<SwitchState> startingState() {
+  static std::shared_ptr<SwitchState> state;
+  if (!state) {
+    SimPlatform plat(folly::MacAddress(), 128);
+    std::vector<PortID> ports;
+    for (int i = 0; i < 128; ++i) {
+      ports.push_back(PortID(i));
+    }
+    cfg::SwitchConfig config =
+        utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+    auto testHandle = createTestHandle(&config);
+    state = testHandle->getSw()->getState();
+  }
+  return state;
+}
+
+/*
+ * Build and then release the generator's state sequence, each state version
+ * built from an arena of its own if arenas are enabled.
+ */
+template <typename Generator>
+StateNodeAllocations generateStates(bool arenas) {
+  FLAGS_state_node_arenas = arenas;
+  auto start = NodeArena::threadAllocations();
+  size_t numStates;
+  {
+    Generator generator(
+        startingState(), utility::kDefaultChunkSize, kEcmpWidth);
+    numStates = generator.getSwitchStates().size();
+  }
+  auto allocations = NodeArena::threadAllocations() - start;
+  allocations.allocations /= numStates;
+  allocations.bytes /= numStates;
+  allocations.arenaAllocations /= numStates;
+  return allocations;
+}
+
+template <typename Generator>
+void logAllocations(folly::StringPiece name) {
+  auto allocations = generateStates<Generator>(false);
+  XLOG(INFO) << name << ": " << allocations.allocations
+             << " node allocations, " << allocations.bytes
+             << " bytes per state";
+}
+
+} // namespace
+
+BENCHMARK(StateNodeHeapFSW) {
+  generateStates<utility::FSWRouteScaleGenerator>(false);
+}
+
+BENCHMARK_RELATIVE(StateNodeArenaFSW) {
+  generateStates<utility::FSWRouteScaleGenerator>(true);
+}
+
+BENCHMARK(StateNodeHeapTHAlpm) {
+  generateStates<utility::THAlpmRouteScaleGenerator>(false);
+}
+
+BENCHMARK_RELATIVE(StateNodeArenaTHAlpm) {
+  generateStates<utility::THAlpmRouteScaleGenerator>(true);
+}
+
+BENCHMARK(StateNodeHeapHgridDu) {
+  generateStates<utility::HgridDuRouteScaleGenerator>(false);
+}
+
+BENCHMARK_RELATIVE(StateNodeArenaHgridDu) {
+  generateStates<utility::HgridDuRouteScaleGenerator>(true);
+}
+
+BENCHMARK(StateNodeHeapHgridUu) {
+  generateStates<utility::HgridUuRouteScaleGenerator>(false);
+}
+
+BENCHMARK_RELATIVE(StateNodeArenaHgridUu) {
+  generateStates<utility::HgridUuRouteScaleGenerator>(true);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  // Building the starting state is fairly expensive, do this once before
+  // running the benchmarks.
+  startingState();
+
+  logAllocations<utility::FSWRouteScaleGenerator>("FSW");
+  logAllocations<utility::THAlpmRouteScaleGenerator>("THAlpm");
+  logAllocations<utility::HgridDuRouteScaleGenerator>("HgridDu");
+  logAllocations<utility::HgridUuRouteScaleGenerator>("HgridUu");
+
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
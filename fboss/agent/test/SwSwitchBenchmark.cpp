@@ -0,0 +1,490 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * End to end control plane benchmarks for a full SwSwitch running on
+ * SimSwitch, so they need no ASIC. Each scenario takes --samples samples
+ * of a batch of work and reports the p50/p99 batch latency along with the
+ * resulting ops/sec, giving a stable regression signal for the software
+ * side of route, neighbor, MAC, config and packet RX handling.
+ */
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/AgentConfig.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/FibUpdatePipeline.h"
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/ThriftHandler.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/MacTable.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+#include <folly/String.h>
+#include <folly/dynamic.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <vector>
+
+DEFINE_int32(samples, 20, "Number of samples taken for each scenario");
+DEFINE_int32(
+    route_batch_size,
+    1000,
+    "Routes per addUnicastRoutes/deleteUnicastRoutes/syncFib call");
+DEFINE_int32(
+    churn_table_size,
+    20000,
+    "Routes in the table whose next hops each route_churn sample changes");
+DEFINE_int32(
+    state_update_batch_size,
+    1000,
+    "State updates queued per sample, which SwSwitch is free to coalesce");
+DEFINE_int32(
+    neighbor_batch_size,
+    200,
+    "Neighbors learnt per sample, at most 250 (one /24)");
+DEFINE_int32(mac_batch_size, 1000, "MAC entries learnt per sample");
+DEFINE_int32(rx_batch_size, 10000, "Packets received per sample");
+DEFINE_bool(json, false, "Output in json form");
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::IPAddressV4;
+using folly::MacAddress;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+using std::chrono::steady_clock;
+
+namespace {
+
+constexpr auto kNumPorts = 20;
+constexpr auto kPortsPerVlan = 10;
+constexpr auto kBgpClient = static_cast<int16_t>(ClientID::BGPD);
+constexpr auto kLearnTimeout = std::chrono::seconds(30);
+const MacAddress kPeerMac("00:02:00:01:02:03");
+
+unique_ptr<SwSwitch> sw;
+unique_ptr<ThriftHandler> handler;
+folly::dynamic results = folly::dynamic::object;
+
+cfg::SwitchConfig benchmarkConfig(bool withExtraAddress) {
+  cfg::SwitchConfig cfg;
+  cfg.ports_ref()->resize(kNumPorts);
+  cfg.vlanPorts_ref()->resize(kNumPorts);
+  for (int p = 0; p < kNumPorts; ++p) {
+    cfg.ports_ref()[p].logicalID_ref() = p + 1;
+    cfg.ports_ref()[p].name_ref() = folly::to<std::string>("port", p + 1);
+    cfg.ports_ref()[p].state_ref() = cfg::PortState::ENABLED;
+    cfg.vlanPorts_ref()[p].logicalPort_ref() = p + 1;
+    cfg.vlanPorts_ref()[p].vlanID_ref() = p < kPortsPerVlan ? 1 : 55;
+  }
+
+  cfg.vlans_ref()->resize(2);
+  cfg.vlans_ref()[0].id_ref() = 1;
+  cfg.vlans_ref()[0].name_ref() = "Vlan1";
+  cfg.vlans_ref()[0].intfID_ref() = 1;
+  cfg.vlans_ref()[1].id_ref() = 55;
+  cfg.vlans_ref()[1].name_ref() = "Vlan55";
+  cfg.vlans_ref()[1].intfID_ref() = 55;
+
+  cfg.interfaces_ref()->resize(2);
+  cfg.interfaces_ref()[0].intfID_ref() = 1;
+  cfg.interfaces_ref()[0].routerID_ref() = 0;
+  cfg.interfaces_ref()[0].vlanID_ref() = 1;
+  cfg.interfaces_ref()[0].name_ref() = "interface1";
+  cfg.interfaces_ref()[0].mac_ref() = "00:02:00:00:00:01";
+  cfg.interfaces_ref()[0].mtu_ref() = 9000;
+  cfg.interfaces_ref()[0].ipAddresses_ref() = std::vector<std::string>{
+      "10.0.0.1/24", "2401:db00:2110:3001::0001/64"};
+  cfg.interfaces_ref()[1].intfID_ref() = 55;
+  cfg.interfaces_ref()[1].routerID_ref() = 0;
+  cfg.interfaces_ref()[1].vlanID_ref() = 55;
+  cfg.interfaces_ref()[1].name_ref() = "interface55";
+  cfg.interfaces_ref()[1].mac_ref() = "00:02:00:00:00:55";
+  cfg.interfaces_ref()[1].mtu_ref() = 9000;
+  cfg.interfaces_ref()[1].ipAddresses_ref() = std::vector<std::string>{
+      "10.0.55.1/24", "2401:db00:2110:3055::0001/64"};
+  if (withExtraAddress) {
+    cfg.interfaces_ref()[1].ipAddresses_ref()->push_back("10.0.77.1/24");
+  }
+
+  cfg.clientIdToAdminDistance_ref() = std::map<int32_t, int32_t>{
+      {kBgpClient, static_cast<int32_t>(AdminDistance::EBGP)}};
+  cfg.switchSettings_ref()->l2LearningMode_ref() =
+      cfg::L2LearningMode::SOFTWARE;
+  return cfg;
+}
+
+void applyConfig(const cfg::SwitchConfig& swConfig) {
+  cfg::AgentConfig agentConfig;
+  agentConfig.sw_ref() = swConfig;
+  sw->getPlatform()->setConfig(make_unique<AgentConfig>(
+      agentConfig,
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+          agentConfig)));
+  sw->applyConfig("benchmark config");
+}
+
+void init() {
+  sw = make_unique<SwSwitch>(
+      make_unique<SimPlatform>(MacAddress("02:00:01:00:00:01"), kNumPorts));
+  sw->init(
+      nullptr /* No custom TunManager */, SwitchFlags::ENABLE_STANDALONE_RIB);
+  applyConfig(benchmarkConfig(false));
+  sw->initialConfigApplied(steady_clock::now());
+  sw->fibSynced();
+  handler = make_unique<ThriftHandler>(sw.get());
+}
+
+void waitForStateUpdates() {
+  // Updates are applied in order, so once a no-op update scheduled after
+  // them is done, so are they
+  sw->updateStateBlocking(
+      "benchmark wait", [](const shared_ptr<SwitchState>& /*state*/) {
+        return shared_ptr<SwitchState>();
+      });
+}
+
+template <typename Predicate>
+void waitForState(const char* what, Predicate predicate) {
+  auto deadline = steady_clock::now() + kLearnTimeout;
+  while (!predicate(sw->getState())) {
+    if (steady_clock::now() > deadline) {
+      throw FbossError("Timed out waiting for ", what);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
+
+/*
+ * Run sampleFn --samples times, timing only the sampleFn calls, and record
+ * the p50/p99 latency and throughput for opsPerSample ops per sample.
+ * setupFn runs untimed before every sample.
+ */
+void runScenario(
+    const std::string& name,
+    size_t opsPerSample,
+    const std::function<void(int)>& setupFn,
+    const std::function<void(int)>& sampleFn) {
+  std::vector<std::chrono::microseconds> latencies;
+  for (int sample = 0; sample < FLAGS_samples; ++sample) {
+    setupFn(sample);
+    auto begin = steady_clock::now();
+    sampleFn(sample);
+    latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+        steady_clock::now() - begin));
+  }
+  if (latencies.empty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](size_t pct) {
+    return latencies[std::min(
+                         latencies.size() - 1, latencies.size() * pct / 100)]
+        .count();
+  };
+  auto p50 = percentile(50);
+  folly::dynamic result = folly::dynamic::object;
+  result["samples"] = latencies.size();
+  result["ops_per_sample"] = opsPerSample;
+  result["p50_usecs"] = p50;
+  result["p99_usecs"] = percentile(99);
+  result["ops_per_sec"] = p50 ? opsPerSample * 1000000 / p50 : 0;
+  results[name] = result;
+}
+
+std::vector<UnicastRoute> makeRoutes(int batch, int nextHopSet = 0) {
+  static const std::vector<IPAddress> kNextHopSets[] = {
+      {
+          IPAddress("2401:db00:2110:3001::2"),
+          IPAddress("2401:db00:2110:3001::3"),
+          IPAddress("2401:db00:2110:3001::4"),
+          IPAddress("2401:db00:2110:3001::5"),
+      },
+      {
+          IPAddress("2401:db00:2110:3055::2"),
+          IPAddress("2401:db00:2110:3055::3"),
+          IPAddress("2401:db00:2110:3055::4"),
+          IPAddress("2401:db00:2110:3055::5"),
+      },
+  };
+  const auto& kNextHops = kNextHopSets[nextHopSet];
+  std::vector<UnicastRoute> routes;
+  routes.reserve(FLAGS_route_batch_size);
+  for (int i = 0; i < FLAGS_route_batch_size; ++i) {
+    UnicastRoute route;
+    route.dest.ip = toBinaryAddress(IPAddress(folly::to<std::string>(
+        "2001:db8:", batch % 0x10000, ":", i % 0x10000, "::")));
+    route.dest.prefixLength = 64;
+    for (const auto& nextHop : kNextHops) {
+      route.nextHopAddrs_ref()->push_back(toBinaryAddress(nextHop));
+    }
+    routes.push_back(std::move(route));
+  }
+  return routes;
+}
+
+std::vector<IpPrefix> makePrefixes(const std::vector<UnicastRoute>& routes) {
+  std::vector<IpPrefix> prefixes;
+  prefixes.reserve(routes.size());
+  for (const auto& route : routes) {
+    prefixes.push_back(route.dest);
+  }
+  return prefixes;
+}
+
+void benchmarkRoutes() {
+  runScenario(
+      "route_add",
+      FLAGS_route_batch_size,
+      [](int) {},
+      [](int sample) {
+        handler->addUnicastRoutes(
+            kBgpClient,
+            make_unique<std::vector<UnicastRoute>>(makeRoutes(sample)));
+      });
+  runScenario(
+      "route_delete",
+      FLAGS_route_batch_size,
+      [](int) {},
+      [](int sample) {
+        handler->deleteUnicastRoutes(
+            kBgpClient,
+            make_unique<std::vector<IpPrefix>>(
+                makePrefixes(makeRoutes(sample))));
+      });
+  // Every sync replaces the whole previous set of routes
+  runScenario(
+      "sync_fib",
+      FLAGS_route_batch_size,
+      [](int) {},
+      [](int sample) {
+        handler->syncFib(
+            kBgpClient,
+            make_unique<std::vector<UnicastRoute>>(makeRoutes(sample)));
+      });
+  handler->syncFib(kBgpClient, make_unique<std::vector<UnicastRoute>>());
+}
+
+/*
+ * Time for a full table churn, streamed as route_batch_size route updates
+ * moving every route to a different ECMP group, to be programmed. Run both
+ * with and without --pipelined_fib_programming, which lets the RIB work
+ * through later updates while earlier ones are programmed.
+ */
+void benchmarkRouteChurn() {
+  auto numBatches =
+      std::max(1, FLAGS_churn_table_size / FLAGS_route_batch_size);
+  auto churn = [numBatches](int sample) {
+    for (int batch = 0; batch < numBatches; ++batch) {
+      handler->addUnicastRoutes(
+          kBgpClient,
+          make_unique<std::vector<UnicastRoute>>(
+              makeRoutes(batch, sample % 2)));
+    }
+    sw->getFibUpdatePipeline()->waitForIdle();
+    waitForStateUpdates();
+  };
+  // Samples alternate between next hop sets, start from the other one
+  churn(1);
+  auto numRoutes = numBatches * FLAGS_route_batch_size;
+  runScenario("route_churn_full_table", numRoutes, [](int) {}, churn);
+  // Switching to pipelining only once, as its diffs are against the FIB it
+  // last queued
+  FLAGS_pipelined_fib_programming = true;
+  churn(1);
+  runScenario(
+      "route_churn_full_table_pipelined", numRoutes, [](int) {}, churn);
+  handler->syncFib(kBgpClient, make_unique<std::vector<UnicastRoute>>());
+  sw->getFibUpdatePipeline()->waitForIdle();
+  waitForStateUpdates();
+}
+
+void benchmarkStateUpdates() {
+  runScenario(
+      "state_update_coalesced",
+      FLAGS_state_update_batch_size,
+      [](int) {},
+      [](int sample) {
+        for (int i = 0; i < FLAGS_state_update_batch_size; ++i) {
+          auto description = folly::to<std::string>("sample", sample, "-", i);
+          sw->updateState(
+              "benchmark port description",
+              [i, description](const shared_ptr<SwitchState>& state) {
+                auto newState = state;
+                auto port = state->getPorts()
+                                ->getPort(PortID(i % kNumPorts + 1))
+                                ->modify(&newState);
+                port->setDescription(description);
+                return newState;
+              });
+        }
+        waitForStateUpdates();
+      });
+}
+
+unique_ptr<MockRxPacket> makeArpRequest(int host, IPAddressV4 target) {
+  auto senderMac = MacAddress::fromHBO(kPeerMac.u64HBO() + host);
+  IPAddressV4 senderIp(folly::to<std::string>("10.0.0.", host));
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "ff ff ff ff ff ff " +
+      folly::hexlify(folly::ByteRange(senderMac.bytes(), 6)) +
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4
+      "08 06  00 01  08 00  06  04"
+      // ARP Request
+      "00 01" +
+      // Sender MAC, sender IP
+      folly::hexlify(folly::ByteRange(senderMac.bytes(), 6)) +
+      folly::hexlify(senderIp.toByteArray()) +
+      // Target MAC, target IP
+      "00 00 00 00 00 00" + folly::hexlify(target.toByteArray()));
+  pkt->padToLength(68);
+  pkt->setSrcPort(PortID(host % kPortsPerVlan + 1));
+  pkt->setSrcVlan(VlanID(1));
+  return pkt;
+}
+
+int numArpEntries(const shared_ptr<SwitchState>& state) {
+  return state->getVlans()->getVlan(VlanID(1))->getArpTable()->size();
+}
+
+void benchmarkNeighborLearning() {
+  auto numNeighbors = std::min(FLAGS_neighbor_batch_size, 250);
+  std::vector<unique_ptr<MockRxPacket>> requests;
+  for (int host = 2; host < numNeighbors + 2; ++host) {
+    requests.push_back(makeArpRequest(host, IPAddressV4("10.0.0.1")));
+  }
+  auto flush = [numNeighbors](int) {
+    for (int host = 2; host < numNeighbors + 2; ++host) {
+      sw->getNeighborUpdater()
+          ->flushEntry(
+              VlanID(1), IPAddress(folly::to<std::string>("10.0.0.", host)))
+          .get();
+    }
+    waitForState("arp flush", [](const shared_ptr<SwitchState>& state) {
+      return numArpEntries(state) == 0;
+    });
+  };
+  runScenario("neighbor_learn", numNeighbors, flush, [&](int) {
+    for (const auto& request : requests) {
+      sw->packetReceived(request->clone());
+    }
+    waitForState(
+        "arp learning", [numNeighbors](const shared_ptr<SwitchState>& state) {
+          return numArpEntries(state) == numNeighbors;
+        });
+  });
+  flush(0);
+}
+
+void updateMacs(L2EntryUpdateType updateType) {
+  for (int i = 0; i < FLAGS_mac_batch_size; ++i) {
+    sw->l2LearningUpdateReceived(
+        L2Entry(
+            MacAddress::fromHBO(kPeerMac.u64HBO() + 0x10000 + i),
+            VlanID(1),
+            PortDescriptor(PortID(i % kPortsPerVlan + 1)),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_VALIDATED),
+        updateType);
+  }
+  waitForStateUpdates();
+}
+
+void benchmarkMacLearning() {
+  runScenario(
+      "mac_learn_storm",
+      FLAGS_mac_batch_size,
+      [](int sample) {
+        if (sample) {
+          updateMacs(L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+        }
+      },
+      [](int) { updateMacs(L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD); });
+  updateMacs(L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+}
+
+void benchmarkConfigReload() {
+  // Alternate between two configs so every reload changes the state
+  runScenario(
+      "config_reload",
+      1,
+      [](int) {},
+      [](int sample) { applyConfig(benchmarkConfig(sample % 2 == 0)); });
+  applyConfig(benchmarkConfig(false));
+}
+
+void benchmarkRx() {
+  auto request = makeArpRequest(2, IPAddressV4("10.0.0.1"));
+  runScenario("rx_arp_request", FLAGS_rx_batch_size, [](int) {}, [&](int) {
+    for (int i = 0; i < FLAGS_rx_batch_size; ++i) {
+      sw->packetReceived(request->clone());
+    }
+  });
+}
+
+void printResults() {
+  if (FLAGS_json) {
+    std::cout << folly::toPrettyJson(results) << std::endl;
+    return;
+  }
+  std::cout << std::left << std::setw(34) << "scenario" << std::right
+            << std::setw(12) << "ops/sample" << std::setw(12) << "p50 us"
+            << std::setw(12) << "p99 us" << std::setw(14) << "ops/sec"
+            << std::endl;
+  for (const auto& [name, result] : results.items()) {
+    std::cout << std::left << std::setw(34) << name.asString() << std::right
+              << std::setw(12) << result["ops_per_sample"].asInt()
+              << std::setw(12) << result["p50_usecs"].asInt() << std::setw(12)
+              << result["p99_usecs"].asInt() << std::setw(14)
+              << result["ops_per_sec"].asInt() << std::endl;
+  }
+}
+
+} // unnamed namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  init();
+  benchmarkRoutes();
+  benchmarkRouteChurn();
+  benchmarkStateUpdates();
+  benchmarkNeighborLearning();
+  benchmarkMacLearning();
+  benchmarkConfigReload();
+  benchmarkRx();
+  printResults();
+
+  handler.reset();
+  sw.reset();
+  return 0;
+}
@@ -20,6 +20,7 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/synchronization/Baton.h>
 
 #include <algorithm>
 
@@ -204,6 +205,41 @@ TEST_P(
   waitForStateUpdates(sw);
 }
 
+TEST_P(SwSwitchUpdateProcessingTest, HigherPriorityUpdatesFirst) {
+  // Hold up the update thread until all updates below are pending
+  folly::Baton<> blocked;
+  folly::Baton<> unblock;
+  sw->updateState(
+      "Block updates", [&](const std::shared_ptr<SwitchState>& /*state*/) {
+        blocked.post();
+        unblock.wait();
+        return std::shared_ptr<SwitchState>();
+      });
+  blocked.wait();
+
+  // Only accessed from the update thread
+  std::vector<std::string> applied;
+  auto recordUpdate = [&applied](const std::string& name) {
+    return [&applied, name](const std::shared_ptr<SwitchState>& /*state*/) {
+      applied.push_back(name);
+      return std::shared_ptr<SwitchState>();
+    };
+  };
+  sw->updateState("route 1", recordUpdate("route 1"));
+  sw->updateState("stats", recordUpdate("stats"), StateUpdate::Priority::STATS);
+  sw->updateStateNoCoalescing(
+      "neighbor", recordUpdate("neighbor"), StateUpdate::Priority::NEIGHBOR);
+  sw->updateState("route 2", recordUpdate("route 2"));
+  sw->updateStateNoCoalescing(
+      "link", recordUpdate("link"), StateUpdate::Priority::LINK_STATE);
+  unblock.post();
+  waitForStateUpdates(sw);
+
+  std::vector<std::string> expected{
+      "link", "neighbor", "route 1", "route 2", "stats"};
+  EXPECT_EQ(expected, applied);
+}
+
 INSTANTIATE_TEST_CASE_P(
     SwSwitchUpdateProcessingTest,
     SwSwitchUpdateProcessingTest,
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+using folly::MacAddress;
+using std::make_unique;
+using std::unique_ptr;
+
+namespace {
+
+constexpr auto kNumReaders = 16;
+
+unique_ptr<SwSwitch> sw;
+
+void init() {
+  MacAddress localMac("02:00:01:00:00:01");
+  sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+}
+
+/*
+ * Run readFn numIters times split across kNumReaders threads, while the
+ * update thread keeps publishing new states.
+ */
+template <typename ReadFn>
+void runConcurrentReaders(size_t numIters, ReadFn readFn) {
+  std::atomic<bool> done{false};
+  std::thread writer;
+  std::vector<std::thread> readers;
+  BENCHMARK_SUSPEND {
+    writer = std::thread([&done]() {
+      while (!done) {
+        sw->updateStateBlocking(
+            "bump generation",
+            [](const std::shared_ptr<SwitchState>& state) {
+              return state->clone();
+            });
+      }
+    });
+  }
+  for (auto i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back([numIters, &readFn]() {
+      for (size_t n = 0; n < numIters / kNumReaders; ++n) {
+        folly::doNotOptimizeAway(readFn());
+      }
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  BENCHMARK_SUSPEND {
+    done = true;
+    writer.join();
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(GetStateConcurrentReaders, numIters) {
+  runConcurrentReaders(
+      numIters, []() { return sw->getState()->getVlans()->size(); });
+}
+
+BENCHMARK_RELATIVE(GetStateReadGuardConcurrentReaders, numIters) {
+  runConcurrentReaders(numIters, []() {
+    auto state = sw->getStateReadGuard();
+    return state->getVlans()->size();
+  });
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Setting up the switch is fairly expensive, do this once before running
+  // the benchmarks.
+  init();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -271,10 +271,10 @@ MockPlatform* getMockPlatform(std::unique_ptr<SwSwitch>& sw) {
 }
 
 std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw) {
-  // All StateUpdates scheduled from this thread will be applied in order,
-  // so we can simply perform a blocking no-op update.  When it is done
-  // we can be sure that all previously scheduled updates have also been
-  // applied.
+  // All StateUpdates of the same priority scheduled from this thread will be
+  // applied in order, so we can simply perform a blocking no-op update of
+  // each priority.  When they are done we can be sure that all previously
+  // scheduled updates have also been applied.
   std::shared_ptr<SwitchState> snapshot{nullptr};
   auto snapshotUpdate = [&snapshot](const shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
@@ -282,7 +282,13 @@ std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw) {
     snapshot = state;
     return nullptr;
   };
-  sw->updateStateBlocking("waitForStateUpdates", snapshotUpdate);
+  for (size_t priority = 0; priority < StateUpdate::kNumPriorities;
+       ++priority) {
+    sw->updateStateBlocking(
+        "waitForStateUpdates",
+        snapshotUpdate,
+        static_cast<StateUpdate::Priority>(priority));
+  }
   return snapshot;
 }
 
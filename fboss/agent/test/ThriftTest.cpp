@@ -11,6 +11,7 @@
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/L2Entry.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -18,6 +19,7 @@
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteUpdater.h"
+#include "fboss/agent/state/SwitchSettings.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
@@ -110,6 +112,39 @@ TEST(ThriftTest, listHwObjects) {
       out, std::make_unique<std::vector<HwObjectType>>(in), false);
 }
 
+TEST(ThriftTest, getL2TableSoftwareLearning) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  sw->updateStateBlocking(
+      "software learning", [](const std::shared_ptr<SwitchState>& state) {
+        auto newState = state->clone();
+        auto switchSettings = newState->getSwitchSettings()->modify(&newState);
+        switchSettings->setL2LearningMode(cfg::L2LearningMode::SOFTWARE);
+        return newState;
+      });
+  sw->l2LearningUpdateReceived(
+      L2Entry(
+          folly::MacAddress("01:02:03:04:05:06"),
+          VlanID(1),
+          PortDescriptor(PortID(1)),
+          L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+      L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  waitForBackgroundThread(sw);
+  waitForStateUpdates(sw);
+
+  // Served from the switch state, without walking the hardware L2 table
+  ThriftHandler handler(sw);
+  EXPECT_HW_CALL(sw, fetchL2Table(_)).Times(0);
+  std::vector<L2EntryThrift> l2Table;
+  handler.getL2Table(l2Table);
+  ASSERT_EQ(1, l2Table.size());
+  EXPECT_EQ("01:02:03:04:05:06", *l2Table[0].mac_ref());
+  EXPECT_EQ(1, *l2Table[0].vlanID_ref());
+  EXPECT_EQ(1, *l2Table[0].port_ref());
+  EXPECT_EQ(
+      L2EntryType::L2_ENTRY_TYPE_VALIDATED, *l2Table[0].l2EntryType_ref());
+}
+
 TEST(ThriftTest, getHwDebugDump) {
   auto handle = setupTestHandle();
   auto sw = handle->getSw();
@@ -11,6 +11,7 @@
 #include "fboss/mdio/FbFpgaMdio.h"
 #include <folly/logging/xlog.h>
 #include <chrono>
+#include <optional>
 #include <sstream>
 #include "fboss/lib/fpga/FujiFpga.h"
 #include "fboss/lib/fpga/MinipackFpga.h"
@@ -104,16 +105,7 @@ phy::Cl45Data FbFpgaMdio::readCl45(
     phy::PhyAddress physAddr,
     phy::Cl45DeviceAddress devAddr,
     phy::Cl45RegisterAddress regAddr) {
-  // needed?
-  clearStatus();
-
-  MdioCommand command;
-  command.reg = 0;
-  command.devAddr = devAddr;
-  command.regAddr = regAddr;
-  command.rw = 1;
-  command.phySel = physAddr & 0b11111;
-  writeReg(command);
+  auto command = issueCommand(physAddr, devAddr, regAddr, true /* read */);
   waitUntilDone(kDefaultTxnWaitMillis, command);
 
   auto readData = readReg<MdioRead>();
@@ -129,6 +121,64 @@ void FbFpgaMdio::writeCl45(
   writeData.data = data;
   writeReg(writeData);
 
+  auto command = issueCommand(physAddr, devAddr, regAddr, false /* read */);
+  waitUntilDone(kDefaultTxnWaitMillis, command);
+}
+
+std::vector<phy::Cl45Data> FbFpgaMdio::executeBatch(
+    const std::vector<Cl45Transaction>& txns) {
+  std::vector<phy::Cl45Data> results;
+  results.reserve(txns.size());
+
+  // Last posted write which we have not yet waited on
+  std::optional<MdioCommand> pendingWrite;
+  // Value we last wrote to the write data register. Only known once we
+  // wrote it ourselves in this batch, as readCl45/writeCl45 and other
+  // processes may have used the controller since the last batch. It is
+  // forgotten on reads, and an error ends the batch, so we only rely on the
+  // register across back to back successful writes.
+  std::optional<phy::Cl45Data> lastWriteData;
+
+  auto waitForPendingWrite = [&]() {
+    if (pendingWrite) {
+      waitUntilDone(kDefaultTxnWaitMillis, *pendingWrite);
+      pendingWrite.reset();
+    }
+  };
+
+  for (const auto& txn : txns) {
+    if (txn.op == Cl45Transaction::Op::READ) {
+      waitForPendingWrite();
+      lastWriteData.reset();
+      auto command = issueCommand(
+          txn.physAddr, txn.devAddr, txn.regAddr, true /* read */);
+      waitUntilDone(kDefaultTxnWaitMillis, command);
+      results.push_back(phy::Cl45Data(readReg<MdioRead>().data));
+      continue;
+    }
+
+    // The data register must not change while a write is in flight
+    waitForPendingWrite();
+    if (!lastWriteData || *lastWriteData != txn.data) {
+      MdioWrite writeData;
+      writeData.data = txn.data;
+      writeReg(writeData);
+      lastWriteData = txn.data;
+    }
+    pendingWrite = issueCommand(
+        txn.physAddr, txn.devAddr, txn.regAddr, false /* read */);
+    results.push_back(txn.data);
+  }
+  waitForPendingWrite();
+
+  return results;
+}
+
+MdioCommand FbFpgaMdio::issueCommand(
+    phy::PhyAddress physAddr,
+    phy::Cl45DeviceAddress devAddr,
+    phy::Cl45RegisterAddress regAddr,
+    bool read) {
   // needed?
   clearStatus();
 
@@ -136,10 +186,10 @@ void FbFpgaMdio::writeCl45(
   command.reg = 0;
   command.devAddr = devAddr;
   command.regAddr = regAddr;
-  command.rw = 0;
+  command.rw = read ? 1 : 0;
   command.phySel = physAddr & 0b11111;
   writeReg(command);
-  waitUntilDone(kDefaultTxnWaitMillis, command);
+  return command;
 }
 
 template <typename Register>
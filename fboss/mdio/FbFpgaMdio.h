@@ -41,6 +41,16 @@ class FbFpgaMdio : public Mdio {
       phy::Cl45RegisterAddress regAddr,
       phy::Cl45Data data) override;
 
+  /*
+   * Batched transactions. Writes are posted: the command is issued and
+   * completion is only checked right before the next command goes out
+   * (or at the end of the batch), and the write data register is not
+   * rewritten for back to back writes of the same value within the batch.
+   * The caller must hold the controller lock for the whole batch.
+   */
+  std::vector<phy::Cl45Data> executeBatch(
+      const std::vector<Cl45Transaction>& txns) override;
+
   void reset();
 
   void setClockDivisor(int div);
@@ -50,6 +60,11 @@ class FbFpgaMdio : public Mdio {
  private:
   void clearStatus();
   void waitUntilDone(uint32_t millis, MdioCommand command);
+  MdioCommand issueCommand(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr,
+      bool read);
 
   template <typename Register>
   Register readReg();
@@ -15,6 +15,7 @@
 
 #include <cstdint>
 #include <mutex>
+#include <vector>
 
 #include <folly/Synchronized.h>
 #include <folly/io/async/EventBase.h>
@@ -48,8 +49,38 @@ namespace fboss {
  *
  * MdioController and MdioDevice are templated types based on the
  * variant of Mdio being used.
+ *
+ * Cl45Transaction: a single queued Cl45 read or write. A list of these
+ * can be handed to MdioController::executeBatch to perform all of them
+ * under a single lock acquisition.
  */
 
+struct Cl45Transaction {
+  enum class Op { READ, WRITE };
+
+  static Cl45Transaction read(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr) {
+    return Cl45Transaction{Op::READ, physAddr, devAddr, regAddr, 0};
+  }
+
+  static Cl45Transaction write(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr,
+      phy::Cl45Data data) {
+    return Cl45Transaction{Op::WRITE, physAddr, devAddr, regAddr, data};
+  }
+
+  Op op;
+  phy::PhyAddress physAddr;
+  phy::Cl45DeviceAddress devAddr;
+  phy::Cl45RegisterAddress regAddr;
+  // Data to write for WRITE transactions, ignored for READ
+  phy::Cl45Data data;
+};
+
 class Mdio {
  public:
   virtual ~Mdio() {}
@@ -65,6 +96,28 @@ class Mdio {
       phy::Cl45DeviceAddress devAddr,
       phy::Cl45RegisterAddress regAddr,
       phy::Cl45Data data) = 0;
+
+  /*
+   * Execute a list of transactions back to back. The returned vector
+   * has one entry per transaction, in order: the value read for READs
+   * and the data written for WRITEs. The default implementation simply
+   * issues each transaction in turn; controllers that can overlap or
+   * post transactions should override this.
+   */
+  virtual std::vector<phy::Cl45Data> executeBatch(
+      const std::vector<Cl45Transaction>& txns) {
+    std::vector<phy::Cl45Data> results;
+    results.reserve(txns.size());
+    for (const auto& txn : txns) {
+      if (txn.op == Cl45Transaction::Op::READ) {
+        results.push_back(readCl45(txn.physAddr, txn.devAddr, txn.regAddr));
+      } else {
+        writeCl45(txn.physAddr, txn.devAddr, txn.regAddr, txn.data);
+        results.push_back(txn.data);
+      }
+    }
+    return results;
+  }
 };
 
 template <typename IO>
@@ -141,6 +194,23 @@ class MdioController {
     locked->writeCl45(physAddr, devAddr, regAddr, data);
   }
 
+  // Perform all transactions while holding both the thread and process
+  // locks only once. Useful for phy programming and stats polling which
+  // touch many registers at a time.
+  std::vector<phy::Cl45Data> executeBatch(
+      const std::vector<Cl45Transaction>& txns) {
+    if (txns.empty()) {
+      return {};
+    }
+    auto locked = fully_lock();
+    return locked->executeBatch(txns);
+  }
+
+  std::vector<phy::Cl45Data> executeBatchUnlocked(
+      const std::vector<Cl45Transaction>& txns) {
+    return rawIO_.executeBatch(txns);
+  }
+
   int id() const {
     return id_;
   }
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/mdio/FbFpgaMdio.h"
+#include "fboss/mdio/Mdio.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+const uint32_t kFakeFpgaBar0 = 0xfb100000;
+const uint32_t kFakeFpgaSize = 4096;
+
+using RegKey = std::tuple<
+    phy::PhyAddress,
+    phy::Cl45DeviceAddress,
+    phy::Cl45RegisterAddress>;
+
+/*
+ * Emulates the FPGA MDIO controller registers: a command completes as soon
+ * as it is written, reading from or writing to a map of phy registers.
+ */
+class FakeMdioFpgaDevice : public FpgaDevice {
+ public:
+  FakeMdioFpgaDevice() : FpgaDevice(kFakeFpgaBar0, kFakeFpgaSize) {}
+
+  uint32_t read(uint32_t offset) const override {
+    switch (offset) {
+      case MdioStatus::addr::value:
+        return status_.reg;
+      case MdioRead::addr::value:
+        return readData_.reg;
+      case MdioWrite::addr::value:
+        return writeData_.reg;
+      default:
+        return 0;
+    }
+  }
+
+  void write(uint32_t offset, uint32_t value) override {
+    switch (offset) {
+      case MdioStatus::addr::value:
+        // Write 1 to clear
+        status_.reg &= ~value;
+        break;
+      case MdioWrite::addr::value:
+        writeData_.reg = value;
+        ++writeDataWrites;
+        break;
+      case MdioCommand::addr::value: {
+        MdioCommand command;
+        command.reg = value;
+        RegKey key{
+            static_cast<phy::PhyAddress>(command.phySel),
+            static_cast<phy::Cl45DeviceAddress>(command.devAddr),
+            static_cast<phy::Cl45RegisterAddress>(command.regAddr)};
+        if (command.rw) {
+          readData_.data = regs[key];
+          // The fake does not keep the write data across reads, so a write
+          // relying on the value latched before a read writes the wrong data
+          writeData_.reg = 0;
+          ++reads;
+        } else {
+          regs[key] = writeData_.data;
+          ++writes;
+        }
+        status_.done = 1;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  std::map<RegKey, phy::Cl45Data> regs;
+  int reads{0};
+  int writes{0};
+  int writeDataWrites{0};
+
+ private:
+  MdioStatus status_{0};
+  MdioRead readData_{0};
+  MdioWrite writeData_{0};
+};
+
+// Plain Mdio, exercising the default one transaction at a time batch
+class FakeMdio : public Mdio {
+ public:
+  phy::Cl45Data readCl45(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr) override {
+    return regs[RegKey{physAddr, devAddr, regAddr}];
+  }
+
+  void writeCl45(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr,
+      phy::Cl45Data data) override {
+    regs[RegKey{physAddr, devAddr, regAddr}] = data;
+  }
+
+  std::map<RegKey, phy::Cl45Data> regs;
+};
+
+std::vector<Cl45Transaction> mixedBatch() {
+  return {
+      Cl45Transaction::write(1, 1, 0x10, 0xaa),
+      Cl45Transaction::write(1, 1, 0x11, 0xaa),
+      Cl45Transaction::read(1, 1, 0x10),
+      Cl45Transaction::write(1, 1, 0x12, 0xaa),
+      Cl45Transaction::read(1, 1, 0x12),
+      Cl45Transaction::read(2, 3, 0x20),
+      Cl45Transaction::write(2, 3, 0x20, 0xbb),
+      Cl45Transaction::read(2, 3, 0x20),
+  };
+}
+
+const std::vector<phy::Cl45Data> kMixedBatchResults =
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0xbb, 0xbb};
+
+} // namespace
+
+class FbFpgaMdioBatchTest : public ::testing::Test {
+ public:
+  FakeMdioFpgaDevice device;
+  FpgaMemoryRegion region{"mdio", &device, 0, kFakeFpgaSize};
+  FbFpgaMdio mdio{&region, 0};
+};
+
+TEST_F(FbFpgaMdioBatchTest, mixedReadsAndWrites) {
+  device.regs[RegKey{2, 3, 0x20}] = 0x55;
+
+  EXPECT_EQ(kMixedBatchResults, mdio.executeBatch(mixedBatch()));
+  EXPECT_EQ(0xaa, device.regs[RegKey{1, 1, 0x10}]);
+  EXPECT_EQ(0xaa, device.regs[RegKey{1, 1, 0x11}]);
+  EXPECT_EQ(0xaa, device.regs[RegKey{1, 1, 0x12}]);
+  EXPECT_EQ(0xbb, device.regs[RegKey{2, 3, 0x20}]);
+  EXPECT_EQ(4, device.reads);
+  EXPECT_EQ(4, device.writes);
+  // Back to back writes of the same value share the write data, but reads
+  // in between forget it
+  EXPECT_EQ(3, device.writeDataWrites);
+}
+
+TEST_F(FbFpgaMdioBatchTest, matchesSingleTransactions) {
+  device.regs[RegKey{2, 3, 0x20}] = 0x55;
+
+  std::vector<phy::Cl45Data> results;
+  for (const auto& txn : mixedBatch()) {
+    if (txn.op == Cl45Transaction::Op::READ) {
+      results.push_back(mdio.readCl45(txn.physAddr, txn.devAddr, txn.regAddr));
+    } else {
+      mdio.writeCl45(txn.physAddr, txn.devAddr, txn.regAddr, txn.data);
+      results.push_back(txn.data);
+    }
+  }
+  EXPECT_EQ(kMixedBatchResults, results);
+  EXPECT_EQ(4, device.writeDataWrites);
+}
+
+TEST_F(FbFpgaMdioBatchTest, emptyBatch) {
+  EXPECT_TRUE(mdio.executeBatch({}).empty());
+  EXPECT_EQ(0, device.reads);
+  EXPECT_EQ(0, device.writes);
+}
+
+TEST(MdioBatchTest, defaultBatchIssuesEachTransaction) {
+  FakeMdio mdio;
+  mdio.regs[RegKey{2, 3, 0x20}] = 0x55;
+
+  EXPECT_EQ(kMixedBatchResults, mdio.executeBatch(mixedBatch()));
+  EXPECT_EQ(0xaa, mdio.regs[RegKey{1, 1, 0x12}]);
+  EXPECT_EQ(0xbb, mdio.regs[RegKey{2, 3, 0x20}]);
+}
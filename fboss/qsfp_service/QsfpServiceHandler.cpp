@@ -110,5 +110,11 @@ void QsfpServiceHandler::writeTransceiverRegister(
   }
   manager_->writeTransceiverRegister(response, std::move(request));
 }
+
+apache::thrift::ServerStream<TransceiverInfoDelta>
+QsfpServiceHandler::subscribeTransceiverInfo(int64_t fromGeneration) {
+  auto log = LOG_THRIFT_CALL(INFO);
+  return manager_->getTransceiverInfoStream()->subscribe(fromGeneration);
+}
 } // namespace fboss
 } // namespace facebook
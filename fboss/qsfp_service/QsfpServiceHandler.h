@@ -72,6 +72,12 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
       std::map<int32_t, WriteResponse>& response,
       std::unique_ptr<WriteRequest> request) override;
 
+  /*
+   * Stream transceiver info changes from the given generation on.
+   */
+  apache::thrift::ServerStream<TransceiverInfoDelta> subscribeTransceiverInfo(
+      int64_t fromGeneration) override;
+
  private:
   // Forbidden copy constructor and assignment operator
   QsfpServiceHandler(QsfpServiceHandler const&) = delete;
@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/TransceiverInfoStream.h"
+
+#include <folly/logging/xlog.h>
+
+#include <chrono>
+
+namespace facebook {
+namespace fboss {
+
+namespace {
+
+void clearReading(Sensor& sensor) {
+  sensor.value_ref() = 0;
+}
+
+/*
+ * The info with its sensor readings and stats zeroed, keeping the sensor
+ * flags, for comparing against the previous refresh
+ */
+TransceiverInfo withoutReadings(TransceiverInfo info) {
+  if (auto sensor = info.sensor_ref()) {
+    clearReading(*sensor->temp_ref());
+    clearReading(*sensor->vcc_ref());
+  }
+  for (auto& channel : *info.channels_ref()) {
+    auto& sensors = *channel.sensors_ref();
+    clearReading(*sensors.rxPwr_ref());
+    clearReading(*sensors.txBias_ref());
+    clearReading(*sensors.txPwr_ref());
+    if (auto txSnr = sensors.txSnr_ref()) {
+      clearReading(*txSnr);
+    }
+    if (auto rxSnr = sensors.rxSnr_ref()) {
+      clearReading(*rxSnr);
+    }
+  }
+  info.stats_ref().reset();
+  return info;
+}
+
+int64_t initialGeneration() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+TransceiverInfoStream::TransceiverInfoStream()
+    : state_(std::make_shared<folly::Synchronized<State>>()) {
+  state_->wlock()->generation = initialGeneration();
+}
+
+TransceiverInfoStream::~TransceiverInfoStream() {
+  std::map<uint64_t, std::unique_ptr<Publisher>> subscribers;
+  state_->withWLock([&subscribers](auto& state) {
+    subscribers.swap(state.subscribers);
+  });
+  // Complete outside of the lock, as completing runs the callback which
+  // removes the subscriber
+  for (auto& subscriber : subscribers) {
+    std::move(*subscriber.second).complete();
+  }
+}
+
+std::optional<TransceiverInfoDelta> TransceiverInfoStream::update(
+    const std::map<int32_t, TransceiverInfo>& infos) {
+  return state_->withWLock(
+      [&infos](auto& state) -> std::optional<TransceiverInfoDelta> {
+        TransceiverInfoDelta delta;
+        for (const auto& idAndInfo : infos) {
+          auto prev = state.infos.find(idAndInfo.first);
+          if (prev == state.infos.end() ||
+              withoutReadings(prev->second) !=
+                  withoutReadings(idAndInfo.second)) {
+            (*delta.changed_ref())[idAndInfo.first] = idAndInfo.second;
+          }
+          state.infos[idAndInfo.first] = idAndInfo.second;
+        }
+        if (delta.changed_ref()->empty()) {
+          return std::nullopt;
+        }
+
+        delta.previousGeneration_ref() = state.generation;
+        delta.generation_ref() = ++state.generation;
+        delta.full_ref() = false;
+        XLOG(DBG2) << "Pushing " << delta.changed_ref()->size()
+                   << " changed transceivers at generation "
+                   << state.generation << " to "
+                   << state.subscribers.size() << " subscribers";
+        // Publish under the lock, so no subscriber sees deltas out of order
+        for (auto& subscriber : state.subscribers) {
+          subscriber.second->next(delta);
+        }
+        return delta;
+      });
+}
+
+apache::thrift::ServerStream<TransceiverInfoDelta>
+TransceiverInfoStream::subscribe(int64_t fromGeneration) {
+  auto locked = state_->wlock();
+  auto id = locked->nextSubscriberId++;
+  std::weak_ptr<folly::Synchronized<State>> weakState = state_;
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<TransceiverInfoDelta>::createPublisher(
+          [weakState, id] {
+            XLOG(INFO) << "Transceiver info subscriber " << id << " gone";
+            if (auto state = weakState.lock()) {
+              state->wlock()->subscribers.erase(id);
+            }
+          });
+  auto& publisher = streamAndPublisher.second;
+
+  if (fromGeneration != locked->generation) {
+    TransceiverInfoDelta full;
+    full.generation_ref() = locked->generation;
+    full.previousGeneration_ref() = fromGeneration;
+    full.changed_ref() = locked->infos;
+    full.full_ref() = true;
+    publisher.next(std::move(full));
+  }
+  XLOG(INFO) << "Transceiver info subscriber " << id << " from generation "
+             << fromGeneration << ", at generation " << locked->generation;
+  locked->subscribers.emplace(
+      id, std::make_unique<Publisher>(std::move(publisher)));
+  return std::move(streamAndPublisher.first);
+}
+
+int64_t TransceiverInfoStream::getGeneration() const {
+  return state_->rlock()->generation;
+}
+
+size_t TransceiverInfoStream::numSubscribers() const {
+  return state_->rlock()->subscribers.size();
+}
+
+} // namespace fboss
+} // namespace facebook
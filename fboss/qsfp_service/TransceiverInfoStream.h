@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+
+#include <folly/Synchronized.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+
+#include "fboss/qsfp_service/if/gen-cpp2/qsfp_types.h"
+#include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
+
+namespace facebook {
+namespace fboss {
+
+/*
+ * Pushes transceiver info changes to subscribeTransceiverInfo subscribers.
+ *
+ * Every transceiver refresh hands the info of all transceivers to update(),
+ * which compares it against the last info it saw. Sensor readings and
+ * stats change on nearly every refresh and are left out of the comparison,
+ * so a transceiver is only pushed when its presence, a sensor's threshold
+ * flags or the rest of its info changed. Each push bumps the generation.
+ *
+ * The generation starts from the time qsfp_service started, in
+ * microseconds, so subscribers never see a generation reused across
+ * restarts, and can tell from previousGeneration whether they missed
+ * anything.
+ */
+class TransceiverInfoStream {
+ public:
+  TransceiverInfoStream();
+  ~TransceiverInfoStream();
+
+  /*
+   * Push the transceivers whose info changed. Returns the delta pushed,
+   * if any.
+   */
+  std::optional<TransceiverInfoDelta> update(
+      const std::map<int32_t, TransceiverInfo>& infos);
+
+  /*
+   * Subscribe to deltas. The first delta is a full one unless the
+   * subscriber is already at the current generation.
+   */
+  apache::thrift::ServerStream<TransceiverInfoDelta> subscribe(
+      int64_t fromGeneration);
+
+  int64_t getGeneration() const;
+  size_t numSubscribers() const;
+
+ private:
+  using Publisher =
+      apache::thrift::ServerStreamPublisher<TransceiverInfoDelta>;
+
+  struct State {
+    int64_t generation{0};
+    // Latest info of each transceiver, as handed to update()
+    std::map<int32_t, TransceiverInfo> infos;
+    std::map<uint64_t, std::unique_ptr<Publisher>> subscribers;
+    uint64_t nextSubscriberId{0};
+  };
+
+  // Forbidden copy constructor and assignment operator
+  TransceiverInfoStream(TransceiverInfoStream const&) = delete;
+  TransceiverInfoStream& operator=(TransceiverInfoStream const&) = delete;
+
+  // Shared with the subscribers' cancel callbacks, which may outlive us
+  std::shared_ptr<folly::Synchronized<State>> state_;
+};
+
+} // namespace fboss
+} // namespace facebook
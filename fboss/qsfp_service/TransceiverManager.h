@@ -10,6 +10,7 @@
 #include "fboss/lib/i2c/gen-cpp2/i2c_controller_stats_types.h"
 #include "fboss/lib/phy/PhyManager.h"
 #include "fboss/lib/usb/TransceiverPlatformApi.h"
+#include "fboss/qsfp_service/TransceiverInfoStream.h"
 #include "fboss/qsfp_service/module/Transceiver.h"
 
 class PlatformMode;
@@ -93,6 +94,13 @@ class TransceiverManager {
     return nullptr;
   }
 
+  /*
+   * Transceiver info changes, pushed after every refresh
+   */
+  TransceiverInfoStream* getTransceiverInfoStream() {
+    return &infoStream_;
+  }
+
  private:
   // Forbidden copy constructor and assignment operator
   TransceiverManager(TransceiverManager const&) = delete;
@@ -111,6 +119,7 @@ class TransceiverManager {
   // Before reaching that time point, the module is paused
   // and it will resume once the time is reached.
   time_t pauseRemediationUntil_{0};
+  TransceiverInfoStream infoStream_;
 };
 } // namespace fboss
 } // namespace facebook
@@ -10,6 +10,23 @@ include "fboss/agent/if/fboss.thrift"
 include "fboss/qsfp_service/if/transceiver.thrift"
 include "fboss/agent/switch_config.thrift"
 
+/*
+ * Transceivers whose info changed in a refresh of qsfp_service's transceiver
+ * cache. Changes to sensor values and stats alone are not pushed, only
+ * changes to presence, the flags of sensors crossing their thresholds, and
+ * the rest of the info (module type, media interface, settings...).
+ */
+struct TransceiverInfoDelta {
+  // Generations are never reused, including across qsfp_service restarts
+  1: i64 generation,
+  // Generation this delta applies on top of
+  2: i64 previousGeneration,
+  3: map<i32, transceiver.TransceiverInfo> changed,
+  // Whether changed has every transceiver, rather than changes since
+  // previousGeneration
+  4: bool full,
+}
+
 service QsfpService extends fb303.FacebookService {
   transceiver.TransceiverType getType(1: i32 idx)
 
@@ -67,4 +84,11 @@ service QsfpService extends fb303.FacebookService {
   map<i32, transceiver.WriteResponse> writeTransceiverRegister(
     1: transceiver.WriteRequest request
   ) throws (1: fboss.FbossBaseError error)
+
+  /*
+   * Stream transceiver info changes. The first delta has every transceiver
+   * unless fromGeneration is the current generation, subsequent ones only
+   * what changed since the previous delta.
+   */
+  stream<TransceiverInfoDelta> subscribeTransceiverInfo(1: i64 fromGeneration)
 }
@@ -16,6 +16,12 @@
 #include <folly/logging/xlog.h>
 #include <chrono>
 
+DEFINE_bool(
+    qsfp_info_stream,
+    true,
+    "Subscribe to transceiver info changes from qsfp_service, rather than "
+    "only learning them as ports change");
+
 namespace facebook {
 namespace fboss {
 
@@ -23,6 +29,36 @@ namespace {
 constexpr std::chrono::seconds kLivenessCheckInterval(30);
 }
 
+QsfpCache::~QsfpCache() {
+  stopSubscription();
+}
+
+void QsfpCache::stopSubscription() {
+  if (subscriptionStopped_ || !evb_) {
+    return;
+  }
+  subscriptionStopped_ = true;
+  CHECK(!evb_->isInEventBaseThread());
+
+  std::optional<
+      apache::thrift::ClientBufferedStream<TransceiverInfoDelta>::Subscription>
+      subscription;
+  evb_->runInEventBaseThreadAndWait([this, &subscription] {
+    stopping_ = true;
+    subscription.swap(subscription_);
+    if (subscription) {
+      subscription->cancel();
+    }
+  });
+  // The subscription's callback captures this, and runs in evb_ until the
+  // cancellation goes through
+  if (subscription) {
+    std::move(*subscription).join();
+  }
+  // streamClient_'s channel belongs to evb_
+  evb_->runInEventBaseThreadAndWait([this] { streamClient_.reset(); });
+}
+
 void QsfpCache::init(folly::EventBase* evb, const PortMapThrift& ports) {
   if (!evb) {
     throw std::runtime_error("must pass in non-null evb");
@@ -39,6 +75,10 @@ void QsfpCache::init(folly::EventBase* evb, const PortMapThrift& ports) {
 
   attachEventBase(evb);
   scheduleTimeout(kLivenessCheckInterval);
+
+  if (FLAGS_qsfp_info_stream) {
+    folly::via(evb_).then(&QsfpCache::maybeSubscribe, this);
+  }
 }
 
 void QsfpCache::init(folly::EventBase* evb) {
@@ -180,8 +220,94 @@ folly::Future<folly::Unit> QsfpCache::doSync(PortMapThrift&& toSync) {
       });
 }
 
-void QsfpCache::updateCache(const TcvrMapThrift& tcvrs) {
-  tcvrs_.withWLock([&tcvrs](auto& lockedTcvrs) {
+void QsfpCache::maybeSubscribe() {
+  CHECK(evb_->isInEventBaseThread());
+
+  if (subscribing_ || subscribed_ || stopping_) {
+    return;
+  }
+  if (subscription_) {
+    // The previous subscription ended, let go of it
+    std::move(*subscription_).detach();
+    subscription_.reset();
+  }
+
+  auto subscribe = [this](std::unique_ptr<QsfpServiceAsyncClient> client) {
+    XLOG(DBG1) << "Subscribing to transceiver info from generation "
+               << streamGen_;
+    streamClient_ = std::move(client);
+    auto options = QsfpClient::getRpcOptions();
+    return streamClient_->semifuture_subscribeTransceiverInfo(
+        options, streamGen_);
+  };
+  auto onSubscribed = [this](auto&& stream) {
+    if (stopping_) {
+      // Dropping the stream unsubscribed
+      return;
+    }
+    subscribed_ = true;
+    subscription_ = std::move(stream).subscribeExTry(
+        evb_, [this](auto&& delta) { deltaReceived(std::move(delta)); });
+  };
+
+  subscribing_ = true;
+  QsfpClient::createStreamingClient(evb_)
+      .thenValue(subscribe)
+      .via(evb_)
+      .thenValue(onSubscribed)
+      .thenError(
+          folly::tag_t<std::exception>{},
+          [](const std::exception& e) {
+            XLOG(ERR) << "Failed to subscribe to transceiver info: "
+                      << e.what();
+          })
+      .ensure([this]() { subscribing_ = false; });
+}
+
+void QsfpCache::deltaReceived(folly::Try<TransceiverInfoDelta>&& delta) {
+  CHECK(evb_->isInEventBaseThread());
+
+  if (!delta.hasValue()) {
+    if (delta.hasException()) {
+      XLOG(ERR) << "Transceiver info stream broke: "
+                << delta.exception().what();
+    } else {
+      XLOG(INFO) << "Transceiver info stream completed";
+    }
+    // Subscribe again on the next liveness check
+    subscribed_ = false;
+    return;
+  }
+
+  XLOG(DBG2) << "Got " << delta->changed_ref()->size()
+             << " changed transceivers at generation "
+             << *delta->generation_ref();
+  // A full snapshot has every transceiver, so any other one is gone
+  updateCache(*delta->changed_ref(), *delta->full_ref());
+  if (!*delta->full_ref() && *delta->previousGeneration_ref() != streamGen_) {
+    // We missed deltas in between, so some transceivers may be stale. Fall
+    // back to syncing all ports, which gets the info of every transceiver
+    // with ports. Mark the ports changed rather than resetting remoteGen_,
+    // which an inflight request would set again.
+    XLOG(WARN) << "Missed transceiver info generations " << streamGen_
+               << " to " << *delta->previousGeneration_ref()
+               << ", syncing all ports";
+    ports_.withWLock([this](auto& lockedPorts) {
+      auto gen = this->incrementGen();
+      for (auto& item : lockedPorts) {
+        item.second.generation = gen;
+      }
+    });
+    maybeSync();
+  }
+  streamGen_ = *delta->generation_ref();
+}
+
+void QsfpCache::updateCache(const TcvrMapThrift& tcvrs, bool replace) {
+  tcvrs_.withWLock([&tcvrs, replace](auto& lockedTcvrs) {
+    if (replace) {
+      lockedTcvrs.clear();
+    }
     for (const auto& item : tcvrs) {
       lockedTcvrs[TransceiverID(item.first)] = item.second;
     }
@@ -229,6 +355,9 @@ folly::Future<TransceiverInfo> QsfpCache::futureGet(TransceiverID tcvrId) {
 
 void QsfpCache::timeoutExpired() noexcept {
   confirmAlive().then(&QsfpCache::maybeSync, this);
+  if (FLAGS_qsfp_info_stream) {
+    maybeSubscribe();
+  }
   scheduleTimeout(kLivenessCheckInterval);
 }
 
@@ -253,6 +382,8 @@ AutoInitQsfpCache::AutoInitQsfpCache() {
 }
 
 AutoInitQsfpCache::~AutoInitQsfpCache() {
+  // Needs evb_ looping, so before ~QsfpCache
+  stopSubscription();
   if (thread_) {
     evb_.runInEventBaseThread([this] { evb_.terminateLoopSoon(); });
     thread_->join();
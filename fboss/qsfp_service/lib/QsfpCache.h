@@ -20,11 +20,17 @@
 #include <folly/futures/SharedPromise.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp2/async/ClientBufferedStream.h>
 
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/types.h"
+#include "fboss/qsfp_service/if/gen-cpp2/QsfpServiceAsyncClient.h"
+#include "fboss/qsfp_service/if/gen-cpp2/qsfp_types.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+DECLARE_bool(qsfp_info_stream);
+
 /*
  * This class is a helper for clients that want to exchange port state w/ qsfp
  * service. It is built around a single thrift call defined in qsfp.thrift:
@@ -60,6 +66,17 @@
  * and store the last aliveSince. If this changes, we reset remoteGen_
  * back to zero so we will re-sync all ports.
  *
+ * Transceiver info changes
+ * ------------------------
+ * syncPorts only returns transceiver info when ports change. With
+ * --qsfp_info_stream we also subscribe to qsfp_service's
+ * subscribeTransceiverInfo stream, which pushes the info of transceivers
+ * that changed (presence, sensor flags, media interface...) as refreshes
+ * find them. Each push names the generation it applies on top of. If that
+ * is not the last generation we applied, we missed some and fall back to
+ * syncing all ports. If the stream breaks, e.g. as qsfp_service restarts,
+ * we subscribe again on the next liveness check.
+ *
  * Threading model
  * ---------------
  * All thrift calls to qsfp_service are done on evb_. No guarantee for
@@ -78,6 +95,7 @@ class QsfpCache : private folly::AsyncTimeout {
   using TcvrMapThrift = std::map<int32_t, TransceiverInfo>;
 
   QsfpCache() = default;
+  ~QsfpCache() override;
 
   /* Initializers. Sets the Eventbase and optionally the initial port
    * map to sync to qsfp_service.
@@ -111,6 +129,13 @@ class QsfpCache : private folly::AsyncTimeout {
   // output state of the cache. Useful for debugging
   void dump();
 
+ protected:
+  /*
+   * Cancels the transceiver info subscription and waits for it to end. evb_
+   * must still be looping, and this must not be called from it.
+   */
+  void stopSubscription();
+
  private:
   // Forbidden copy constructor and assignment operator
   QsfpCache(QsfpCache const&) = delete;
@@ -130,13 +155,19 @@ class QsfpCache : private folly::AsyncTimeout {
   folly::Future<folly::Unit> confirmAlive();
 
   /* Called after successful sync to update transceivers in to our
-   * cache.
+   * cache. replace drops any transceiver not in tcvrs.
    */
-  void updateCache(const TcvrMapThrift& tcvrs);
+  void updateCache(const TcvrMapThrift& tcvrs, bool replace = false);
 
   // gets a new unique generation number
   uint32_t incrementGen();
 
+  // subscribes to transceiver info changes, unless already subscribed
+  void maybeSubscribe();
+
+  // applies one transceiver info delta from the subscription
+  void deltaReceived(folly::Try<TransceiverInfoDelta>&& delta);
+
   struct PortCacheValue {
     PortStatus port;
     uint32_t generation{0};
@@ -158,6 +189,19 @@ class QsfpCache : private folly::AsyncTimeout {
   int64_t remoteAliveSince_{-1};
 
   std::atomic_bool initialized_{false};
+
+  // Subscription to transceiver info changes, only accessed in evb_
+  std::unique_ptr<QsfpServiceAsyncClient> streamClient_;
+  std::optional<
+      apache::thrift::ClientBufferedStream<TransceiverInfoDelta>::Subscription>
+      subscription_;
+  bool subscribing_{false};
+  bool subscribed_{false};
+  bool stopping_{false};
+  // Only accessed by the thread destroying us
+  bool subscriptionStopped_{false};
+  // generation of the last delta applied, -1 for none
+  int64_t streamGen_{-1};
 };
 
 class AutoInitQsfpCache : public QsfpCache {
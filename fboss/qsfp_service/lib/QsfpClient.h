@@ -37,6 +37,13 @@ class QsfpClient {
   static folly::Future<std::unique_ptr<QsfpServiceAsyncClient>> createClient(
       folly::EventBase* eb);
 
+  /*
+   * Client for streaming calls such as subscribeTransceiverInfo, which need
+   * a rocket rather than a header channel
+   */
+  static folly::Future<std::unique_ptr<QsfpServiceAsyncClient>>
+  createStreamingClient(folly::EventBase* eb);
+
   static apache::thrift::RpcOptions getRpcOptions();
 };
 
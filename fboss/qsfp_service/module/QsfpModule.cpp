@@ -152,6 +152,11 @@ bool QsfpModule::cacheIsValid() const {
   return present_ && !dirty_;
 }
 
+TransceiverReadCycle QsfpModule::getLastReadCycle() const {
+  lock_guard<std::mutex> g(qsfpModuleMutex_);
+  return lastReadCycle_;
+}
+
 TransceiverInfo QsfpModule::getTransceiverInfo() {
   auto cachedInfo = info_.rlock();
   if (!cachedInfo->has_value()) {
@@ -14,6 +14,7 @@
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 #include "fboss/qsfp_service/module/ModuleStateMachine.h"
 #include "fboss/qsfp_service/module/Transceiver.h"
+#include "fboss/qsfp_service/module/TransceiverReadPlan.h"
 
 #include <folly/Synchronized.h>
 #include <folly/experimental/FunctionScheduler.h>
@@ -187,6 +188,11 @@ class QsfpModule : public Transceiver {
 
   using LengthAndGauge = std::pair<double, uint8_t>;
 
+  /*
+   * I2C reads, writes and bytes read by the last cache refresh
+   */
+  TransceiverReadCycle getLastReadCycle() const;
+
  protected:
   // no copy or assignment
   QsfpModule(QsfpModule const&) = delete;
@@ -227,6 +233,7 @@ class QsfpModule : public Transceiver {
    * too frequently. These MUST be accessed holding qsfpModuleMutex_.
    */
   time_t lastRefreshTime_{0};
+  TransceiverReadCycle lastReadCycle_;
   time_t lastCustomizeTime_{0};
   time_t lastRemediateTime_{0};
 
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/module/TransceiverReadPlan.h"
+
+#include "fboss/lib/usb/TransceiverI2CApi.h"
+#include "fboss/qsfp_service/module/TransceiverImpl.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    qsfp_read_coalesce_gap,
+    32,
+    "Bytes between two transceiver fields below which refreshes read both "
+    "fields in one I2C transaction rather than two");
+
+namespace {
+
+constexpr int kPageSize = 128;
+constexpr int kPageSelectOffset = 127;
+
+} // namespace
+
+namespace facebook {
+namespace fboss {
+
+void TransceiverReadPlan::addRange(int page, int offset, int length) {
+  CHECK_GE(offset, 0);
+  CHECK_GT(length, 0);
+  // A range may not straddle the lower and upper halves of the memory map
+  CHECK_EQ(offset / kPageSize, (offset + length - 1) / kPageSize);
+  CHECK_LT(offset + length, 2 * kPageSize + 1);
+  ranges_[page].push_back({offset, length});
+}
+
+void TransceiverReadPlan::addPage(int page, bool upper) {
+  addRange(page, upper ? kPageSize : 0, kPageSize);
+}
+
+void TransceiverReadPlan::coalesce(int maxGap) {
+  for (auto& pageAndRanges : ranges_) {
+    auto& ranges = pageAndRanges.second;
+    std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+      return a.offset < b.offset;
+    });
+    std::vector<Range> coalesced;
+    for (const auto& range : ranges) {
+      if (!coalesced.empty()) {
+        auto& last = coalesced.back();
+        auto lastEnd = last.offset + last.length;
+        if (range.offset - lastEnd <= maxGap) {
+          last.length = std::max(lastEnd, range.offset + range.length) -
+              last.offset;
+          continue;
+        }
+      }
+      coalesced.push_back(range);
+    }
+    ranges = std::move(coalesced);
+  }
+}
+
+bool TransceiverReadPlan::covers(int page, int offset) const {
+  auto pageRanges = ranges_.find(page);
+  if (pageRanges == ranges_.end()) {
+    return false;
+  }
+  return std::any_of(
+      pageRanges->second.begin(),
+      pageRanges->second.end(),
+      [offset](const auto& range) {
+        return range.offset <= offset && offset < range.offset + range.length;
+      });
+}
+
+void TransceiverReadPlan::read(
+    TransceiverImpl* impl,
+    const std::vector<TransceiverPageCache>& pages,
+    TransceiverReadCycle& cycle) const {
+  std::vector<std::pair<const TransceiverPageCache*, const std::vector<Range>*>>
+      selectedPages;
+  for (const auto& page : pages) {
+    auto pageRanges = ranges_.find(page.page);
+    if (pageRanges == ranges_.end()) {
+      continue;
+    }
+    if (!page.select) {
+      readRanges(impl, page, pageRanges->second, cycle);
+    } else {
+      selectedPages.emplace_back(&page, &pageRanges->second);
+    }
+  }
+
+  // Start with the page which is already selected, if any
+  auto alreadySelected = std::find_if(
+      selectedPages.begin(), selectedPages.end(), [&cycle](const auto& page) {
+        return page.first->select == cycle.selectedPage;
+      });
+  if (alreadySelected != selectedPages.end()) {
+    std::rotate(selectedPages.begin(), alreadySelected, alreadySelected + 1);
+  }
+
+  for (const auto& pageAndRanges : selectedPages) {
+    const auto& page = *pageAndRanges.first;
+    uint8_t select = *page.select;
+    if (cycle.selectedPage == select) {
+      ++cycle.pageSelectsSkipped;
+    } else {
+      impl->writeTransceiver(
+          TransceiverI2CApi::ADDR_QSFP,
+          kPageSelectOffset,
+          sizeof(select),
+          &select);
+      ++cycle.writes;
+      cycle.selectedPage = select;
+    }
+    if (page.setup) {
+      uint8_t value = page.setup->second;
+      impl->writeTransceiver(
+          TransceiverI2CApi::ADDR_QSFP,
+          page.setup->first,
+          sizeof(value),
+          &value);
+      ++cycle.writes;
+    }
+    readRanges(impl, page, *pageAndRanges.second, cycle);
+  }
+}
+
+void TransceiverReadPlan::readRanges(
+    TransceiverImpl* impl,
+    const TransceiverPageCache& page,
+    const std::vector<Range>& ranges,
+    TransceiverReadCycle& cycle) const {
+  for (const auto& range : ranges) {
+    auto cacheOffset = range.offset % kPageSize;
+    impl->readTransceiver(
+        TransceiverI2CApi::ADDR_QSFP,
+        range.offset,
+        range.length,
+        page.data + cacheOffset);
+    ++cycle.reads;
+    cycle.bytesRead += range.length;
+  }
+}
+
+uint32_t TransceiverReadPlan::numReads() const {
+  uint32_t reads = 0;
+  for (const auto& pageAndRanges : ranges_) {
+    reads += pageAndRanges.second.size();
+  }
+  return reads;
+}
+
+uint32_t TransceiverReadPlan::numBytes() const {
+  uint32_t bytes = 0;
+  for (const auto& pageAndRanges : ranges_) {
+    for (const auto& range : pageAndRanges.second) {
+      bytes += range.length;
+    }
+  }
+  return bytes;
+}
+
+} // namespace fboss
+} // namespace facebook
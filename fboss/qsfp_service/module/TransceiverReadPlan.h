@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <gflags/gflags.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+DECLARE_int32(qsfp_read_coalesce_gap);
+
+namespace facebook {
+namespace fboss {
+
+class TransceiverImpl;
+
+/*
+ * What one cache refresh cost on the I2C bus
+ */
+struct TransceiverReadCycle {
+  uint32_t reads{0};
+  uint32_t writes{0};
+  uint32_t bytesRead{0};
+  uint32_t pageSelectsSkipped{0};
+  // Value of the page select byte, if known
+  std::optional<uint8_t> selectedPage;
+};
+
+/*
+ * Where a page of the module's memory map is cached, and how to get at it
+ */
+struct TransceiverPageCache {
+  // Page, as in the dataAddress of the CmisFieldInfo/SffFieldInfo tables
+  int page{0};
+  // Cache of the 128 bytes of the page
+  uint8_t* data{nullptr};
+  // Value to write to the page select byte before reading the page, unset
+  // for the lower page and for flat memory modules
+  std::optional<uint8_t> select{std::nullopt};
+  // Register (offset, value) to write once the page is selected, before
+  // reading it, e.g. to pick which diagnostics a page reports
+  std::optional<std::pair<int, uint8_t>> setup{std::nullopt};
+};
+
+/*
+ * The register ranges a cache refresh reads, built from the field tables.
+ *
+ * Fields are coalesced into as few reads as is worth it: two ranges on the
+ * same page are read together when the bytes between them cost less than
+ * another I2C transaction, which --qsfp_read_coalesce_gap approximates.
+ */
+class TransceiverReadPlan {
+ public:
+  struct Range {
+    int offset;
+    int length;
+  };
+
+  TransceiverReadPlan() {}
+
+  void addRange(int page, int offset, int length);
+
+  /*
+   * Add a whole 128 byte page, the lower page if upper is false
+   */
+  void addPage(int page, bool upper = true);
+
+  template <typename FieldMap, typename Field>
+  void addFields(
+      const FieldMap& fieldMap,
+      std::initializer_list<Field> fields) {
+    for (auto field : fields) {
+      const auto& info = fieldMap.at(field);
+      addRange(info.dataAddress, info.offset, info.length);
+    }
+  }
+
+  /*
+   * Merge overlapping ranges, and ranges at most maxGap bytes apart
+   */
+  void coalesce(int maxGap = FLAGS_qsfp_read_coalesce_gap);
+
+  bool covers(int page, int offset) const;
+
+  /*
+   * Read the planned ranges of the given pages into their caches. Pages
+   * without planned ranges, and planned pages not given, are skipped.
+   *
+   * Pages that need no select are read first. Of the rest, the page
+   * cycle.selectedPage says is already selected is read first without
+   * writing the page select byte, so consecutive refreshes reuse each
+   * other's last page select.
+   */
+  void read(
+      TransceiverImpl* impl,
+      const std::vector<TransceiverPageCache>& pages,
+      TransceiverReadCycle& cycle) const;
+
+  uint32_t numReads() const;
+  uint32_t numBytes() const;
+
+  const std::map<int, std::vector<Range>>& getRanges() const {
+    return ranges_;
+  }
+
+ private:
+  void readRanges(
+      TransceiverImpl* impl,
+      const TransceiverPageCache& page,
+      const std::vector<Range>& ranges,
+      TransceiverReadCycle& cycle) const;
+
+  // Sorted and coalesced by coalesce()
+  std::map<int, std::vector<Range>> ranges_;
+};
+
+} // namespace fboss
+} // namespace facebook
@@ -725,8 +725,9 @@ void CmisModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
+    const auto& plan = getReadPlan(allPages);
+    TransceiverReadCycle cycle;
+    plan.read(qsfpImpl_.get(), {{CmisPages::LOWER, lowerPage_}}, cycle);
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
     setQsfpFlatMem();
@@ -737,68 +738,46 @@ void CmisModule::updateQsfpData(bool allPages) {
       opticsModuleStateMachine_.get_attribute(cmisModuleReady) = false;
     }
 
-    // If we have flat memory, we don't have to set the page
-    if (!flatMem_) {
-      uint8_t page = 0x00;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-    }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
-    if (!flatMem_) {
-      uint8_t page = 0x10;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page10_), page10_);
-
-      page = 0x11;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page11_), page11_);
-
+    std::vector<TransceiverPageCache> upperPages;
+    if (flatMem_) {
+      // If we have flat memory, we don't have to set the page
+      upperPages.push_back({CmisPages::PAGE00, page0_, std::nullopt});
+    } else {
+      // The page select byte tells us if a page we need is selected already
+      int offset;
+      int length;
+      int dataAddress;
+      getQsfpFieldAddress(
+          CmisField::PAGE_SELECT_BYTE, dataAddress, offset, length);
+      if (plan.covers(dataAddress, offset)) {
+        cycle.selectedPage = lowerPage_[offset];
+      }
+      upperPages.push_back({CmisPages::PAGE00, page0_, 0x00});
+      upperPages.push_back({CmisPages::PAGE01, page01_, 0x01});
+      upperPages.push_back({CmisPages::PAGE02, page02_, 0x02});
+      upperPages.push_back({CmisPages::PAGE10, page10_, 0x10});
+      upperPages.push_back({CmisPages::PAGE11, page11_, 0x11});
+      upperPages.push_back({CmisPages::PAGE13, page13_, 0x13});
       if (opticsModuleStateMachine_.get_attribute(cmisModuleReady)) {
-        page = 0x14;
-        auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
-        qsfpImpl_->writeTransceiver(
-            TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-        qsfpImpl_->writeTransceiver(
-            TransceiverI2CApi::ADDR_QSFP,
-            128,
-            sizeof(diagFeature),
-            &diagFeature);
-        qsfpImpl_->readTransceiver(
-            TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page14_), page14_);
+        int diagOffset;
+        getQsfpFieldAddress(
+            CmisField::DIAG_SEL, dataAddress, diagOffset, length);
+        upperPages.push_back(
+            {CmisPages::PAGE14,
+             page14_,
+             0x14,
+             std::make_pair(
+                 diagOffset,
+                 static_cast<uint8_t>(DiagnosticFeatureEncoding::SNR))});
       }
     }
+    plan.read(qsfpImpl_.get(), upperPages, cycle);
 
-    if (!allPages) {
-      // The information on the following pages are static. Thus no need to
-      // fetch them every time. We just need to do it when we first retriving
-      // the data from this module.
-      return;
-    }
-
-    if (!flatMem_) {
-      uint8_t page = 0x01;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page01_), page01_);
-
-      page = 0x02;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page02_), page02_);
-
-      page = 0x13;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page13_), page13_);
-    }
+    lastReadCycle_ = cycle;
+    XLOG(DBG3) << "Read " << cycle.bytesRead << " bytes in " << cycle.reads
+               << " reads and " << cycle.writes << " writes refreshing "
+               << "transceiver "
+               << folly::to<std::string>(qsfpImpl_->getName());
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
     // to true.
@@ -810,6 +789,86 @@ void CmisModule::updateQsfpData(bool allPages) {
   }
 }
 
+const TransceiverReadPlan& CmisModule::getReadPlan(bool allPages) {
+  // Built on first use, once flags are parsed
+  static const TransceiverReadPlan fullPlan = [] {
+    TransceiverReadPlan plan;
+    plan.addPage(CmisPages::LOWER, false);
+    plan.addPage(CmisPages::PAGE00);
+    plan.addPage(CmisPages::PAGE01);
+    plan.addPage(CmisPages::PAGE02);
+    plan.addPage(CmisPages::PAGE10);
+    plan.addPage(CmisPages::PAGE11);
+    plan.addPage(CmisPages::PAGE13);
+    plan.addPage(CmisPages::PAGE14);
+    return plan;
+  }();
+  // The fields which change at runtime. The information on the other
+  // fields is static, thus no need to fetch it every time. We just need to
+  // do it when we first retrieve the data from this module.
+  static const TransceiverReadPlan partialPlan = [] {
+    TransceiverReadPlan plan;
+    plan.addFields(
+        cmisFields,
+        {CmisField::FLAT_MEM,
+         CmisField::MODULE_STATE,
+         CmisField::BANK0_FLAGS,
+         CmisField::BANK1_FLAGS,
+         CmisField::BANK2_FLAGS,
+         CmisField::BANK3_FLAGS,
+         CmisField::MODULE_FLAG,
+         CmisField::MODULE_ALARMS,
+         CmisField::TEMPERATURE,
+         CmisField::VCC,
+         CmisField::MODULE_CONTROL,
+         CmisField::PAGE_SELECT_BYTE,
+         // Page 10h
+         CmisField::DATA_PATH_DEINIT,
+         CmisField::TX_POLARITY_FLIP,
+         CmisField::TX_DISABLE,
+         CmisField::TX_SQUELCH_DISABLE,
+         CmisField::TX_FORCE_SQUELCH,
+         CmisField::TX_ADAPTATION_FREEZE,
+         CmisField::TX_ADAPTATION_STORE,
+         CmisField::RX_POLARITY_FLIP,
+         CmisField::RX_DISABLE,
+         CmisField::RX_SQUELCH_DISABLE,
+         CmisField::STAGE_CTRL_SET_0,
+         CmisField::APP_SEL_LANE_1,
+         CmisField::APP_SEL_LANE_2,
+         CmisField::APP_SEL_LANE_3,
+         CmisField::APP_SEL_LANE_4,
+         // Page 11h
+         CmisField::DATA_PATH_STATE,
+         CmisField::TX_FAULT_FLAG,
+         CmisField::TX_LOS_FLAG,
+         CmisField::TX_LOL_FLAG,
+         CmisField::TX_EQ_FLAG,
+         CmisField::TX_PWR_FLAG,
+         CmisField::TX_BIAS_FLAG,
+         CmisField::RX_LOS_FLAG,
+         CmisField::RX_LOL_FLAG,
+         CmisField::RX_PWR_FLAG,
+         CmisField::CHANNEL_TX_PWR,
+         CmisField::CHANNEL_TX_BIAS,
+         CmisField::CHANNEL_RX_PWR,
+         CmisField::ACTIVE_CTRL_LANE_1,
+         CmisField::ACTIVE_CTRL_LANE_2,
+         CmisField::ACTIVE_CTRL_LANE_3,
+         CmisField::ACTIVE_CTRL_LANE_4,
+         CmisField::TX_CDR_CONTROL,
+         CmisField::RX_CDR_CONTROL,
+         // Page 14h
+         CmisField::HOST_LANE_CHECKER_LOL,
+         CmisField::HOST_BER,
+         CmisField::MEDIA_BER_HOST_SNR,
+         CmisField::MEDIA_SNR});
+    plan.coalesce();
+    return plan;
+  }();
+  return allPages ? fullPlan : partialPlan;
+}
+
 void CmisModule::setApplicationCode(cfg::PortSpeed speed) {
   auto applicationIter = speedApplicationMapping.find(speed);
 
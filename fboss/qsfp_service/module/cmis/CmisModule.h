@@ -218,6 +218,11 @@ class CmisModule : public QsfpModule {
    */
   virtual void updateQsfpData(bool allPages = true) override;
 
+  /*
+   * Register ranges refreshed by full and by partial cache refreshes
+   */
+  static const TransceiverReadPlan& getReadPlan(bool allPages);
+
   /*
    * Put logic here that should only be run on ports that have been
    * down for a long time. These are actions that are potentially more
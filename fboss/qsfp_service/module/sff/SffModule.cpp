@@ -674,36 +674,41 @@ void SffModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
+    const auto& plan = getReadPlan(allPages);
+    TransceiverReadCycle cycle;
+    plan.read(qsfpImpl_.get(), {{SffPages::LOWER, lowerPage_}}, cycle);
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
     setQsfpFlatMem();
 
-    if (!allPages) {
-      // Only the first page has fields that change often so provide
-      // an option to only fetch that page. Also the write path is
-      // particularly slow due to using an i2c bus, so writing the
-      // bytes needed to select later pages on non-flat memories can
-      // be quite expensive.
-      return;
+    // Only full refreshes read the upper pages, as only the lower page has
+    // fields that change often. Also the write path is particularly slow due
+    // to using an i2c bus, so writing the bytes needed to select later pages
+    // on non-flat memories can be quite expensive. The page select byte
+    // tells us if the page we need is selected already.
+    std::vector<TransceiverPageCache> upperPages;
+    if (flatMem_) {
+      // If we have flat memory, we don't have to set the page
+      upperPages.push_back({SffPages::PAGE0, page0_, std::nullopt});
+    } else {
+      int offset;
+      int length;
+      int dataAddress;
+      getQsfpFieldAddress(
+          SffField::PAGE_SELECT_BYTE, dataAddress, offset, length);
+      if (plan.covers(dataAddress, offset)) {
+        cycle.selectedPage = lowerPage_[offset];
+      }
+      upperPages.push_back({SffPages::PAGE0, page0_, 0});
+      upperPages.push_back({SffPages::PAGE3, page3_, 3});
     }
+    plan.read(qsfpImpl_.get(), upperPages, cycle);
 
-    // If we have flat memory, we don't have to set the page
-    if (!flatMem_) {
-      uint8_t page = 0;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-    }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
-    if (!flatMem_) {
-      uint8_t page = 3;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page3_), page3_);
-    }
+    lastReadCycle_ = cycle;
+    XLOG(DBG3) << "Read " << cycle.bytesRead << " bytes in " << cycle.reads
+               << " reads and " << cycle.writes << " writes refreshing "
+               << "transceiver "
+               << folly::to<std::string>(qsfpImpl_->getName());
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
     // to true.
@@ -715,6 +720,45 @@ void SffModule::updateQsfpData(bool allPages) {
   }
 }
 
+const TransceiverReadPlan& SffModule::getReadPlan(bool allPages) {
+  // Built on first use, once flags are parsed
+  static const TransceiverReadPlan fullPlan = [] {
+    TransceiverReadPlan plan;
+    plan.addPage(SffPages::LOWER, false);
+    plan.addPage(SffPages::PAGE0);
+    plan.addPage(SffPages::PAGE3);
+    return plan;
+  }();
+  // The fields which change at runtime, everything else is only refreshed
+  // by full refreshes
+  static const TransceiverReadPlan partialPlan = [] {
+    TransceiverReadPlan plan;
+    plan.addFields(
+        qsfpFields,
+        {SffField::STATUS,
+         SffField::LOS,
+         SffField::LOL,
+         SffField::TEMPERATURE_ALARMS,
+         SffField::VCC_ALARMS,
+         SffField::CHANNEL_RX_PWR_ALARMS,
+         SffField::CHANNEL_TX_BIAS_ALARMS,
+         SffField::CHANNEL_TX_PWR_ALARMS,
+         SffField::TEMPERATURE,
+         SffField::VCC,
+         SffField::CHANNEL_RX_PWR,
+         SffField::CHANNEL_TX_BIAS,
+         SffField::CHANNEL_TX_PWR,
+         SffField::TX_DISABLE,
+         SffField::RATE_SELECT_RX,
+         SffField::RATE_SELECT_TX,
+         SffField::POWER_CONTROL,
+         SffField::CDR_CONTROL});
+    plan.coalesce();
+    return plan;
+  }();
+  return allPages ? fullPlan : partialPlan;
+}
+
 void SffModule::setCdrIfSupported(
     cfg::PortSpeed speed,
     FeatureState currentStateTx,
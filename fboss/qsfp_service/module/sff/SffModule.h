@@ -208,6 +208,11 @@ class SffModule : public QsfpModule {
    */
   void updateQsfpData(bool allPages = true) override;
 
+  /*
+   * Register ranges refreshed by full and by partial cache refreshes
+   */
+  static const TransceiverReadPlan& getReadPlan(bool allPages);
+
  private:
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
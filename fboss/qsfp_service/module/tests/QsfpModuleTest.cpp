@@ -8,6 +8,7 @@
  *
  */
 
+#include "fboss/qsfp_service/module/tests/MockCmisModule.h"
 #include "fboss/qsfp_service/module/tests/MockSffModule.h"
 #include "fboss/qsfp_service/module/tests/MockTransceiverImpl.h"
 #include "fboss/qsfp_service/platforms/wedge/tests/MockWedgeManager.h"
@@ -16,6 +17,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/lib/usb/TransceiverI2CApi.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 #include "fboss/qsfp_service/module/QsfpModule.h"
 #include "fboss/qsfp_service/module/TransceiverImpl.h"
@@ -410,6 +412,112 @@ TEST_F(QsfpModuleTest, updateQsfpDataFull) {
   qsfp_->actualUpdateQsfpData(true);
 }
 
+TEST_F(QsfpModuleTest, updateQsfpDataPartialReadsDomFields) {
+  // The fields which change are coalesced into a single read of less
+  // than the whole lower page
+  EXPECT_CALL(*transImpl_, readTransceiver(_, _, _, _)).Times(1);
+  EXPECT_CALL(*transImpl_, writeTransceiver(_, _, _, _)).Times(0);
+  qsfp_->actualUpdateQsfpData(false);
+
+  auto cycle = qsfp_->getLastReadCycle();
+  EXPECT_EQ(1u, cycle.reads);
+  EXPECT_EQ(0u, cycle.writes);
+  EXPECT_LT(cycle.bytesRead, SffModule::MAX_QSFP_PAGE_SIZE);
+}
+
+TEST_F(QsfpModuleTest, updateQsfpDataFullSkipsSelectedPage) {
+  ON_CALL(*transImpl_, readTransceiver(_, _, _, _))
+      .WillByDefault(Invoke([](int, int offset, int len, uint8_t* data) {
+        std::fill(data, data + len, 0);
+        if (offset == 0) {
+          // Page 3 is still selected, as by the last full refresh
+          data[127] = 3;
+        }
+        return 0;
+      }));
+
+  // Each page is read whole, page 3 without selecting it again. Selecting
+  // each upper page would take two writes.
+  EXPECT_CALL(*transImpl_, readTransceiver(_, _, _, _)).Times(3);
+  EXPECT_CALL(*transImpl_, writeTransceiver(_, 127, 1, Pointee(0))).Times(1);
+  qsfp_->actualUpdateQsfpData(true);
+
+  auto cycle = qsfp_->getLastReadCycle();
+  EXPECT_EQ(3u, cycle.reads);
+  EXPECT_EQ(1u, cycle.writes);
+  EXPECT_EQ(1u, cycle.pageSelectsSkipped);
+  EXPECT_EQ(3 * SffModule::MAX_QSFP_PAGE_SIZE, cycle.bytesRead);
+
+  // The next full refresh finds page 0 selected, and starts with that
+  EXPECT_CALL(*transImpl_, readTransceiver(_, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([](int, int offset, int len, uint8_t* data) {
+        std::fill(data, data + len, 0);
+        return 0;
+      }));
+  EXPECT_CALL(*transImpl_, writeTransceiver(_, 127, 1, Pointee(3))).Times(1);
+  qsfp_->actualUpdateQsfpData(true);
+  EXPECT_EQ(1u, qsfp_->getLastReadCycle().pageSelectsSkipped);
+}
+
+TEST(CmisModuleTest, updateQsfpDataPartialReadsAndSelects) {
+  auto wedgeManager = std::make_unique<MockWedgeManager>();
+  auto transceiverImpl = std::make_unique<NiceMock<MockTransceiverImpl>>();
+  auto transImpl = transceiverImpl.get();
+  MockCmisModule cmis(wedgeManager.get(), std::move(transceiverImpl), 4);
+
+  auto zeros = [](int, int, int len, uint8_t* data) {
+    std::fill(data, data + len, 0);
+    return 0;
+  };
+  auto addr = TransceiverI2CApi::ADDR_QSFP;
+  auto select = [transImpl, addr](uint8_t page) {
+    EXPECT_CALL(*transImpl, writeTransceiver(addr, 127, 1, Pointee(page)))
+        .WillOnce(Return(0));
+  };
+
+  InSequence seq;
+  // Lower page: the fields from flat mem (byte 2) to module control (byte
+  // 26) are coalesced into one read, the page select byte is read apart
+  EXPECT_CALL(*transImpl, readTransceiver(addr, 2, 25, _))
+      .WillOnce(Invoke([](int, int, int len, uint8_t* data) {
+        std::fill(data, data + len, 0);
+        // Paged memory, and module state (byte 3) ready
+        data[1] = static_cast<uint8_t>(CmisModuleState::READY) << 1;
+        return 0;
+      }));
+  EXPECT_CALL(*transImpl, readTransceiver(addr, 127, 1, _))
+      .WillOnce(Invoke([](int, int, int, uint8_t* data) {
+        // Page 11h is still selected, as by the last refresh
+        data[0] = 0x11;
+        return 0;
+      }));
+  // Page 11h is read first, without selecting it again
+  EXPECT_CALL(*transImpl, readTransceiver(addr, 128, 95, _))
+      .WillOnce(Invoke(zeros));
+  select(0x10);
+  EXPECT_CALL(*transImpl, readTransceiver(addr, 128, 21, _))
+      .WillOnce(Invoke(zeros));
+  // Page 14h is set to report SNR (6) once selected. The lane checker
+  // flags are too far from the BER and SNR fields to be read with them.
+  select(0x14);
+  EXPECT_CALL(*transImpl, writeTransceiver(addr, 128, 1, Pointee(0x6)))
+      .WillOnce(Return(0));
+  EXPECT_CALL(*transImpl, readTransceiver(addr, 138, 1, _))
+      .WillOnce(Invoke(zeros));
+  EXPECT_CALL(*transImpl, readTransceiver(addr, 192, 64, _))
+      .WillOnce(Invoke(zeros));
+  // Pages 00h, 01h, 02h and 13h are static, and not read at all
+  cmis.actualUpdateQsfpData(false);
+
+  auto cycle = cmis.getLastReadCycle();
+  EXPECT_EQ(6u, cycle.reads);
+  EXPECT_EQ(3u, cycle.writes);
+  EXPECT_EQ(1u, cycle.pageSelectsSkipped);
+  EXPECT_EQ(25u + 1 + 95 + 21 + 1 + 64, cycle.bytesRead);
+  EXPECT_EQ(std::optional<uint8_t>(0x14), cycle.selectedPage);
+}
+
 TEST_F(QsfpModuleTest, skipCustomizingMissingPorts) {
   // set present_ = false, dirty_ = true
   EXPECT_CALL(*transImpl_, detectTransceiver()).WillRepeatedly(Return(false));
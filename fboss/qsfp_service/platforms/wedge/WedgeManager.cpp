@@ -343,6 +343,36 @@ void WedgeManager::refreshTransceivers() {
 
   folly::collectAll(futs.begin(), futs.end()).wait();
   XLOG(INFO) << "Finished refreshing all transceivers";
+
+  publishTransceiverInfo();
+}
+
+void WedgeManager::publishTransceiverInfo() {
+  TransceiverMap infos;
+  {
+    auto lockedTransceivers = transceivers_.rlock();
+    for (int i = 0; i < getNumQsfpModules(); ++i) {
+      TransceiverInfo trans;
+      if (auto it = lockedTransceivers->find(TransceiverID(i));
+          it != lockedTransceivers->end()) {
+        try {
+          trans = it->second->getTransceiverInfo();
+        } catch (const std::exception& ex) {
+          XLOG(ERR) << "Transceiver " << i
+                    << ": Error calling getTransceiverInfo(): " << ex.what();
+          continue;
+        }
+      } else {
+        // Unlike getTransceiversInfo(), don't go to the bus for slots
+        // without a module, updateTransceiverMap() adds inserted ones
+        trans.present_ref() = false;
+        trans.transceiver_ref() = TransceiverType::QSFP;
+        trans.port_ref() = i;
+      }
+      infos[i] = trans;
+    }
+  }
+  infoStream_.update(infos);
 }
 
 int WedgeManager::scanTransceiverPresence(
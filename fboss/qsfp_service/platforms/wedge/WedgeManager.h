@@ -83,6 +83,13 @@ class WedgeManager : public TransceiverManager {
   // transceiver out of reset by default will stay no op.
   void clearAllTransceiverReset();
 
+  /*
+   * Push the info of any transceivers that changed since the last refresh
+   * to subscribeTransceiverInfo subscribers. Slots without a transceiver
+   * are pushed as not present.
+   */
+  void publishTransceiverInfo();
+
   /*
    * This function takes the portId, port profile id and creates phy port
    * config using platform mapping.
@@ -82,4 +82,36 @@ TEST_F(WedgeManagerTest, writeTransceiver) {
     EXPECT_NE(response.find(i), response.end());
   }
 }
+
+TEST_F(WedgeManagerTest, publishTransceiverInfo) {
+  auto stream = wedgeManager_->getTransceiverInfoStream();
+  auto qsfp = wedgeManager_->mockTransceivers_[TransceiverID(3)];
+  TransceiverInfo info;
+  info.present_ref() = true;
+  info.sensor_ref() = GlobalSensors();
+  info.sensor_ref()->temp_ref()->value_ref() = 40;
+  ON_CALL(*qsfp, getTransceiverInfo()).WillByDefault(Return(info));
+
+  // Every transceiver is new the first time around
+  auto gen = stream->getGeneration();
+  wedgeManager_->publishTransceiverInfo();
+  EXPECT_EQ(gen + 1, stream->getGeneration());
+
+  // New sensor readings alone push nothing
+  info.sensor_ref()->temp_ref()->value_ref() = 41;
+  ON_CALL(*qsfp, getTransceiverInfo()).WillByDefault(Return(info));
+  wedgeManager_->publishTransceiverInfo();
+  EXPECT_EQ(gen + 1, stream->getGeneration());
+
+  // But a reading crossing a threshold does
+  FlagLevels flags;
+  flags.alarm_ref()->high_ref() = true;
+  info.sensor_ref()->temp_ref()->flags_ref() = flags;
+  auto pushed = stream->update({{3, info}});
+  ASSERT_TRUE(pushed.has_value());
+  EXPECT_EQ(gen + 1, *pushed->previousGeneration_ref());
+  EXPECT_EQ(gen + 2, *pushed->generation_ref());
+  EXPECT_EQ(1, pushed->changed_ref()->size());
+  EXPECT_EQ(1, pushed->changed_ref()->count(3));
+}
 } // namespace
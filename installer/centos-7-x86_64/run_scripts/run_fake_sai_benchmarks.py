@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Copyright 2004-present Facebook. All Rights Reserved.
+
+"""
+Run the SAI hw benchmarks built against the fake SAI, with the fake SAI
+charging each API call the latency from a profile (see
+fboss/agent/hw/sai/fake/FakeSaiLatencyModel.h). This gives agent side
+programming throughput numbers without any hardware.
+"""
+
+import glob
+import json
+import os
+import subprocess
+import sys
+from argparse import ArgumentParser
+
+
+DEFAULT_PROFILE = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "fake_sai_latency_profile.json"
+)
+# Benchmarks which exercise the ASIC data path, rather than programming
+# through the SAI API, say nothing useful against the fake SAI.
+SKIPPED_BENCHMARKS = ("sai_rx_slow_path_rate", "sai_tx_slow_path_rate")
+BENCHMARK_TIMEOUT = 1800
+
+
+def _find_benchmarks(bin_dir, filter):
+    benchmarks = []
+    for path in sorted(glob.glob(os.path.join(bin_dir, "sai_*-fake-*"))):
+        name = os.path.basename(path).split("-fake-")[0]
+        if name in SKIPPED_BENCHMARKS:
+            continue
+        if filter is not None and filter not in name:
+            continue
+        benchmarks.append((name, path))
+    return benchmarks
+
+
+def _parse_json_output(output):
+    # Benchmarks print a pretty printed json object as their last output
+    start = output.rfind("\n{")
+    try:
+        return json.loads(output[start + 1 :] if start >= 0 else output)
+    except ValueError:
+        return None
+
+
+def _run_benchmark(path, profile, extra_args):
+    cmd = [path, "--fake_sai_latency_profile", profile, "--json"] + extra_args
+    try:
+        output = subprocess.check_output(
+            cmd, timeout=BENCHMARK_TIMEOUT, stderr=subprocess.DEVNULL
+        ).decode("utf-8")
+    except subprocess.TimeoutExpired:
+        return {"status": "TIMEOUT"}
+    except subprocess.CalledProcessError as e:
+        return {"status": "FAILED", "returncode": e.returncode}
+    result = _parse_json_output(output)
+    if result is None:
+        return {"status": "FAILED", "error": "no json output"}
+    return {"status": "OK", "result": result}
+
+
+def main():
+    ap = ArgumentParser(description="Run SAI benchmarks against the fake SAI.")
+    ap.add_argument(
+        "--bin-dir",
+        default=os.environ.get("FBOSS_BIN"),
+        help="directory with the sai_*-fake-* benchmark binaries",
+    )
+    ap.add_argument(
+        "--profile", default=DEFAULT_PROFILE, help="fake SAI latency profile"
+    )
+    ap.add_argument(
+        "--filter", help="only run benchmarks whose name contains this string"
+    )
+    ap.add_argument("--output", help="also write the results as json here")
+    args, extra_args = ap.parse_known_args()
+
+    if args.bin_dir is None:
+        print("Pass --bin-dir or run `source /opt/fboss/bin/setup_fboss_env'")
+        return 1
+    benchmarks = _find_benchmarks(args.bin_dir, args.filter)
+    if not benchmarks:
+        print("No fake SAI benchmarks found in " + args.bin_dir)
+        return 1
+
+    results = {}
+    for name, path in benchmarks:
+        print("########## Running benchmark: " + name, flush=True)
+        results[name] = _run_benchmark(path, args.profile, extra_args)
+        print(json.dumps(results[name], sort_keys=True), flush=True)
+
+    if args.output is not None:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+    failed = [name for name, r in results.items() if r["status"] != "OK"]
+    print("Summary: %d OK, %d FAILED" % (len(results) - len(failed), len(failed)))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())